@@ -15,6 +15,7 @@
 #include "mlir/Pass/Pass.h"
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Pass/PassRegistry.h"
+#include <functional>
 
 namespace cudaq::opt {
 
@@ -42,6 +43,13 @@ std::unique_ptr<mlir::Pass> createQuakeAddMetadata();
 std::unique_ptr<mlir::Pass> createQuakeAddDeallocs();
 std::unique_ptr<mlir::Pass> createQuakeSynthesizer();
 std::unique_ptr<mlir::Pass> createQuakeSynthesizer(std::string_view, void *);
+/// Create a QuakeSynthesizer that synthesizes every floating-point argument
+/// value, including the elements of vector arguments, as `floatMapper(value)`.
+/// The values are mapped in argument order, followed by the elements of the
+/// vector arguments in argument order.
+std::unique_ptr<mlir::Pass>
+createQuakeSynthesizer(std::string_view, void *,
+                       std::function<double(double)> floatMapper);
 std::unique_ptr<mlir::Pass> createRaiseToAffinePass();
 std::unique_ptr<mlir::Pass> createUnwindLoweringPass();
 
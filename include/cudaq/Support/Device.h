@@ -10,21 +10,32 @@
 
 #include "cudaq/ADT/GraphCSR.h"
 #include "cudaq/Support/Graph.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/MemoryBuffer.h"
 
 namespace cudaq {
 
 /// The `Device` class represents a device topology with qubits and connections
 /// between qubits. It contains various methods to construct the device based on
-/// canned geometries, and it contains helper methods to determine paths between
-/// qubits.
+/// canned geometries, and it contains helper methods to determine distances and
+/// paths between qubits.
+///
+/// Connections can have weights, e.g., derived from their error rates, in which
+/// case the weighted distance between two qubits is the weight of the lightest
+/// path between them. Only distances are stored, in O(n^2) memory for n qubits.
+/// Paths are rebuilt from them when requested.
 class Device {
 public:
   using Qubit = GraphCSR::Node;
   using Path = mlir::SmallVector<Qubit>;
 
+  /// The distance between qubits that are not connected by any path.
+  static constexpr unsigned unreachable = std::numeric_limits<unsigned>::max();
+
   /// Read device connectivity info from a file. The input format is the same
-  /// as the Graph dump() format.
+  /// as the Graph dump() format. A connected node can be followed by a colon
+  /// and a positive weight, e.g., `0 --> {1:0.5, 2}`. Connections without a
+  /// weight weigh 1.
   static Device file(llvm::StringRef filename) {
     Device device;
 
@@ -57,6 +68,26 @@ public:
             line = line.ltrim();
             unsigned v2 = 0;
             while (!line.consumeInteger(10, v2)) {
+              // Parse the optional weight
+              line = line.ltrim();
+              if (line.consume_front(":")) {
+                auto weightEnd = line.find_first_of(",}");
+                double weight = 0.0;
+                if (line.take_front(weightEnd).trim().getAsDouble(weight) ||
+                    weight <= 0.0) {
+                  llvm::errs() << "Invalid weight for connection " << v1
+                               << " --> " << v2 << " in " << filename << '\n';
+                  return Device();
+                }
+                auto [iter, inserted] =
+                    device.weights.try_emplace(getEdgeKey(v1, v2), weight);
+                if (!inserted && iter->second != weight) {
+                  llvm::errs() << "Conflicting weights for connection " << v1
+                               << " --> " << v2 << " in " << filename << '\n';
+                  return Device();
+                }
+                line = line.substr(weightEnd);
+              }
               // Create an edge, but make sure it doesn't already exist
               bool edgeAlreadyExists = false;
               for (auto edge : device.topology.getNeighbours(Qubit(v1))) {
@@ -75,7 +106,7 @@ public:
       }
     }
 
-    device.computeAllPairShortestPaths();
+    device.computeDistances();
     return device;
   }
 
@@ -91,7 +122,7 @@ public:
       device.topology.createNode();
       device.topology.addEdge(Qubit(i - 1), Qubit(i));
     }
-    device.computeAllPairShortestPaths();
+    device.computeDistances();
     return device;
   }
 
@@ -103,12 +134,11 @@ public:
   static Device ring(unsigned numQubits) {
     assert(numQubits > 0);
     Device device;
-    device.topology.createNode();
-    for (unsigned i = 0u; i < numQubits; ++i) {
+    for (unsigned i = 0u; i < numQubits; ++i)
       device.topology.createNode();
+    for (unsigned i = 0u; i < numQubits; ++i)
       device.topology.addEdge(Qubit(i), Qubit((i + 1) % numQubits));
-    }
-    device.computeAllPairShortestPaths();
+    device.computeDistances();
     return device;
   }
 
@@ -134,7 +164,7 @@ public:
       if (i != centerQubit)
         device.topology.addEdge(Qubit(centerQubit), Qubit(i));
 
-    device.computeAllPairShortestPaths();
+    device.computeDistances();
     return device;
   }
 
@@ -160,7 +190,7 @@ public:
           device.topology.addEdge(q0, Qubit(base + width));
       }
     }
-    device.computeAllPairShortestPaths();
+    device.computeDistances();
     return device;
   }
 
@@ -169,12 +199,45 @@ public:
   /// Returns the number of physical qubits in the device.
   unsigned getNumQubits() const { return topology.getNumNodes(); }
 
-  /// Returns the distance between two qubits.
+  /// Returns the number of connections on a shortest path between two qubits,
+  /// or `unreachable`.
   unsigned getDistance(Qubit src, Qubit dst) const {
-    unsigned pairID = getPairID(src.index, dst.index);
-    return src == dst ? 0 : shortestPaths[pairID].size() - 1;
+    return src == dst ? 0 : distances[getPairID(src.index, dst.index)];
+  }
+
+  /// Returns the weight of a lightest path between two qubits, which is their
+  /// distance if the connections have no weights. Returns infinity if there is
+  /// no path.
+  double getWeightedDistance(Qubit src, Qubit dst) const {
+    if (weightedDistances.empty()) {
+      unsigned distance = getDistance(src, dst);
+      return distance == unreachable ? std::numeric_limits<double>::infinity()
+                                     : distance;
+    }
+    return src == dst ? 0.0
+                      : weightedDistances[getPairID(src.index, dst.index)];
+  }
+
+  /// Returns the weight of the connection between two qubits.
+  double getWeight(Qubit q0, Qubit q1) const {
+    auto iter = weights.find(getEdgeKey(q0.index, q1.index));
+    return iter == weights.end() ? 1.0 : iter->second;
+  }
+
+  /// Returns true if every qubit is connected to every other qubit by a path.
+  bool isConnected() const { return connected; }
+
+  /// Returns the weight of the lightest connection of a qubit.
+  double getLightestWeight(Qubit q) const {
+    double lightest = std::numeric_limits<double>::infinity();
+    for (auto neighbour : getNeighbours(q))
+      lightest = std::min(lightest, getWeight(q, neighbour));
+    return lightest;
   }
 
+  /// Returns true if some connections have a weight other than the default.
+  bool hasWeights() const { return !weights.empty(); }
+
   mlir::ArrayRef<Qubit> getNeighbours(Qubit src) const {
     return topology.getNeighbours(src);
   }
@@ -183,17 +246,38 @@ public:
     return getDistance(q0, q1) == 1;
   }
 
-  /// Returns a shortest path between two qubits.
+  /// Returns a shortest path between two qubits, or an empty path if they are
+  /// the same qubit or not connected by any path. The path is rebuilt by
+  /// moving to a neighbour one step closer to `dst` at a time.
   Path getShortestPath(Qubit src, Qubit dst) const {
-    unsigned pairID = getPairID(src.index, dst.index);
-    if (src.index > dst.index)
-      return Path(llvm::reverse(shortestPaths[pairID]));
-    return Path(shortestPaths[pairID]);
+    Path path;
+    unsigned distance = getDistance(src, dst);
+    if (distance == 0 || distance == unreachable)
+      return path;
+    path.push_back(src);
+    for (; distance > 0; --distance) {
+      for (auto neighbour : getNeighbours(src)) {
+        if (getDistance(neighbour, dst) == distance - 1) {
+          src = neighbour;
+          break;
+        }
+      }
+      path.push_back(src);
+    }
+    return path;
   }
 
   void dump(llvm::raw_ostream &os = llvm::errs()) const {
     os << "Graph:\n";
     topology.dump(os);
+    if (hasWeights()) {
+      os << "\nWeights:\n";
+      for (unsigned src = 0; src < getNumQubits(); ++src)
+        for (auto dst : getNeighbours(Qubit(src)))
+          if (src < dst.index)
+            os << '(' << src << ", " << dst << ") : "
+               << getWeight(Qubit(src), dst) << '\n';
+    }
     os << "\nShortest Paths:\n";
     for (unsigned src = 0; src < getNumQubits(); ++src)
       for (unsigned dst = 0; dst < getNumQubits(); ++dst) {
@@ -205,8 +289,6 @@ public:
   }
 
 private:
-  using PathRef = mlir::ArrayRef<Qubit>;
-
   /// Returns a unique id for a pair of values (`u` and `v`). `getPairID(u, v)`
   /// will be equal to `getPairID(v, u)`.
   unsigned getPairID(unsigned u, unsigned v) const {
@@ -215,40 +297,54 @@ private:
     return (u * getNumQubits()) - (((u - 1) * u) / 2) + v - u;
   }
 
-  /// Compute the shortest path between every qubit. This assumes that there
-  /// exists at least one path between every source and destination pair. I.e.
-  /// the graph cannot be bipartite.
-  void computeAllPairShortestPaths() {
+  /// Returns the key of the connection between `u` and `v` in `weights`.
+  static std::pair<unsigned, unsigned> getEdgeKey(unsigned u, unsigned v) {
+    return {std::min(u, v), std::max(u, v)};
+  }
+
+  /// Compute the distance between every pair of qubits, and the weighted
+  /// distance if the connections have weights.
+  void computeDistances() {
     std::size_t numNodes = topology.getNumNodes();
-    shortestPaths.resize(numNodes * (numNodes + 1) / 2);
-    mlir::SmallVector<Qubit> path(numNodes);
+    distances.assign(numNodes * (numNodes + 1) / 2, unreachable);
+    connected = true;
     for (unsigned n = 0; n < numNodes; ++n) {
-      auto parents = getShortestPathsBFS(topology, Qubit(n));
-      // Reconstruct the paths
-      for (auto m = n + 1; m < numNodes; ++m) {
-        path.clear();
-        path.push_back(Qubit(m));
-        auto p = parents[m];
-        while (p != Qubit(n)) {
-          path.push_back(p);
-          p = parents[p.index];
-        }
-        path.push_back(Qubit(n));
-        pathsData.append(path.rbegin(), path.rend());
-        shortestPaths[getPairID(n, m)] =
-            PathRef(pathsData.end() - path.size(), pathsData.end());
-      }
+      auto fromN = getShortestDistancesBFS(topology, Qubit(n));
+      // The device is connected if every qubit can be reached from the first.
+      if (n == 0)
+        connected = llvm::none_of(
+            fromN, [](unsigned distance) { return distance == unreachable; });
+      for (auto m = n; m < numNodes; ++m)
+        distances[getPairID(n, m)] = fromN[m];
+    }
+
+    weightedDistances.clear();
+    if (weights.empty())
+      return;
+    weightedDistances.resize(distances.size());
+    auto weight = [&](Qubit q0, Qubit q1) { return getWeight(q0, q1); };
+    for (unsigned n = 0; n < numNodes; ++n) {
+      auto fromN = getShortestDistancesDijkstra(topology, Qubit(n), weight);
+      for (auto m = n; m < numNodes; ++m)
+        weightedDistances[getPairID(n, m)] = fromN[m];
     }
   }
 
   /// Device nodes (qubits) and edges (connections)
   GraphCSR topology;
 
-  /// List of shortest path from/to every source/destination
-  mlir::SmallVector<PathRef> shortestPaths;
+  /// The weights of the connections that have one
+  llvm::DenseMap<std::pair<unsigned, unsigned>, double> weights;
+
+  /// Distance between every pair of qubits, indexed by `getPairID`
+  mlir::SmallVector<unsigned> distances;
+
+  /// Weighted distance between every pair of qubits, indexed by `getPairID`.
+  /// Empty if the connections have no weights.
+  mlir::SmallVector<double> weightedDistances;
 
-  /// Storage for `PathRef`'s in `shortestPaths`
-  mlir::SmallVector<Qubit> pathsData;
+  /// Whether every qubit is connected to every other qubit by a path
+  bool connected = true;
 };
 
 } // namespace cudaq
@@ -9,6 +9,8 @@
 #pragma once
 
 #include "cudaq/ADT/GraphCSR.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
+#include <queue>
 
 namespace cudaq {
 
@@ -38,4 +40,59 @@ mlir::SmallVector<GraphCSR::Node> getShortestPathsBFS(const GraphCSR &graph,
   return parents;
 }
 
+/// Returns the number of edges on a shortest path from \p src to every node in
+/// \p graph. Nodes that cannot be reached from \p src are at distance
+/// `std::numeric_limits<unsigned>::max()`.
+inline mlir::SmallVector<unsigned>
+getShortestDistancesBFS(const GraphCSR &graph, GraphCSR::Node src) {
+  assert(src.isValid() && "Invalid source node");
+  constexpr unsigned unreachable = std::numeric_limits<unsigned>::max();
+  mlir::SmallVector<unsigned> distances(graph.getNumNodes(), unreachable);
+  mlir::SmallVector<GraphCSR::Node> queue;
+  queue.reserve(graph.getNumNodes());
+  queue.push_back(src);
+  distances[src.index] = 0;
+  std::size_t begin = 0;
+  while (begin < queue.size()) {
+    auto node = queue[begin++];
+    for (auto neighbour : graph.getNeighbours(node)) {
+      if (distances[neighbour.index] != unreachable)
+        continue;
+      distances[neighbour.index] = distances[node.index] + 1;
+      queue.push_back(neighbour);
+    }
+  }
+  return distances;
+}
+
+/// Returns the weight of a lightest path from \p src to every node in \p
+/// graph, where \p weight gives the (non-negative) weight of each edge. Nodes
+/// that cannot be reached from \p src are at infinite distance.
+inline mlir::SmallVector<double> getShortestDistancesDijkstra(
+    const GraphCSR &graph, GraphCSR::Node src,
+    llvm::function_ref<double(GraphCSR::Node, GraphCSR::Node)> weight) {
+  assert(src.isValid() && "Invalid source node");
+  mlir::SmallVector<double> distances(graph.getNumNodes(),
+                                      std::numeric_limits<double>::infinity());
+  using Entry = std::pair<double, unsigned>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  distances[src.index] = 0.0;
+  queue.emplace(0.0, src.index);
+  while (!queue.empty()) {
+    auto [distance, index] = queue.top();
+    queue.pop();
+    if (distance > distances[index])
+      continue;
+    GraphCSR::Node node(index);
+    for (auto neighbour : graph.getNeighbours(node)) {
+      double newDistance = distance + weight(node, neighbour);
+      if (newDistance >= distances[neighbour.index])
+        continue;
+      distances[neighbour.index] = newDistance;
+      queue.emplace(newDistance, neighbour.index);
+    }
+  }
+  return distances;
+}
+
 } // namespace cudaq
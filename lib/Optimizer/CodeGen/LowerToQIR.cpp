@@ -664,7 +664,7 @@ public:
 };
 
 /// Lower single target Quantum ops with two parameters to QIR:
-/// u2, u3
+/// u2, phased_rx
 template <typename OP>
 class OneTargetTwoParamRewrite : public ConvertOpToLLVMPattern<OP> {
 public:
@@ -721,6 +721,63 @@ public:
   }
 };
 
+/// Lower the u3 Quantum op, which has three parameters, to QIR. Controls are
+/// supported when they are given as a single veq.
+class U3Rewrite : public ConvertOpToLLVMPattern<quake::U3Op> {
+public:
+  using Base = ConvertOpToLLVMPattern<quake::U3Op>;
+  using Base::Base;
+
+  LogicalResult
+  matchAndRewrite(quake::U3Op instOp, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto numControls = instOp.getControls().size();
+    auto loc = instOp->getLoc();
+    ModuleOp parentModule = instOp->getParentOfType<ModuleOp>();
+    auto *context = instOp.getContext();
+    auto qirFunctionName = std::string(cudaq::opt::QIRQISPrefix) + "u3";
+
+    if (numControls > 1 ||
+        (numControls == 1 &&
+         !isa<quake::VeqType>(instOp.getControls().front().getType())))
+      return instOp.emitError("unsupported controlled op u3 with " +
+                              std::to_string(numControls) +
+                              " ctrl operands, expected a single veq");
+
+    auto castToDouble = [&](Value v) -> Value {
+      if (v.getType().getIntOrFloatBitWidth() < 64)
+        v = rewriter.create<arith::ExtFOp>(loc, rewriter.getF64Type(), v);
+      return v;
+    };
+    SmallVector<Value> funcArgs;
+    for (auto param : adaptor.getParameters())
+      funcArgs.push_back(castToDouble(param));
+    // The adjoint of u3(θ, φ, λ) is u3(-θ, -λ, -φ).
+    if (instOp.getIsAdj()) {
+      std::swap(funcArgs[1], funcArgs[2]);
+      for (auto &arg : funcArgs)
+        arg = rewriter.create<arith::NegFOp>(loc, arg);
+    }
+
+    auto paramType = FloatType::getF64(context);
+    SmallVector<Type> argTypes = {paramType, paramType, paramType};
+    if (numControls != 0) {
+      qirFunctionName += "__ctl";
+      argTypes.push_back(cudaq::opt::getArrayType(context));
+      funcArgs.push_back(adaptor.getControls().front());
+    }
+    argTypes.push_back(cudaq::opt::getQubitType(context));
+    funcArgs.push_back(adaptor.getTargets().front());
+
+    FlatSymbolRefAttr symbolRef = cudaq::opt::factory::createLLVMFunctionSymbol(
+        qirFunctionName, /*return type=*/LLVM::LLVMVoidType::get(context),
+        argTypes, parentModule);
+    rewriter.replaceOpWithNewOp<LLVM::CallOp>(instOp, TypeRange{}, symbolRef,
+                                              funcArgs);
+    return success();
+  }
+};
+
 /// Lower two-target Quantum ops with no parameter to QIR:
 /// swap
 template <typename OP>
@@ -1623,11 +1680,10 @@ public:
         OneTargetOneParamRewrite<quake::RxOp>,
         OneTargetOneParamRewrite<quake::RyOp>,
         OneTargetOneParamRewrite<quake::RzOp>,
-        OneTargetTwoParamRewrite<quake::U2Op>,
-        OneTargetTwoParamRewrite<quake::U3Op>, ResetRewrite,
+        OneTargetTwoParamRewrite<quake::U2Op>, ResetRewrite,
         StdvecDataOpPattern, StdvecInitOpPattern, StdvecSizeOpPattern,
         StoreOpPattern, SubveqOpRewrite, TwoTargetRewrite<quake::SwapOp>,
-        UndefOpPattern>(typeConverter);
+        U3Rewrite, UndefOpPattern>(typeConverter);
     patterns.insert<MeasureRewrite<quake::MzOp>>(typeConverter, measureCounter);
 
     target.addLegalDialect<LLVM::LLVMDialect>();
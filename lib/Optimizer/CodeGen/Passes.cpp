@@ -9,13 +9,26 @@
 #include "cudaq/Optimizer/CodeGen/Passes.h"
 #include "PassDetails.h"
 #include "cudaq/Optimizer/Transforms/Passes.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Transforms/Passes.h"
 
 using namespace mlir;
 
+/// Fuse runs of single-qubit gates ahead of the basis conversion. The global
+/// phase is irrelevant on hardware, and the basis conversion turns each `u3`
+/// into three rotations, so only runs of at least four gates are fused.
+static void addSingleQubitFusion(OpPassManager &pm) {
+  using namespace cudaq::opt;
+  FuseSingleQubitGatesOptions options;
+  options.minRunLength = 4;
+  options.ignoreGlobalPhase = true;
+  pm.addNestedPass<func::FuncOp>(createFuseSingleQubitGates(options));
+}
+
 static void addOQCPipeline(OpPassManager &pm) {
   using namespace cudaq::opt;
+  addSingleQubitFusion(pm);
   std::string basis[] = {
       // TODO: make this our native gate set
       "h", "s", "t", "r1", "rx", "ry", "rz", "x", "y", "z", "x(1)",
@@ -27,6 +40,7 @@ static void addOQCPipeline(OpPassManager &pm) {
 
 static void addQuantinuumPipeline(OpPassManager &pm) {
   using namespace cudaq::opt;
+  addSingleQubitFusion(pm);
   std::string basis[] = {
       "h", "s", "t", "rx", "ry", "rz", "x", "y", "z", "x(1)",
   };
@@ -48,6 +62,7 @@ static void addIQMPipeline(OpPassManager &pm) {
 
 static void addIonQPipeline(OpPassManager &pm) {
   using namespace cudaq::opt;
+  addSingleQubitFusion(pm);
   std::string basis[] = {
       "h",  "s", "t", "rx", "ry",
       "rz", "x", "y", "z",  "x(1)", // TODO set to ms, gpi, gpi2
@@ -1127,6 +1127,54 @@ struct RzToPhasedRx : public OpRewritePattern<quake::RzOp> {
   }
 };
 
+//===----------------------------------------------------------------------===//
+// U3Op decompositions
+//===----------------------------------------------------------------------===//
+
+// quake.u3(θ, φ, λ) target
+// ──────────────────────────────────
+// quake.rz(λ) target
+// quake.ry(θ) target
+// quake.rz(φ) target
+//
+// This decomposition ignores the global phase.
+struct U3ToRotations : public OpRewritePattern<quake::U3Op> {
+  using OpRewritePattern<quake::U3Op>::OpRewritePattern;
+
+  void initialize() { setDebugName("U3ToRotations"); }
+
+  LogicalResult matchAndRewrite(quake::U3Op op,
+                                PatternRewriter &rewriter) const override {
+    if (!op.getControls().empty())
+      return failure();
+    if (!quake::isAllReferences(op))
+      return failure();
+
+    // Op info
+    Location loc = op->getLoc();
+    Value target = op.getTarget();
+    Value theta = op.getParameter(0);
+    Value phi = op.getParameter(1);
+    Value lambda = op.getParameter(2);
+
+    // The adjoint of u3(θ, φ, λ) is u3(-θ, -λ, -φ).
+    if (op.isAdj()) {
+      theta = rewriter.create<arith::NegFOp>(loc, theta);
+      Value negPhi = rewriter.create<arith::NegFOp>(loc, phi);
+      phi = rewriter.create<arith::NegFOp>(loc, lambda);
+      lambda = negPhi;
+    }
+
+    ValueRange noControls;
+    rewriter.create<quake::RzOp>(loc, lambda, noControls, target);
+    rewriter.create<quake::RyOp>(loc, theta, noControls, target);
+    rewriter.create<quake::RzOp>(loc, phi, noControls, target);
+
+    rewriter.eraseOp(op);
+    return success();
+  }
+};
+
 } // namespace
 
 //===----------------------------------------------------------------------===//
@@ -1168,6 +1216,8 @@ void cudaq::populateWithAllDecompositionPatterns(RewritePatternSet &patterns) {
     // RzOp patterns
     CRzToCX,
     RzToPhasedRx,
+    // U3Op patterns
+    U3ToRotations,
     // Swap
     SwapToCX,
     ExpPauliDecomposition
@@ -0,0 +1,283 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "PassDetails.h"
+#include "cudaq/Optimizer/Builder/Factory.h"
+#include "cudaq/Optimizer/Dialect/Quake/QuakeOps.h"
+#include "cudaq/Optimizer/Transforms/Passes.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/IR/Matchers.h"
+#include <cmath>
+#include <complex>
+
+namespace cudaq::opt {
+#define GEN_PASS_DEF_FUSESINGLEQUBITGATES
+#include "cudaq/Optimizer/Transforms/Passes.h.inc"
+} // namespace cudaq::opt
+
+#define DEBUG_TYPE "fuse-single-qubit-gates"
+
+using namespace mlir;
+
+namespace {
+/// A 2x2 unitary in column-major order, the layout used by
+/// `OperatorInterface::getOperatorMatrix`.
+using Matrix = SmallVector<std::complex<double>, 4>;
+
+static constexpr double tolerance = 1e-12;
+
+/// Return `lhs * rhs`.
+static Matrix multiply(const Matrix &lhs, const Matrix &rhs) {
+  Matrix result(4);
+  for (unsigned r = 0; r < 2; ++r)
+    for (unsigned c = 0; c < 2; ++c)
+      result[r + 2 * c] = lhs[r] * rhs[2 * c] + lhs[r + 2] * rhs[1 + 2 * c];
+  return result;
+}
+
+/// Wrap `angle` into the interval (-π, π].
+static double normalizeAngle(double angle) {
+  angle = std::remainder(angle, 2. * M_PI);
+  return angle <= -M_PI ? angle + 2. * M_PI : angle;
+}
+
+/// The angles of `u3(θ, φ, λ)`, which equals a 2x2 unitary up to a global
+/// phase.
+struct U3Angles {
+  double theta;
+  double phi;
+  double lambda;
+
+  bool isIdentity() const {
+    return std::abs(theta) < tolerance &&
+           std::abs(normalizeAngle(phi + lambda)) < tolerance;
+  }
+};
+
+/// Decompose the unitary `u` as `u3(θ, φ, λ)` up to a global phase.
+static U3Angles getU3Angles(const Matrix &u) {
+  // Remove the global phase so that `v` is in SU(2). Then
+  //   v00 = cos(θ/2) exp(-i(φ+λ)/2)
+  //   v10 = sin(θ/2) exp(i(φ-λ)/2)
+  // up to a common sign, which is again a global phase.
+  auto det = u[0] * u[3] - u[2] * u[1];
+  auto phase = std::exp(std::complex<double>(0., -std::arg(det) / 2.));
+  auto v00 = u[0] * phase;
+  auto v10 = u[1] * phase;
+  double theta = 2. * std::atan2(std::abs(v10), std::abs(v00));
+  double sum = std::abs(v00) < tolerance ? 0. : -2. * std::arg(v00);
+  double diff = std::abs(v10) < tolerance ? 0. : 2. * std::arg(v10);
+  if (std::abs(v10) < tolerance)
+    return {theta, 0., normalizeAngle(sum)};
+  if (std::abs(v00) < tolerance)
+    return {theta, normalizeAngle(diff), 0.};
+  return {theta, normalizeAngle((sum + diff) / 2.),
+          normalizeAngle((sum - diff) / 2.)};
+}
+
+/// Return the global phase `γ` such that `u = exp(iγ) u3(θ, φ, λ)`.
+static double getGlobalPhase(const Matrix &u, const U3Angles &angles) {
+  using namespace std::complex_literals;
+  double c = std::cos(angles.theta / 2.);
+  double s = std::sin(angles.theta / 2.);
+  Matrix u3 = {c, std::exp(1i * angles.phi) * s,
+               -std::exp(1i * angles.lambda) * s,
+               std::exp(1i * (angles.phi + angles.lambda)) * c};
+  std::complex<double> overlap = 0.;
+  for (unsigned i = 0; i < 4; ++i)
+    overlap += std::conj(u3[i]) * u[i];
+  return std::arg(overlap);
+}
+
+/// If `op` is an uncontrolled gate on a single qubit whose unitary is known at
+/// compile time, set `matrix` to that unitary and return true.
+static bool getFusibleMatrix(Operation *op, Matrix &matrix) {
+  auto optor = dyn_cast<quake::OperatorInterface>(op);
+  if (!optor || !optor.getControls().empty() || optor.getTargets().size() != 1)
+    return false;
+  if (!isa<quake::RefType, quake::WireType>(optor.getTarget(0).getType()))
+    return false;
+  // Conservatively leave adjoint `u2` and `u3` alone, their adjoint also swaps
+  // the `φ` and `λ` angles.
+  if (optor.isAdj() && isa<quake::U2Op, quake::U3Op>(op))
+    return false;
+  matrix.clear();
+  optor.getOperatorMatrix(matrix);
+  return matrix.size() == 4;
+}
+
+/// Return the value a reference was extracted from and the constant index, if
+/// any.
+static std::pair<Value, std::optional<std::size_t>> getBase(Value ref) {
+  auto extract = ref.getDefiningOp<quake::ExtractRefOp>();
+  if (!extract)
+    return {ref, std::nullopt};
+  if (extract.hasConstantIndex())
+    return {extract.getVeq(), extract.getConstantIndex()};
+  APInt index;
+  if (matchPattern(extract.getIndex(), m_ConstantInt(&index)))
+    return {extract.getVeq(), index.getZExtValue()};
+  return {extract.getVeq(), std::nullopt};
+}
+
+/// Return false only if the quantum references `a` and `b` are known to refer
+/// to distinct qubits.
+static bool mayAlias(Value a, Value b) {
+  if (a == b)
+    return true;
+  auto [baseA, indexA] = getBase(a);
+  auto [baseB, indexB] = getBase(b);
+  if (baseA == baseB)
+    return !indexA || !indexB || *indexA == *indexB;
+  return !(baseA.getDefiningOp<quake::AllocaOp>() &&
+           baseB.getDefiningOp<quake::AllocaOp>());
+}
+
+/// Create the uncontrolled gate `OP` with constant parameters `values` on
+/// `target` and return the qubit after the gate, i.e., the new wire in the
+/// value semantics or `target` itself.
+template <typename OP>
+static Value createGate(OpBuilder &builder, Location loc,
+                        ArrayRef<double> values, Value target) {
+  SmallVector<Value, 3> params;
+  for (double value : values)
+    params.push_back(cudaq::opt::factory::createFloatConstant(
+        loc, builder, value, builder.getF64Type()));
+  if (!isa<quake::WireType>(target.getType())) {
+    builder.create<OP>(loc, params, ValueRange{}, ValueRange{target});
+    return target;
+  }
+  auto op = builder.create<OP>(loc, TypeRange{target.getType()}, UnitAttr{},
+                               params, ValueRange{}, ValueRange{target},
+                               DenseBoolArrayAttr{});
+  return op.getWires()[0];
+}
+
+/// A maximal sequence of fusible gates applied to the same qubit.
+struct Run {
+  SmallVector<Operation *> gates;
+  Matrix unitary;
+};
+
+class FuseSingleQubitGatesPass
+    : public cudaq::opt::impl::FuseSingleQubitGatesBase<
+          FuseSingleQubitGatesPass> {
+public:
+  using FuseSingleQubitGatesBase::FuseSingleQubitGatesBase;
+
+  void runOnOperation() override {
+    SmallVector<Block *> blocks;
+    getOperation().walk([&](Block *block) { blocks.push_back(block); });
+    for (auto *block : blocks) {
+      SmallVector<Run> runs;
+      collectRuns(*block, runs);
+      for (auto &run : runs)
+        fuse(run);
+    }
+  }
+
+  /// Find the runs of fusible gates in `block`. A run is keyed by the
+  /// reference its gates apply to or, in the value semantics, by the wire
+  /// produced by its last gate.
+  void collectRuns(Block &block, SmallVectorImpl<Run> &runs) {
+    llvm::MapVector<Value, Run> open;
+    auto close = [&](auto pred) {
+      open.remove_if([&](auto &entry) {
+        if (!pred(entry.first))
+          return false;
+        runs.push_back(std::move(entry.second));
+        return true;
+      });
+    };
+
+    Matrix matrix;
+    for (auto &op : block) {
+      bool fusible = getFusibleMatrix(&op, matrix);
+      Value target =
+          fusible ? cast<quake::OperatorInterface>(&op).getTarget(0) : Value{};
+
+      // Any other use of a qubit ends the runs on that qubit. Any operation
+      // with regions may use a qubit implicitly.
+      if (op.getNumRegions()) {
+        close([](Value) { return true; });
+        continue;
+      }
+      for (auto v : op.getOperands())
+        if (isa<quake::RefType, quake::VeqType>(v.getType()))
+          close([&](Value key) {
+            return isa<quake::RefType>(key.getType()) && key != target &&
+                   mayAlias(key, v);
+          });
+      if (!fusible)
+        continue;
+
+      auto iter = open.find(target);
+      Run run;
+      if (iter != open.end()) {
+        run = std::move(iter->second);
+        open.erase(iter);
+        run.unitary = multiply(matrix, run.unitary);
+      } else {
+        run.unitary = matrix;
+      }
+      run.gates.push_back(&op);
+      Value key = target;
+      if (isa<quake::WireType>(target.getType()))
+        key = op.getResult(0);
+      open.insert({key, std::move(run)});
+    }
+    close([](Value) { return true; });
+  }
+
+  /// Replace the gates of `run` with a single `u3`, or remove them if they
+  /// multiply to the identity. Unless the global phase is ignored, an `rz` is
+  /// appended to the `u3` when needed to restore it, using
+  ///   rz(-2γ) u3(θ, φ + 2γ, λ) = exp(iγ) u3(θ, φ, λ).
+  /// The run is left alone unless it has at least `minRunLength` gates and
+  /// more gates than its replacement.
+  void fuse(Run &run) {
+    auto angles = getU3Angles(run.unitary);
+    double phase = 0.;
+    if (!ignoreGlobalPhase) {
+      phase = normalizeAngle(getGlobalPhase(run.unitary, angles));
+      if (std::abs(phase) < tolerance)
+        phase = 0.;
+      else
+        angles.phi = normalizeAngle(angles.phi + 2. * phase);
+    }
+    bool needsU3 = !angles.isIdentity();
+    std::size_t numNewGates = (needsU3 ? 1 : 0) + (phase != 0. ? 1 : 0);
+    if (run.gates.size() < minRunLength || run.gates.size() <= numNewGates)
+      return;
+
+    auto *first = run.gates.front();
+    auto *last = run.gates.back();
+    auto target = cast<quake::OperatorInterface>(first).getTarget(0);
+    bool isWire = isa<quake::WireType>(target.getType());
+    LLVM_DEBUG(llvm::dbgs() << "fusing " << run.gates.size()
+                            << " gates into u3(" << angles.theta << ", "
+                            << angles.phi << ", " << angles.lambda
+                            << ") and phase " << phase << '\n');
+
+    OpBuilder builder(last);
+    auto loc = last->getLoc();
+    Value replacement = target;
+    if (needsU3)
+      replacement = createGate<quake::U3Op>(
+          builder, loc, {angles.theta, angles.phi, angles.lambda}, replacement);
+    if (phase != 0.)
+      replacement =
+          createGate<quake::RzOp>(builder, loc, {-2. * phase}, replacement);
+
+    if (isWire)
+      last->getResult(0).replaceAllUsesWith(replacement);
+    for (auto *op : llvm::reverse(run.gates))
+      op->erase();
+  }
+};
+} // namespace
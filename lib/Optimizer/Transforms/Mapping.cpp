@@ -10,12 +10,18 @@
 #include "cudaq/Optimizer/Transforms/Passes.h"
 #include "cudaq/Support/Device.h"
 #include "cudaq/Support/Placement.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/SmallSet.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/ScopedPrinter.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/Transforms/TopologicalSortUtils.h"
+#include <mutex>
+#include <numeric>
+#include <random>
 
 #define DEBUG_TYPE "quantum-mapper"
 
@@ -46,18 +52,90 @@ void identityPlacement(Placement &placement) {
     placement.map(Placement::VirtualQ(i), Placement::DeviceQ(i));
 }
 
+/// Place the virtual qubits on a random permutation of the device qubits.
+void randomPlacement(Placement &placement, std::mt19937 &rng) {
+  SmallVector<unsigned> phys(placement.getNumDeviceQ());
+  std::iota(phys.begin(), phys.end(), 0u);
+  std::shuffle(phys.begin(), phys.end(), rng);
+  for (unsigned i = 0, end = placement.getNumVirtualQ(); i < end; ++i)
+    placement.map(Placement::VirtualQ(i), Placement::DeviceQ(phys[i]));
+}
+
 //===----------------------------------------------------------------------===//
 // Routing
 //===----------------------------------------------------------------------===//
 
+using WireMap = DenseMap<Value, Placement::VirtualQ>;
+
 /// This class encapsulates an quake operation that uses wires with information
 /// about the virtual qubits these wires correspond.
 struct VirtualOp {
   mlir::Operation *op;
   SmallVector<Placement::VirtualQ, 2> qubits;
+  bool isMeasure;
 
   VirtualOp(mlir::Operation *op, ArrayRef<Placement::VirtualQ> qubits)
-      : op(op), qubits(qubits) {}
+      : op(op), qubits(qubits), isMeasure(op->hasTrait<QuantumMeasure>()) {}
+};
+
+/// The dependencies between the quantum operations of a block. The router walks
+/// this graph instead of the IR, so that several routing trials can run
+/// concurrently on the same block and so that the circuit can also be routed
+/// backwards, which is how initial placements are improved.
+struct DependencyGraph {
+  DependencyGraph(Block &block, ArrayRef<quake::NullWireOp> sources,
+                  const WireMap &wireToVirtualQ) {
+    DenseMap<Operation *, unsigned> nodeIds;
+    for (Operation &op : block.getOperations()) {
+      if (!quake::isSupportedMappingOperation(&op))
+        continue;
+      SmallVector<Placement::VirtualQ, 2> qubits;
+      for (auto wire : quake::getQuantumOperands(&op))
+        qubits.push_back(wireToVirtualQ.lookup(wire));
+      nodeIds[&op] = nodes.size();
+      nodes.emplace_back(&op, qubits);
+    }
+
+    // There is one edge per use, as an operation is ready once it has been
+    // visited through every one of its wires.
+    users.resize(nodes.size());
+    definers.resize(nodes.size());
+    for (auto &&[id, node] : llvm::enumerate(nodes))
+      for (auto *user : node.op->getUsers())
+        if (auto iter = nodeIds.find(user); iter != nodeIds.end()) {
+          users[id].push_back(iter->second);
+          definers[iter->second].push_back(id);
+        }
+    for (quake::NullWireOp nullWire : sources)
+      for (auto *user : nullWire->getUsers())
+        if (auto iter = nodeIds.find(user); iter != nodeIds.end())
+          sourceUsers.push_back(iter->second);
+  }
+
+  /// The supported mapping operations of the block, in block order.
+  SmallVector<VirtualOp> nodes;
+
+  /// For each node, the nodes using its results, one entry per use.
+  SmallVector<SmallVector<unsigned, 2>> users;
+
+  /// For each node, the nodes defining its operands, one entry per use.
+  SmallVector<SmallVector<unsigned, 2>> definers;
+
+  /// The nodes using the wires of the source operations, one entry per use.
+  SmallVector<unsigned> sourceUsers;
+};
+
+/// One step of a routing solution: either the operation `node` of the
+/// dependency graph is mapped or the device qubits `phy0` and `phy1` are
+/// swapped.
+struct RoutingStep {
+  static constexpr unsigned swapNode = std::numeric_limits<unsigned>::max();
+
+  unsigned node = swapNode;
+  Placement::DeviceQ phy0;
+  Placement::DeviceQ phy1;
+
+  bool isSwap() const { return node == swapNode; }
 };
 
 /// The `SabreRouter` class is modified implementation of the following paper:
@@ -87,48 +165,82 @@ struct VirtualOp {
 /// to map the front layer again. The routing process ends when the front layer
 /// is empty.
 ///
+/// The router does not modify the IR. It records the mapped operations and the
+/// swaps as a list of steps, which `applyRouting` then applies to the block.
+/// The circuit can also be routed in reverse, from the last operations to the
+/// first, which the forward-backward passes of the paper use to find a good
+/// initial placement.
+///
 /// Modifications from the published paper include the ability to defer
 /// measurement mapping until the end, which is required for QIR Base Profile
 /// programs (see the `allowMeasurementMapping` member variable).
 class SabreRouter {
-  using WireMap = DenseMap<Value, Placement::VirtualQ>;
   using Swap = std::pair<Placement::DeviceQ, Placement::DeviceQ>;
 
 public:
-  SabreRouter(const Device &device, WireMap &wireMap, Placement &placement,
-              unsigned extendedLayerSize, float extendedLayerWeight,
-              float decayDelta, unsigned roundsDecayReset)
-      : device(device), wireToVirtualQ(wireMap), placement(placement),
+  SabreRouter(const Device &device, const DependencyGraph &graph,
+              Placement &placement, unsigned extendedLayerSize,
+              float extendedLayerWeight, float decayDelta,
+              unsigned roundsDecayReset, std::mt19937 *rng = nullptr)
+      : device(device), graph(graph), placement(placement),
         extendedLayerSize(extendedLayerSize),
         extendedLayerWeight(extendedLayerWeight), decayDelta(decayDelta),
-        roundsDecayReset(roundsDecayReset),
-        phyDecay(device.getNumQubits(), 1.0), phyToWire(device.getNumQubits()),
+        roundsDecayReset(roundsDecayReset), rng(rng),
+        phyDecay(device.getNumQubits(), 1.0),
+        phyDepth(device.getNumQubits(), 0), visited(graph.nodes.size(), 0),
         allowMeasurementMapping(false) {}
 
-  /// Main entry point into SabreRouter routing algorithm
-  void route(Block &block, ArrayRef<quake::NullWireOp> sources);
+  /// Main entry point into SabreRouter routing algorithm. Routes the circuit,
+  /// or the reversed circuit if `reverse` is true, starting from the current
+  /// placement. On return, the placement is the final one.
+  void route(bool reverse = false);
+
+  /// After routing, this contains the mapped operations and swaps in order.
+  ArrayRef<RoutingStep> getSteps() const { return steps; }
 
-  /// After routing, this contains the final values for all the qubits
-  ArrayRef<Value> getPhyToWire() { return phyToWire; }
+  /// Returns the number of swaps added by routing.
+  unsigned getNumSwaps() const { return numSwaps; }
+
+  /// Returns the depth of the routed circuit, counting every operation and
+  /// every swap as one layer.
+  unsigned getDepth() const {
+    return phyDepth.empty() ? 0 : *llvm::max_element(phyDepth);
+  }
 
 private:
-  void visitUsers(ResultRange::user_range users,
-                  SmallVectorImpl<VirtualOp> &layer,
-                  SmallVectorImpl<Operation *> *incremented = nullptr);
+  /// Returns the nodes that can only be mapped after `node`.
+  ArrayRef<unsigned> getSuccessors(unsigned node) const {
+    return reverse ? graph.definers[node] : graph.users[node];
+  }
+
+  /// Returns the number of visits after which `node` is ready to be mapped.
+  unsigned getNumPredecessors(unsigned node) const {
+    return reverse ? graph.users[node].size()
+                   : graph.nodes[node].qubits.size();
+  }
+
+  void addToLayer(unsigned node, SmallVectorImpl<unsigned> &layer);
+
+  void visitUsers(ArrayRef<unsigned> users, SmallVectorImpl<unsigned> &layer,
+                  SmallVectorImpl<unsigned> *incremented = nullptr);
+
+  void addToDepth(ArrayRef<Placement::DeviceQ> qubits);
 
-  LogicalResult mapOperation(VirtualOp &virtOp);
+  LogicalResult mapOperation(unsigned node);
 
   LogicalResult mapFrontLayer();
 
   void selectExtendedLayer();
 
-  double computeLayerCost(ArrayRef<VirtualOp> layer);
+  double computeLayerCost(ArrayRef<unsigned> layer);
 
   Swap chooseSwap();
 
+  void addSwap(Placement::DeviceQ phy0, Placement::DeviceQ phy1);
+
 private:
   const Device &device;
-  WireMap &wireToVirtualQ;
+  const DependencyGraph &graph;
   Placement &placement;
 
   // Parameters
@@ -137,18 +249,30 @@ private:
   const float decayDelta;
   const unsigned roundsDecayReset;
 
+  /// If set, ties between swap candidates are broken at random rather than by
+  /// taking the first one.
+  std::mt19937 *rng;
+
   // Internal data
-  SmallVector<VirtualOp> frontLayer;
-  SmallVector<VirtualOp> extendedLayer;
-  SmallVector<VirtualOp> measureLayer;
-  llvm::SmallPtrSet<mlir::Operation *, 32> measureLayerSet;
+  SmallVector<unsigned> frontLayer;
+  SmallVector<unsigned> extendedLayer;
+  SmallVector<unsigned> measureLayer;
+  llvm::SmallDenseSet<unsigned, 32> measureLayerSet;
   llvm::SmallSet<Placement::DeviceQ, 32> involvedPhy;
   SmallVector<float> phyDecay;
 
-  SmallVector<Value> phyToWire;
+  /// The depth of the routed circuit on each device qubit.
+  SmallVector<unsigned> phyDepth;
 
   /// Keeps track of how many times an operation was visited.
-  DenseMap<Operation *, unsigned> visited;
+  SmallVector<unsigned> visited;
+
+  /// The routing solution.
+  SmallVector<RoutingStep> steps;
+  unsigned numSwaps = 0;
+
+  /// Whether the circuit is routed from its last operations to its first.
+  bool reverse = false;
 
   /// Keep track of whether or not we're in the phase that allows measurements
   /// to be mapped
@@ -160,43 +284,40 @@ private:
 #endif
 };
 
-void SabreRouter::visitUsers(ResultRange::user_range users,
-                             SmallVectorImpl<VirtualOp> &layer,
-                             SmallVectorImpl<Operation *> *incremented) {
+void SabreRouter::addToLayer(unsigned node, SmallVectorImpl<unsigned> &layer) {
+  // Don't process measurements until we're ready
+  if (allowMeasurementMapping || !graph.nodes[node].isMeasure) {
+    layer.push_back(node);
+    return;
+  }
+  // Add to measureLayer. Don't add duplicates.
+  if (measureLayerSet.insert(node).second)
+    measureLayer.push_back(node);
+}
+
+void SabreRouter::visitUsers(ArrayRef<unsigned> users,
+                             SmallVectorImpl<unsigned> &layer,
+                             SmallVectorImpl<unsigned> *incremented) {
   for (auto user : users) {
-    auto [entry, created] = visited.try_emplace(user, 1);
-    if (!created)
-      entry->second += 1;
+    visited[user] += 1;
     if (incremented)
       incremented->push_back(user);
-
-    if (!quake::isSupportedMappingOperation(user)) {
-      LLVM_DEBUG({
-        auto *tmpOp = dyn_cast<mlir::Operation *>(user);
-        logger.getOStream() << "WARNING: unsupported op: " << *tmpOp << '\n';
-      });
-    } else {
-      auto wires = quake::getQuantumOperands(user);
-      if (entry->second == wires.size()) {
-        SmallVector<Placement::VirtualQ, 2> qubits;
-        for (auto wire : wires)
-          qubits.push_back(wireToVirtualQ[wire]);
-        // Don't process measurements until we're ready
-        if (allowMeasurementMapping || !user->hasTrait<QuantumMeasure>()) {
-          layer.emplace_back(user, qubits);
-        } else {
-          // Add to measureLayer. Don't add duplicates.
-          if (measureLayerSet.find(user) == measureLayerSet.end()) {
-            measureLayer.emplace_back(user, qubits);
-            measureLayerSet.insert(user);
-          }
-        }
-      }
-    }
+    if (visited[user] == getNumPredecessors(user))
+      addToLayer(user, layer);
   }
 }
 
-LogicalResult SabreRouter::mapOperation(VirtualOp &virtOp) {
+void SabreRouter::addToDepth(ArrayRef<Placement::DeviceQ> qubits) {
+  unsigned depth = 0;
+  for (auto phy : qubits)
+    depth = std::max(depth, phyDepth[phy.index]);
+  for (auto phy : qubits)
+    phyDepth[phy.index] = depth + 1;
+}
+
+LogicalResult SabreRouter::mapOperation(unsigned node) {
+  const VirtualOp &virtOp = graph.nodes[node];
+
   // Take the device qubits from this operation.
   SmallVector<Placement::DeviceQ, 2> deviceQubits;
   for (auto vr : virtOp.qubits)
@@ -204,53 +325,41 @@ LogicalResult SabreRouter::mapOperation(VirtualOp &virtOp) {
 
   // An operation cannot be mapped if it is not a measurement and uses two
   // qubits virtual qubit that are no adjacently placed.
-  if (!virtOp.op->hasTrait<QuantumMeasure>() && deviceQubits.size() == 2 &&
+  if (!virtOp.isMeasure && deviceQubits.size() == 2 &&
       !device.areConnected(deviceQubits[0], deviceQubits[1]))
     return failure();
 
-  // Rewire the operation.
-  SmallVector<Value, 2> newOpWires;
-  for (auto phy : deviceQubits)
-    newOpWires.push_back(phyToWire[phy.index]);
-  if (failed(quake::setQuantumOperands(virtOp.op, newOpWires)))
-    return failure();
-
-  if (isa<quake::SinkOp>(virtOp.op))
-    return success();
-
-  // Update the mapping between device qubits and wires.
-  for (auto &&[w, q] :
-       llvm::zip_equal(quake::getQuantumResults(virtOp.op), deviceQubits))
-    phyToWire[q.index] = w;
-
+  steps.push_back(RoutingStep{node});
+  addToDepth(deviceQubits);
   return success();
 }
 
 LogicalResult SabreRouter::mapFrontLayer() {
   bool mappedAtLeastOne = false;
-  SmallVector<VirtualOp> newFrontLayer;
+  SmallVector<unsigned> newFrontLayer;
 
   LLVM_DEBUG({
     logger.startLine() << "Mapping front layer:\n";
     logger.indent();
   });
-  for (auto virtOp : frontLayer) {
+  for (auto node : frontLayer) {
     LLVM_DEBUG({
       logger.startLine() << "* ";
-      virtOp.op->print(logger.getOStream(),
-                       OpPrintingFlags().printGenericOpForm());
+      graph.nodes[node].op->print(logger.getOStream(),
+                                  OpPrintingFlags().printGenericOpForm());
     });
-    if (failed(mapOperation(virtOp))) {
+    if (failed(mapOperation(node))) {
       LLVM_DEBUG(logger.getOStream() << " --> FAILURE\n");
-      newFrontLayer.push_back(virtOp);
-      for (auto vr : virtOp.qubits)
+      newFrontLayer.push_back(node);
+      for (auto vr : graph.nodes[node].qubits)
         involvedPhy.insert(placement.getPhy(vr));
       LLVM_DEBUG({
-        auto phy0 = placement.getPhy(virtOp.qubits[0]);
-        auto phy1 = placement.getPhy(virtOp.qubits[1]);
+        auto &qubits = graph.nodes[node].qubits;
+        auto phy0 = placement.getPhy(qubits[0]);
+        auto phy1 = placement.getPhy(qubits[1]);
         logger.indent();
-        logger.startLine() << "+ virtual qubits: " << virtOp.qubits[0] << ", "
-                           << virtOp.qubits[1] << '\n';
+        logger.startLine() << "+ virtual qubits: " << qubits[0] << ", "
+                           << qubits[1] << '\n';
         logger.startLine() << "+ device qubits: " << phy0 << ", " << phy1
                            << '\n';
         logger.unindent();
@@ -259,7 +368,7 @@ LogicalResult SabreRouter::mapFrontLayer() {
     }
     LLVM_DEBUG(logger.getOStream() << " --> SUCCESS\n");
     mappedAtLeastOne = true;
-    visitUsers(virtOp.op->getUsers(), newFrontLayer);
+    visitUsers(getSuccessors(node), newFrontLayer);
   }
   LLVM_DEBUG(logger.unindent());
   frontLayer = std::move(newFrontLayer);
@@ -268,31 +377,38 @@ LogicalResult SabreRouter::mapFrontLayer() {
 
 void SabreRouter::selectExtendedLayer() {
   extendedLayer.clear();
-  SmallVector<Operation *, 20> incremented;
-  SmallVector<VirtualOp> tmpLayer = frontLayer;
+  SmallVector<unsigned, 20> incremented;
+  SmallVector<unsigned> tmpLayer = frontLayer;
   while (!tmpLayer.empty() && extendedLayer.size() < extendedLayerSize) {
-    SmallVector<VirtualOp> newTmpLayer;
-    for (VirtualOp &virtOp : tmpLayer)
-      visitUsers(virtOp.op->getUsers(), newTmpLayer, &incremented);
-    for (VirtualOp &virtOp : newTmpLayer)
+    SmallVector<unsigned> newTmpLayer;
+    for (auto node : tmpLayer)
+      visitUsers(getSuccessors(node), newTmpLayer, &incremented);
+    for (auto node : newTmpLayer)
       // We only add operations that can influence placement to the extended
       // frontlayer, i.e., quantum operators that use two qubits.
-      if (!virtOp.op->hasTrait<QuantumMeasure>() &&
-          quake::getQuantumOperands(virtOp.op).size() == 2)
-        extendedLayer.emplace_back(virtOp);
+      if (!graph.nodes[node].isMeasure &&
+          graph.nodes[node].qubits.size() == 2)
+        extendedLayer.push_back(node);
     tmpLayer = std::move(newTmpLayer);
   }
 
-  for (auto virtOp : incremented)
-    visited[virtOp] -= 1;
+  for (auto node : incremented)
+    visited[node] -= 1;
 }
 
-double SabreRouter::computeLayerCost(ArrayRef<VirtualOp> layer) {
+double SabreRouter::computeLayerCost(ArrayRef<unsigned> layer) {
   double cost = 0.0;
-  for (VirtualOp const &virtOp : layer) {
-    auto phy0 = placement.getPhy(virtOp.qubits[0]);
-    auto phy1 = placement.getPhy(virtOp.qubits[1]);
-    cost += device.getDistance(phy0, phy1) - 1;
+  for (auto node : layer) {
+    auto &qubits = graph.nodes[node].qubits;
+    auto phy0 = placement.getPhy(qubits[0]);
+    auto phy1 = placement.getPhy(qubits[1]);
+    if (device.areConnected(phy0, phy1))
+      continue;
+    // The gate itself uses a connection of one of the qubits once they are
+    // next to each other, so the lightest of them is not a routing cost.
+    cost += device.getWeightedDistance(phy0, phy1) -
+            std::min(device.getLightestWeight(phy0),
+                     device.getLightestWeight(phy1));
   }
   return cost / layer.size();
 }
@@ -331,6 +447,17 @@ SabreRouter::Swap SabreRouter::chooseSwap() {
     if (cost[i] < cost[minIdx])
       minIdx = i;
 
+  // Randomized trials pick any of the swaps with minimal cost, so that they
+  // explore different routes.
+  if (rng) {
+    SmallVector<std::size_t> ties;
+    for (std::size_t i = 0u, end = cost.size(); i < end; ++i)
+      if (cost[i] - cost[minIdx] < 1e-9)
+        ties.push_back(i);
+    std::uniform_int_distribution<std::size_t> pick(0, ties.size() - 1);
+    minIdx = ties[pick(*rng)];
+  }
+
   LLVM_DEBUG({
     logger.startLine() << "Choosing a swap:\n";
     logger.indent();
@@ -352,44 +479,38 @@ SabreRouter::Swap SabreRouter::chooseSwap() {
   return candidates[minIdx];
 }
 
-void SabreRouter::route(Block &block, ArrayRef<quake::NullWireOp> sources) {
+void SabreRouter::addSwap(Placement::DeviceQ phy0, Placement::DeviceQ phy1) {
+  placement.swap(phy0, phy1);
+  steps.push_back(RoutingStep{RoutingStep::swapNode, phy0, phy1});
+  addToDepth({phy0, phy1});
+  ++numSwaps;
+}
+
+void SabreRouter::route(bool reverseDirection) {
 #ifndef NDEBUG
   constexpr char logLineComment[] =
       "//===-------------------------------------------===//\n";
 #endif
 
+  reverse = reverseDirection;
   LLVM_DEBUG({
     logger.getOStream() << "\n";
     logger.startLine() << logLineComment;
-    logger.startLine() << "Mapping front layer:\n";
-    logger.indent();
-    for (auto virtOp : sources)
-      logger.startLine() << "* " << virtOp << " --> SUCCESS\n";
-    logger.unindent();
+    logger.startLine() << "Routing " << (reverse ? "backward" : "forward")
+                       << "\n";
     logger.startLine() << logLineComment;
   });
 
-  // The source ops can always be mapped.
-  for (quake::NullWireOp nullWire : sources) {
-    visitUsers(nullWire->getUsers(), frontLayer);
-    Value wire = nullWire.getResult();
-    auto phy = placement.getPhy(wireToVirtualQ[wire]);
-    phyToWire[phy.index] = wire;
+  // The source ops can always be mapped. When routing backwards, the last
+  // operations on each wire take their place.
+  if (reverse) {
+    for (unsigned node = 0, end = graph.nodes.size(); node < end; ++node)
+      if (getNumPredecessors(node) == 0)
+        addToLayer(node, frontLayer);
+  } else {
+    visitUsers(graph.sourceUsers, frontLayer);
   }
 
-  OpBuilder builder(&block, block.begin());
-  auto wireType = builder.getType<quake::WireType>();
-  auto addSwap = [&](Placement::DeviceQ q0, Placement::DeviceQ q1) {
-    placement.swap(q0, q1);
-    auto swap = builder.create<quake::SwapOp>(
-        builder.getUnknownLoc(), TypeRange{wireType, wireType}, false,
-        ValueRange{}, ValueRange{},
-        ValueRange{phyToWire[q0.index], phyToWire[q1.index]},
-        DenseBoolArrayAttr{});
-    phyToWire[q0.index] = swap.getResult(0);
-    phyToWire[q1.index] = swap.getResult(1);
-  };
-
   std::size_t numSwapSearches = 0;
   bool done = false;
   while (!done) {
@@ -431,10 +552,96 @@ void SabreRouter::route(Block &block, ArrayRef<quake::NullWireOp> sources) {
   LLVM_DEBUG(logger.startLine() << '\n' << logLineComment << '\n';);
 }
 
+/// Apply the routing `steps` to `block`: rewire every operation to the current
+/// wires of the device qubits its virtual qubits are placed on, and insert the
+/// swaps. `placement` must be the placement the steps were computed from. On
+/// return, it is the final placement. Returns the final wire of each device
+/// qubit.
+SmallVector<Value> applyRouting(Block &block, const DependencyGraph &graph,
+                                ArrayRef<quake::NullWireOp> sources,
+                                ArrayRef<RoutingStep> steps,
+                                Placement &placement) {
+  // Device qubit `i` starts from the wire of the `i`-th source, whatever the
+  // initial placement, so that the order of the sources is the order of the
+  // device qubits. All sources are equivalent, so this is always valid.
+  SmallVector<Value> phyToWire(placement.getNumDeviceQ());
+  for (auto &&[phy, nullWire] : llvm::enumerate(sources))
+    phyToWire[phy] = nullWire.getResult();
+
+  OpBuilder builder(&block, block.begin());
+  auto wireType = builder.getType<quake::WireType>();
+  for (const RoutingStep &step : steps) {
+    if (step.isSwap()) {
+      auto q0 = step.phy0;
+      auto q1 = step.phy1;
+      placement.swap(q0, q1);
+      auto swap = builder.create<quake::SwapOp>(
+          builder.getUnknownLoc(), TypeRange{wireType, wireType}, false,
+          ValueRange{}, ValueRange{},
+          ValueRange{phyToWire[q0.index], phyToWire[q1.index]},
+          DenseBoolArrayAttr{});
+      phyToWire[q0.index] = swap.getResult(0);
+      phyToWire[q1.index] = swap.getResult(1);
+      continue;
+    }
+
+    // Rewire the operation.
+    const VirtualOp &virtOp = graph.nodes[step.node];
+    SmallVector<Placement::DeviceQ, 2> deviceQubits;
+    SmallVector<Value, 2> newOpWires;
+    for (auto vr : virtOp.qubits) {
+      auto phy = placement.getPhy(vr);
+      deviceQubits.push_back(phy);
+      newOpWires.push_back(phyToWire[phy.index]);
+    }
+    if (failed(quake::setQuantumOperands(virtOp.op, newOpWires)))
+      llvm_unreachable("operation does not match its virtual qubits");
+
+    if (isa<quake::SinkOp>(virtOp.op))
+      continue;
+
+    // Update the mapping between device qubits and wires.
+    for (auto &&[w, q] :
+         llvm::zip_equal(quake::getQuantumResults(virtOp.op), deviceQubits))
+      phyToWire[q.index] = w;
+  }
+  return phyToWire;
+}
+
+/// The outcome of one routing trial.
+struct RoutingTrial {
+  /// The placement routing starts from.
+  Placement initialPlacement;
+  SmallVector<RoutingStep> steps;
+  unsigned numSwaps = 0;
+  unsigned depth = 0;
+};
+
 //===----------------------------------------------------------------------===//
 // Pass implementation
 //===----------------------------------------------------------------------===//
 
+/// Returns the device identified by `key`, which `create` builds the first time
+/// it is requested. Building a device computes the distances between all of
+/// its qubits, which is expensive for large devices, so devices are shared by
+/// every run of the pass in the process. The cache is emptied once it holds
+/// `maxCachedDevices` devices, as devices sized after each kernel accumulate.
+std::shared_ptr<const Device>
+getOrCreateDevice(const std::string &key, function_ref<Device()> create) {
+  constexpr std::size_t maxCachedDevices = 16;
+  static std::mutex cacheMutex;
+  static llvm::StringMap<std::shared_ptr<const Device>> cache;
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  if (auto iter = cache.find(key); iter != cache.end())
+    return iter->second;
+  if (cache.size() >= maxCachedDevices)
+    cache.clear();
+  auto device = std::make_shared<const Device>(create());
+  cache[key] = device;
+  return device;
+}
+
 struct Mapper : public cudaq::opt::impl::MappingPassBase<Mapper> {
   using MappingPassBase::MappingPassBase;
 
@@ -519,6 +726,42 @@ struct Mapper : public cudaq::opt::impl::MappingPassBase<Mapper> {
     return success();
   }
 
+  /// Run routing trial `trial` of the circuit in `graph`. The first trial
+  /// routes from the identity placement. The others improve a starting
+  /// placement, the identity for the second trial and a random one after
+  /// that, with `placementRounds` forward-backward routing passes as in the
+  /// SABRE paper, and then break ties between swaps at random.
+  RoutingTrial route(const Device &d, const DependencyGraph &graph,
+                     unsigned numVirtualQ, unsigned trial) {
+    std::mt19937 rng(seed + trial);
+    std::mt19937 *trialRng = trial ? &rng : nullptr;
+    Placement placement(numVirtualQ, d.getNumQubits());
+    if (trial < 2)
+      identityPlacement(placement);
+    else
+      randomPlacement(placement, rng);
+
+    // Each pass starts from the placement the previous one ended with, so the
+    // backward pass yields a placement suited to the start of the circuit.
+    if (trial)
+      for (unsigned pass = 0; pass < 2 * placementRounds; ++pass) {
+        SabreRouter router(d, graph, placement, extendedLayerSize,
+                           extendedLayerWeight, decayDelta, roundsDecayReset,
+                           trialRng);
+        router.route(/*reverse=*/pass % 2 == 1);
+      }
+
+    RoutingTrial result{placement};
+    SabreRouter router(d, graph, placement, extendedLayerSize,
+                       extendedLayerWeight, decayDelta, roundsDecayReset,
+                       trialRng);
+    router.route();
+    result.steps.assign(router.getSteps().begin(), router.getSteps().end());
+    result.numSwaps = router.getNumSwaps();
+    result.depth = router.getDepth();
+    return result;
+  }
+
   /// Add `op` and all of its users into `opsToMoveToEnd`. `op` may not be
   /// nullptr.
   void addOpAndUsersToList(Operation *op,
@@ -634,17 +877,30 @@ struct Mapper : public cudaq::opt::impl::MappingPassBase<Mapper> {
 
     // These are captured in the user help (device options in Passes.td), so if
     // you update this, be sure to update that as well.
-    Device d;
-    if (deviceTopoType == Path)
-      d = Device::path(x);
-    else if (deviceTopoType == Ring)
-      d = Device::ring(x);
-    else if (deviceTopoType == Star)
-      d = Device::star(/*numQubits=*/x, /*centerQubit=*/y);
-    else if (deviceTopoType == Grid)
-      d = Device::grid(/*width=*/x, /*height=*/y);
-    else if (deviceTopoType == File)
-      d = Device::file(deviceFilename);
+    std::string deviceKey = std::to_string(deviceTopoType) + "(" +
+                            std::to_string(x) + "," + std::to_string(y) + ")";
+    if (deviceTopoType == File) {
+      // A device file that changed on disk must be parsed again.
+      llvm::sys::fs::file_status status;
+      deviceKey += deviceFilename.str();
+      if (!llvm::sys::fs::status(deviceFilename, status))
+        deviceKey += std::to_string(
+            status.getLastModificationTime().time_since_epoch().count());
+    }
+    auto deviceTopology = getOrCreateDevice(deviceKey, [&]() {
+      if (deviceTopoType == Path)
+        return Device::path(x);
+      if (deviceTopoType == Ring)
+        return Device::ring(x);
+      if (deviceTopoType == Star)
+        return Device::star(/*numQubits=*/x, /*centerQubit=*/y);
+      if (deviceTopoType == Grid)
+        return Device::grid(/*width=*/x, /*height=*/y);
+      if (deviceTopoType == File)
+        return Device::file(deviceFilename);
+      return Device();
+    });
+    const Device &d = *deviceTopology;
 
     if (d.getNumQubits() == 0) {
       func.emitError("Trying to target an empty device.");
@@ -652,6 +908,16 @@ struct Mapper : public cudaq::opt::impl::MappingPassBase<Mapper> {
       return;
     }
 
+    // Swaps never move a qubit to another component of the device, so qubits
+    // placed in different components could never interact.
+    if (!d.isConnected()) {
+      func.emitError("The mapper requires a connected device, but some qubits "
+                     "of device [" +
+                     device + "] are not connected by any path.");
+      signalPassFailure();
+      return;
+    }
+
     LLVM_DEBUG({ d.dump(); });
 
     if (sources.size() > d.getNumQubits()) {
@@ -712,14 +978,35 @@ struct Mapper : public cudaq::opt::impl::MappingPassBase<Mapper> {
       sources.push_back(nullWireOp);
     }
 
-    // Place
-    Placement placement(sources.size(), d.getNumQubits());
-    identityPlacement(placement);
-
-    // Route
-    SabreRouter router(d, wireToVirtualQ, placement, extendedLayerSize,
-                       extendedLayerWeight, decayDelta, roundsDecayReset);
-    router.route(*blocks.begin(), sources);
+    // Place and route. Each trial is independent and only reads the IR, so
+    // they run concurrently, unless debug output, which would interleave, is
+    // enabled. The trial with the fewest swaps, then the lowest depth, is kept.
+    // Ties go to the earliest trial.
+    DependencyGraph graph(block, sources, wireToVirtualQ);
+    SmallVector<std::optional<RoutingTrial>> trials(
+        std::max<unsigned>(numTrials, 1));
+    auto runTrial = [&](std::size_t trial) {
+      trials[trial] = route(d, graph, sources.size(), trial);
+    };
+    bool runSerially = false;
+    LLVM_DEBUG(runSerially = true);
+    if (runSerially)
+      for (std::size_t trial = 0; trial < trials.size(); ++trial)
+        runTrial(trial);
+    else
+      parallelFor(&getContext(), 0, trials.size(), runTrial);
+
+    RoutingTrial *best = &*trials.front();
+    for (auto &trial : llvm::drop_begin(trials))
+      if (std::tie(trial->numSwaps, trial->depth) <
+          std::tie(best->numSwaps, best->depth))
+        best = &*trial;
+    LLVM_DEBUG(llvm::dbgs() << "Selected a routing with " << best->numSwaps
+                            << " swaps and depth " << best->depth << '\n');
+
+    Placement placement = best->initialPlacement;
+    auto phyToWire =
+        applyRouting(block, graph, sources, best->steps, placement);
     sortTopologically(&block);
 
     // Ensure that the original measurement ordering is still honored by moving
@@ -747,7 +1034,6 @@ struct Mapper : public cudaq::opt::impl::MappingPassBase<Mapper> {
     }
     // Add sinks where needed
     builder.setInsertionPoint(block.getTerminator());
-    auto phyToWire = router.getPhyToWire();
     for (unsigned i = 0; i < numRemaining; i++)
       builder.create<quake::SinkOp>(phyToWire[i].getLoc(), phyToWire[i]);
 
@@ -0,0 +1,207 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "PassDetails.h"
+#include "cudaq/Optimizer/Dialect/Quake/QuakeOps.h"
+#include "cudaq/Optimizer/Transforms/Passes.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/IR/Matchers.h"
+
+namespace cudaq::opt {
+#define GEN_PASS_DEF_QUAKEPEEPHOLE
+#include "cudaq/Optimizer/Transforms/Passes.h.inc"
+} // namespace cudaq::opt
+
+#define DEBUG_TYPE "quake-peephole"
+
+using namespace mlir;
+
+namespace {
+/// The Pauli basis in which a gate acts on one of its qubits. Two gates that
+/// share qubits commute when, on every shared qubit, both act diagonally in
+/// the same basis.
+enum class Axis { None, X, Y, Z };
+
+/// Return the axis of the quantum operand at position `index` (controls first,
+/// then targets) of the operator `op`.
+static Axis getAxis(quake::OperatorInterface op, std::size_t index) {
+  // A control, negated or not, is a projector onto a computational basis
+  // state, so it is diagonal in the Z basis.
+  if (index < op.getControls().size())
+    return Axis::Z;
+  if (isa<quake::ZOp, quake::SOp, quake::TOp, quake::R1Op, quake::RzOp>(op))
+    return Axis::Z;
+  if (isa<quake::XOp, quake::RxOp>(op))
+    return Axis::X;
+  if (isa<quake::YOp, quake::RyOp>(op))
+    return Axis::Y;
+  return Axis::None;
+}
+
+/// Gates the pass knows how to cancel or merge.
+static bool isCandidate(Operation *op) {
+  return isa<quake::HOp, quake::XOp, quake::YOp, quake::ZOp, quake::SwapOp,
+             quake::SOp, quake::TOp, quake::R1Op, quake::RxOp, quake::RyOp,
+             quake::RzOp>(op);
+}
+
+/// Return the operator if `op` is a gate in value form, i.e., every quantum
+/// operand is a wire and the results are those wires in operand order.
+static quake::OperatorInterface getWireOperator(Operation *op) {
+  auto gate = dyn_cast_or_null<quake::OperatorInterface>(op);
+  if (!gate)
+    return {};
+  auto operands = quake::getQuantumOperands(op);
+  if (operands.empty() || operands.size() != op->getNumResults())
+    return {};
+  for (auto v : operands)
+    if (!isa<quake::WireType>(v.getType()))
+      return {};
+  return gate;
+}
+
+/// Replace all uses of the wires produced by `op` with its input wires and
+/// erase it.
+static void eraseGate(Operation *op) {
+  for (auto [res, arg] :
+       llvm::zip(op->getResults(), quake::getQuantumOperands(op)))
+    res.replaceAllUsesWith(arg);
+  op->erase();
+}
+
+class QuakePeepholePass
+    : public cudaq::opt::impl::QuakePeepholeBase<QuakePeepholePass> {
+public:
+  using QuakePeepholeBase::QuakePeepholeBase;
+
+  void runOnOperation() override {
+    getOperation().walk([&](Block *block) {
+      for (auto &op : llvm::make_early_inc_range(*block))
+        if (isCandidate(&op))
+          if (auto gate = getWireOperator(&op))
+            visit(gate);
+    });
+  }
+
+  /// Search backwards along each wire of `gate` for an earlier gate of the
+  /// same kind applied to the same wires, moving past any gates `gate`
+  /// commutes with. If found, cancel or merge the pair.
+  void visit(quake::OperatorInterface gate) {
+    if (gate.getNegatedControls())
+      return;
+    Operation *partner = nullptr;
+    auto operands = quake::getQuantumOperands(gate);
+    for (auto iter : llvm::enumerate(operands)) {
+      auto found = findPartner(gate, iter.index(), iter.value());
+      if (!found || (partner && partner != found))
+        return;
+      partner = found;
+    }
+    if (!partner)
+      return;
+    auto other = cast<quake::OperatorInterface>(partner);
+    if (other.getNegatedControls())
+      return;
+
+    // Hermitian gates are self-inverse. S and T are inverted by their adjoint.
+    bool selfInverse = gate->hasTrait<cudaq::Hermitian>();
+    if (selfInverse || isa<quake::SOp, quake::TOp>(gate)) {
+      if (!selfInverse && gate.isAdj() == other.isAdj())
+        return;
+      LLVM_DEBUG(llvm::dbgs()
+                 << "cancelling " << *gate.getOperation() << '\n');
+      eraseGate(gate);
+      eraseGate(partner);
+      return;
+    }
+    mergeRotations(gate, other);
+  }
+
+  /// Walk back from `wire`, which is quantum operand `index` of `gate`. Return
+  /// the first gate of the same kind and shape producing the wire at the same
+  /// position, or null if a gate that does not commute is found first.
+  Operation *findPartner(quake::OperatorInterface gate, std::size_t index,
+                         Value wire) {
+    auto axis = getAxis(gate, index);
+    auto numControls = gate.getControls().size();
+    auto numTargets = gate.getTargets().size();
+    while (auto *def = wire.getDefiningOp()) {
+      if (def->getBlock() != gate->getBlock())
+        return nullptr;
+      auto prev = getWireOperator(def);
+      if (!prev)
+        return nullptr;
+      auto position = cast<OpResult>(wire).getResultNumber();
+      if (def->getName() == gate->getName() &&
+          prev.getControls().size() == numControls &&
+          prev.getTargets().size() == numTargets && position == index)
+        return def;
+      if (axis == Axis::None || getAxis(prev, position) != axis)
+        return nullptr;
+      wire = quake::getQuantumOperands(def)[position];
+    }
+    return nullptr;
+  }
+
+  /// Fold the rotation `prev` into `gate`. `gate` keeps its position and wires
+  /// and takes the summed angle, `prev` is removed. If the summed angle is a
+  /// constant zero, both gates are removed.
+  void mergeRotations(quake::OperatorInterface gate,
+                      quake::OperatorInterface prev) {
+    auto angle1 = prev.getParameters()[0];
+    auto angle2 = gate.getParameters()[0];
+    if (angle1.getType() != angle2.getType())
+      return;
+    LLVM_DEBUG(llvm::dbgs()
+               << "merging into " << *gate.getOperation() << '\n');
+
+    // The effective angle is negated for an adjoint, so the angles are added
+    // when the adjoint flags agree and subtracted otherwise, in which case the
+    // result is expressed on the non-adjoint form.
+    bool resultAdj = gate.isAdj();
+    bool subtract = prev.isAdj() != gate.isAdj();
+    Value lhs = angle2;
+    Value rhs = angle1;
+    if (subtract && gate.isAdj()) {
+      std::swap(lhs, rhs);
+      resultAdj = false;
+    }
+
+    OpBuilder builder(gate);
+    auto loc = gate.getLoc();
+    Value newAngle;
+    APFloat c1(0.0);
+    APFloat c2(0.0);
+    if (matchPattern(lhs, m_ConstantFloat(&c1)) &&
+        matchPattern(rhs, m_ConstantFloat(&c2))) {
+      double sum = subtract ? c1.convertToDouble() - c2.convertToDouble()
+                            : c1.convertToDouble() + c2.convertToDouble();
+      if (std::abs(sum) < zeroTolerance) {
+        eraseGate(gate);
+        eraseGate(prev);
+        return;
+      }
+      newAngle = builder.create<arith::ConstantOp>(
+          loc, builder.getFloatAttr(lhs.getType(), sum));
+    } else if (subtract) {
+      newAngle = builder.create<arith::SubFOp>(loc, lhs, rhs);
+    } else {
+      newAngle = builder.create<arith::AddFOp>(loc, lhs, rhs);
+    }
+
+    gate->setOperand(0, newAngle);
+    if (resultAdj)
+      gate->setAttr("is_adj", builder.getUnitAttr());
+    else
+      gate->removeAttr("is_adj");
+    eraseGate(prev);
+  }
+
+  static constexpr double zeroTolerance = 1e-12;
+};
+} // namespace
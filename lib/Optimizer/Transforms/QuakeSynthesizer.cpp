@@ -295,10 +295,19 @@ protected:
   // The raw pointer to the runtime arguments.
   void *args;
 
+  // Optional map applied to every floating-point argument value.
+  std::function<double(double)> floatMapper;
+
 public:
   QuakeSynthesizer() = default;
-  QuakeSynthesizer(std::string_view kernel, void *a)
-      : kernelName(kernel), args(a) {}
+  QuakeSynthesizer(std::string_view kernel, void *a,
+                   std::function<double(double)> mapper = {})
+      : kernelName(kernel), args(a), floatMapper(std::move(mapper)) {}
+
+  template <typename T>
+  T mapFloat(T value) {
+    return floatMapper ? static_cast<T>(floatMapper(value)) : value;
+  }
 
   mlir::ModuleOp getModule() { return getOperation(); }
 
@@ -413,8 +422,8 @@ public:
       if (type == builder.getF32Type()) {
         synthesizeRuntimeArgument<float>(
             builder, argument, args, offset, type.getIntOrFloatBitWidth() / 8,
-            [=](OpBuilder &builder, float *concrete) {
-              llvm::APFloat f(*concrete);
+            [&](OpBuilder &builder, float *concrete) {
+              llvm::APFloat f(mapFloat(*concrete));
               return builder.create<arith::ConstantFloatOp>(
                   loc, f, builder.getF32Type());
             });
@@ -423,8 +432,8 @@ public:
       if (type == builder.getF64Type()) {
         synthesizeRuntimeArgument<double>(
             builder, argument, args, offset, type.getIntOrFloatBitWidth() / 8,
-            [=](OpBuilder &builder, double *concrete) {
-              llvm::APFloat f(*concrete);
+            [&](OpBuilder &builder, double *concrete) {
+              llvm::APFloat f(mapFloat(*concrete));
               return builder.create<arith::ConstantFloatOp>(
                   loc, f, builder.getF64Type());
             });
@@ -486,6 +495,9 @@ public:
       auto doVector = [&]<typename T>(T) {
         auto *ptr = reinterpret_cast<T *>(bufferAppendix);
         std::vector<T> v(ptr, ptr + vecLength);
+        if constexpr (std::is_floating_point_v<T>)
+          for (auto &element : v)
+            element = mapFloat(element);
         if (failed(synthesizeVectorArgument(builder, arguments[idx], v)))
           funcOp.emitOpError("synthesis failed for vector<T>");
         bufferAppendix += vecLength * sizeof(T);
@@ -556,3 +568,10 @@ std::unique_ptr<mlir::Pass>
 cudaq::opt::createQuakeSynthesizer(std::string_view kernelName, void *a) {
   return std::make_unique<QuakeSynthesizer>(kernelName, a);
 }
+
+std::unique_ptr<mlir::Pass>
+cudaq::opt::createQuakeSynthesizer(std::string_view kernelName, void *a,
+                                   std::function<double(double)> floatMapper) {
+  return std::make_unique<QuakeSynthesizer>(kernelName, a,
+                                            std::move(floatMapper));
+}
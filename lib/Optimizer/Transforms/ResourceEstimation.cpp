@@ -0,0 +1,521 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "LoopAnalysis.h"
+#include "PassDetails.h"
+#include "cudaq/Optimizer/Dialect/CC/CCOps.h"
+#include "cudaq/Optimizer/Dialect/Quake/QuakeOps.h"
+#include "cudaq/Optimizer/Transforms/Passes.h"
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/IR/Matchers.h"
+#include <map>
+
+namespace cudaq::opt {
+#define GEN_PASS_DEF_RESOURCEESTIMATION
+#include "cudaq/Optimizer/Transforms/Passes.h.inc"
+} // namespace cudaq::opt
+
+#define DEBUG_TYPE "resource-estimation"
+
+using namespace mlir;
+
+namespace {
+/// The resources used by one execution of a function or a region.
+struct ResourceCounts {
+  /// Gate counts keyed by the gate name and its number of controls.
+  std::map<std::pair<std::string, std::size_t>, std::uint64_t> gates;
+  std::uint64_t measurements = 0;
+  std::uint64_t qubits = 0;
+  std::uint64_t twoQubitDepth = 0;
+  /// False if any count had to be approximated, e.g., because a loop trip
+  /// count or a vector size is not a compile-time constant.
+  bool exact = true;
+
+  std::uint64_t getTCount() const {
+    std::uint64_t result = 0;
+    for (const char *name : {"t", "tdg"}) {
+      auto iter = gates.find({name, 0});
+      if (iter != gates.end())
+        result = llvm::SaturatingAdd(result, iter->second);
+    }
+    return result;
+  }
+
+  /// Add the gates and measurements of `other`, executed `times` times with
+  /// `numControls` additional controls on each gate. If `adjoint` is set, the
+  /// gates are replaced by their adjoints. Gate counts saturate instead of
+  /// overflowing.
+  void append(const ResourceCounts &other, std::uint64_t times,
+              std::size_t numControls = 0, bool adjoint = false) {
+    for (auto &[key, count] : other.gates) {
+      auto name = key.first;
+      if (adjoint)
+        name = llvm::StringSwitch<std::string>(name)
+                   .Case("s", "sdg")
+                   .Case("sdg", "s")
+                   .Case("t", "tdg")
+                   .Case("tdg", "t")
+                   .Default(name);
+      auto &total = gates[{name, key.second + numControls}];
+      total =
+          llvm::SaturatingAdd(total, llvm::SaturatingMultiply(count, times));
+    }
+    measurements = llvm::SaturatingAdd(
+        measurements, llvm::SaturatingMultiply(other.measurements, times));
+    exact &= other.exact;
+  }
+
+  llvm::json::Value toJSON() const {
+    llvm::json::Array gateArray;
+    for (auto &[key, count] : gates)
+      gateArray.push_back(llvm::json::Object{
+          {"name", key.first}, {"controls", key.second}, {"count", count}});
+    return llvm::json::Object{{"gates", std::move(gateArray)},
+                              {"t_count", getTCount()},
+                              {"measurements", measurements},
+                              {"qubits", qubits},
+                              {"two_qubit_depth", twoQubitDepth},
+                              {"exact", exact}};
+  }
+};
+
+/// Identifies a qubit for the depth computation: a reference, a wire, or the
+/// qubit at a constant offset in a vector. The offset `allQubits` stands for
+/// every qubit of the vector.
+using QubitKey = std::pair<Value, std::int64_t>;
+static constexpr std::int64_t allQubits = -1;
+
+/// The two-qubit depth reached so far on each qubit.
+using DepthMap = DenseMap<QubitKey, std::uint64_t>;
+
+static std::optional<std::int64_t> getConstant(Value v) {
+  APInt value;
+  if (matchPattern(v, m_ConstantInt(&value)))
+    return value.getSExtValue();
+  return std::nullopt;
+}
+
+static QubitKey getQubitKey(Value v) {
+  if (auto extract = v.getDefiningOp<quake::ExtractRefOp>()) {
+    std::optional<std::int64_t> index;
+    if (extract.hasConstantIndex())
+      index = extract.getConstantIndex();
+    else
+      index = getConstant(extract.getIndex());
+    // Map an index into a subvector to an index into the vector it was taken
+    // from.
+    Value veq = extract.getVeq();
+    while (index) {
+      if (auto relax = veq.getDefiningOp<quake::RelaxSizeOp>()) {
+        veq = relax.getInputVec();
+        continue;
+      }
+      auto sub = veq.getDefiningOp<quake::SubVeqOp>();
+      if (!sub)
+        break;
+      auto low = getConstant(sub.getLow());
+      if (!low)
+        index = std::nullopt;
+      else
+        *index += *low;
+      veq = sub.getVeq();
+    }
+    return {getQubitKey(veq).first, index.value_or(allQubits)};
+  }
+  if (auto relax = v.getDefiningOp<quake::RelaxSizeOp>())
+    return getQubitKey(relax.getInputVec());
+  if (auto sub = v.getDefiningOp<quake::SubVeqOp>())
+    return {getQubitKey(sub.getVeq()).first, allQubits};
+  if (isa<quake::VeqType>(v.getType()))
+    return {v, allQubits};
+  return {v, 0};
+}
+
+static std::uint64_t getDepth(const DepthMap &depths, QubitKey key) {
+  std::uint64_t result = 0;
+  if (key.second == allQubits) {
+    for (auto &[k, depth] : depths)
+      if (k.first == key.first)
+        result = std::max(result, depth);
+    return result;
+  }
+  for (auto k : {key, QubitKey{key.first, allQubits}}) {
+    auto iter = depths.find(k);
+    if (iter != depths.end())
+      result = std::max(result, iter->second);
+  }
+  return result;
+}
+
+static void setDepth(DepthMap &depths, QubitKey key, std::uint64_t depth) {
+  if (key.second == allQubits)
+    for (auto &[k, d] : depths)
+      if (k.first == key.first)
+        d = depth;
+  depths[key] = depth;
+}
+
+/// Return the number of qubits in `v` or `std::nullopt` if it is a vector of
+/// unknown size.
+static std::optional<std::uint64_t> getNumQubits(Value v) {
+  if (auto veq = dyn_cast<quake::VeqType>(v.getType())) {
+    if (veq.hasSpecifiedSize())
+      return veq.getSize();
+    return std::nullopt;
+  }
+  return 1;
+}
+
+static bool isQuantum(Value v) {
+  return isa<quake::RefType, quake::VeqType, quake::WireType>(v.getType());
+}
+
+/// Return the predicate `p'` such that `a p b` is equivalent to `b p' a`.
+static arith::CmpIPredicate getSwappedPredicate(arith::CmpIPredicate p) {
+  using P = arith::CmpIPredicate;
+  switch (p) {
+  case P::slt:
+    return P::sgt;
+  case P::sle:
+    return P::sge;
+  case P::sgt:
+    return P::slt;
+  case P::sge:
+    return P::sle;
+  case P::ult:
+    return P::ugt;
+  case P::ule:
+    return P::uge;
+  case P::ugt:
+    return P::ult;
+  case P::uge:
+    return P::ule;
+  default:
+    return p;
+  }
+}
+
+/// Return the number of iterations of `loop` if it is a compile-time constant.
+static std::optional<std::uint64_t> getTripCount(cudaq::cc::LoopOp loop) {
+  cudaq::opt::LoopComponents c;
+  if (!cudaq::opt::isaMonotonicLoop(loop, /*allowEarlyExit=*/false, &c) ||
+      c.isLinearExpr())
+    return std::nullopt;
+  auto init = getConstant(c.initialValue);
+  auto bound = getConstant(c.compareValue);
+  auto step = getConstant(c.stepValue);
+  if (!init || !bound || !step || *step == 0)
+    return std::nullopt;
+  std::int64_t stride = c.stepIsAnAddOp() ? *step : -*step;
+
+  // Normalize the comparison to `induction pred bound`.
+  auto cmp = cast<arith::CmpIOp>(c.compareOp);
+  auto pred = cmp.getPredicate();
+  if (cmp.getLhs() == c.compareValue)
+    pred = getSwappedPredicate(pred);
+  if (cudaq::opt::isUnsignedPredicate(pred) && (*init < 0 || *bound < 0))
+    return std::nullopt;
+
+  std::int64_t distance = *bound - *init;
+  switch (pred) {
+  case arith::CmpIPredicate::slt:
+  case arith::CmpIPredicate::ult:
+    if (stride < 0)
+      return std::nullopt;
+    return distance > 0 ? (distance + stride - 1) / stride : 0;
+  case arith::CmpIPredicate::sle:
+  case arith::CmpIPredicate::ule:
+    if (stride < 0)
+      return std::nullopt;
+    return distance >= 0 ? distance / stride + 1 : 0;
+  case arith::CmpIPredicate::sgt:
+  case arith::CmpIPredicate::ugt:
+    if (stride > 0)
+      return std::nullopt;
+    return distance < 0 ? (-distance - stride - 1) / -stride : 0;
+  case arith::CmpIPredicate::sge:
+  case arith::CmpIPredicate::uge:
+    if (stride > 0)
+      return std::nullopt;
+    return distance <= 0 ? -distance / -stride + 1 : 0;
+  case arith::CmpIPredicate::ne:
+    if (distance % stride != 0 || distance / stride < 0)
+      return std::nullopt;
+    return distance / stride;
+  default:
+    return std::nullopt;
+  }
+}
+
+/// Computes the resources of the functions in a module. The resources of a
+/// callee are computed once and reused at every call site.
+class ResourceEstimator {
+public:
+  const ResourceCounts &estimate(func::FuncOp func) {
+    auto iter = cache.find(func.getOperation());
+    if (iter != cache.end())
+      return iter->second;
+    inProgress.insert(func.getOperation());
+    ResourceCounts counts;
+    DepthMap depths;
+    visitRegion(func.getBody(), counts, depths);
+    for (auto &[key, depth] : depths)
+      counts.twoQubitDepth = std::max(counts.twoQubitDepth, depth);
+    inProgress.erase(func.getOperation());
+    return cache[func.getOperation()] = std::move(counts);
+  }
+
+private:
+  void visitRegion(Region &region, ResourceCounts &counts, DepthMap &depths) {
+    // Without structured control flow, blocks may execute any number of
+    // times. Each is counted once.
+    if (!region.hasOneBlock() && !region.empty())
+      counts.exact = false;
+    for (auto &block : region)
+      for (auto &op : block)
+        visitOp(&op, counts, depths);
+  }
+
+  /// Visit the regions of `op` on their own and return the two-qubit depth
+  /// of one execution and the qubits used in them.
+  std::uint64_t visitIsolated(Operation *op, ResourceCounts &counts,
+                              SmallVectorImpl<QubitKey> &used) {
+    DepthMap inner;
+    for (auto &region : op->getRegions())
+      visitRegion(region, counts, inner);
+    std::uint64_t depth = 0;
+    for (auto &[key, d] : inner) {
+      used.push_back(key);
+      depth = std::max(depth, d);
+    }
+    return depth;
+  }
+
+  /// Schedule a block of two-qubit depth `length` on the qubits `used` and
+  /// the quantum operands of `op`, after all of them are available. The wires
+  /// produced by `op` are available at the end of the block.
+  void scheduleBlock(Operation *op, ArrayRef<QubitKey> used,
+                     std::uint64_t length, DepthMap &depths) {
+    SmallVector<QubitKey> keys(used.begin(), used.end());
+    for (auto v : op->getOperands())
+      if (isQuantum(v))
+        keys.push_back(getQubitKey(v));
+    std::uint64_t start = 0;
+    for (auto key : keys)
+      start = std::max(start, getDepth(depths, key));
+    auto end = llvm::SaturatingAdd(start, length);
+    for (auto key : keys)
+      setDepth(depths, key, end);
+    for (auto v : op->getResults())
+      if (isa<quake::WireType>(v.getType()))
+        setDepth(depths, {v, 0}, end);
+  }
+
+  /// Return the total number of qubits in `values`.
+  std::uint64_t countQubits(ValueRange values, ResourceCounts &counts) {
+    std::uint64_t result = 0;
+    for (auto v : values) {
+      auto n = getNumQubits(v);
+      if (!n)
+        counts.exact = false;
+      result += n.value_or(1);
+    }
+    return result;
+  }
+
+  void visitGate(quake::OperatorInterface gate, ResourceCounts &counts,
+                 DepthMap &depths) {
+    auto name = gate->getName().stripDialect().str();
+    if (gate.isAdj() && isa<quake::SOp, quake::TOp>(gate))
+      name += "dg";
+    auto numControls = countQubits(gate.getControls(), counts);
+    auto numTargets = countQubits(gate.getTargets(), counts);
+    // A single-qubit gate applied to a vector is applied to each of its
+    // qubits.
+    std::uint64_t times = 1;
+    if (gate.getTargets().size() == 1 &&
+        isa<quake::VeqType>(gate.getTarget(0).getType())) {
+      times = numTargets;
+      numTargets = 1;
+    }
+    auto &total = counts.gates[{name, numControls}];
+    total = llvm::SaturatingAdd(total, times);
+
+    if (numControls + numTargets < 2) {
+      // Single-qubit gates do not add to the depth, the wires keep theirs.
+      auto operands = quake::getQuantumOperands(gate);
+      auto results = quake::getQuantumResults(gate);
+      if (operands.size() == results.size())
+        for (auto [from, to] : llvm::zip(operands, results))
+          setDepth(depths, {to, 0}, getDepth(depths, getQubitKey(from)));
+      return;
+    }
+    scheduleBlock(gate, {}, 1, depths);
+  }
+
+  void visitCall(Operation *op, SymbolRefAttr callee, std::size_t numControls,
+                 bool adjoint, ResourceCounts &counts, DepthMap &depths) {
+    auto func =
+        callee ? SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(op, callee)
+               : func::FuncOp{};
+    if (!func || func.empty() || inProgress.contains(func.getOperation())) {
+      counts.exact = false;
+      return;
+    }
+    const auto &calleeCounts = estimate(func);
+    counts.append(calleeCounts, 1, numControls, adjoint);
+    counts.qubits = llvm::SaturatingAdd(counts.qubits, calleeCounts.qubits);
+    // With additional controls, every gate of the callee acts on the control
+    // qubits, so the gates can no longer run in parallel.
+    std::uint64_t length = calleeCounts.twoQubitDepth;
+    if (numControls) {
+      length = 0;
+      for (auto &[key, count] : calleeCounts.gates)
+        length = llvm::SaturatingAdd(length, count);
+    }
+    scheduleBlock(op, {}, length, depths);
+  }
+
+  void visitLoop(cudaq::cc::LoopOp loop, ResourceCounts &counts,
+                 DepthMap &depths) {
+    auto tripCount = getTripCount(loop);
+    LLVM_DEBUG({
+      if (tripCount)
+        llvm::dbgs() << "loop with " << *tripCount << " iterations\n";
+      else
+        llvm::dbgs() << "loop with an unknown trip count\n";
+    });
+    // Qubits allocated in the body are assumed to be released at the end of
+    // each iteration, so they are counted once. The iterations are assumed to
+    // run one after the other on the qubits the body uses.
+    ResourceCounts body;
+    SmallVector<QubitKey> used;
+    auto length = visitIsolated(loop, body, used);
+    if (!tripCount)
+      counts.exact = false;
+    auto times = tripCount.value_or(1);
+    if (!times)
+      return;
+    counts.append(body, times);
+    counts.qubits = llvm::SaturatingAdd(counts.qubits, body.qubits);
+    scheduleBlock(loop, used, llvm::SaturatingMultiply(length, times), depths);
+  }
+
+  void visitIf(cudaq::cc::IfOp ifOp, ResourceCounts &counts,
+               DepthMap &depths) {
+    // Only one branch is taken, so each count is the larger of the two.
+    ResourceCounts branches[2];
+    SmallVector<QubitKey> used;
+    std::uint64_t length = 0;
+    for (auto iter : llvm::enumerate(ifOp->getRegions())) {
+      DepthMap inner;
+      visitRegion(iter.value(), branches[iter.index()], inner);
+      for (auto &[key, d] : inner) {
+        used.push_back(key);
+        length = std::max(length, d);
+      }
+    }
+    auto &[thenCounts, elseCounts] = branches;
+    ResourceCounts merged = thenCounts;
+    for (auto &[key, count] : elseCounts.gates)
+      merged.gates[key] = std::max(merged.gates[key], count);
+    merged.measurements =
+        std::max(thenCounts.measurements, elseCounts.measurements);
+    merged.exact = thenCounts.exact && elseCounts.exact &&
+                   thenCounts.gates == elseCounts.gates &&
+                   thenCounts.measurements == elseCounts.measurements;
+    counts.append(merged, 1);
+    counts.qubits = llvm::SaturatingAdd(
+        counts.qubits, std::max(thenCounts.qubits, elseCounts.qubits));
+    scheduleBlock(ifOp, used, length, depths);
+  }
+
+  void visitOp(Operation *op, ResourceCounts &counts, DepthMap &depths) {
+    if (auto alloc = dyn_cast<quake::AllocaOp>(op)) {
+      auto n = getNumQubits(alloc.getResult());
+      if (!n && alloc.getSize())
+        if (auto size = getConstant(alloc.getSize()))
+          n = *size;
+      if (!n)
+        counts.exact = false;
+      counts.qubits = llvm::SaturatingAdd(counts.qubits, n.value_or(0));
+      return;
+    }
+    if (isa<quake::NullWireOp>(op)) {
+      counts.qubits = llvm::SaturatingAdd(counts.qubits, std::uint64_t{1});
+      return;
+    }
+    if (auto meas = dyn_cast<quake::MeasurementInterface>(op)) {
+      counts.measurements = llvm::SaturatingAdd(
+          counts.measurements, countQubits(meas.getTargets(), counts));
+      auto operands = quake::getQuantumOperands(op);
+      auto results = quake::getQuantumResults(op);
+      if (operands.size() == results.size())
+        for (auto [from, to] : llvm::zip(operands, results))
+          setDepth(depths, {to, 0}, getDepth(depths, getQubitKey(from)));
+      return;
+    }
+    if (auto gate = dyn_cast<quake::OperatorInterface>(op))
+      return visitGate(gate, counts, depths);
+    if (auto call = dyn_cast<func::CallOp>(op))
+      return visitCall(op, call.getCalleeAttr(), 0, false, counts, depths);
+    if (auto apply = dyn_cast<quake::ApplyOp>(op))
+      return visitCall(op, apply.getCalleeAttr(),
+                       countQubits(apply.getControls(), counts),
+                       apply.getIsAdj(), counts, depths);
+    if (isa<func::CallIndirectOp, cudaq::cc::CallCallableOp>(op)) {
+      counts.exact = false;
+      return;
+    }
+    if (auto loop = dyn_cast<cudaq::cc::LoopOp>(op))
+      return visitLoop(loop, counts, depths);
+    if (auto ifOp = dyn_cast<cudaq::cc::IfOp>(op))
+      return visitIf(ifOp, counts, depths);
+    // The body of a lambda is counted where it is called.
+    if (isa<cudaq::cc::CreateLambdaOp>(op))
+      return;
+    for (auto &region : op->getRegions())
+      visitRegion(region, counts, depths);
+  }
+
+  DenseMap<Operation *, ResourceCounts> cache;
+  DenseSet<Operation *> inProgress;
+};
+
+class ResourceEstimationPass
+    : public cudaq::opt::impl::ResourceEstimationBase<ResourceEstimationPass> {
+public:
+  using ResourceEstimationBase::ResourceEstimationBase;
+
+  void runOnOperation() override {
+    auto module = getOperation();
+    std::error_code ec;
+    llvm::ToolOutputFile out(outputFilename, ec, llvm::sys::fs::OF_None);
+    if (ec) {
+      llvm::errs() << "Failed to open output file '" << outputFilename << "'\n";
+      std::exit(ec.value());
+    }
+
+    ResourceEstimator estimator;
+    llvm::json::Object result;
+    for (auto func : module.getOps<func::FuncOp>())
+      if (!func.empty())
+        result[func.getName().str()] = estimator.estimate(func).toJSON();
+    out.os() << llvm::formatv("{0:2}", llvm::json::Value(std::move(result)))
+             << '\n';
+    out.keep();
+    markAllAnalysesPreserved();
+  }
+};
+} // namespace
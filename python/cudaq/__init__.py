@@ -25,6 +25,7 @@ qvector = cudaq_runtime.qvector
 qview = cudaq_runtime.qview
 SpinOperator = cudaq_runtime.SpinOperator
 Pauli = cudaq_runtime.Pauli
+TermDistribution = cudaq_runtime.TermDistribution
 Kernel = PyKernel
 Target = cudaq_runtime.Target
 State = cudaq_runtime.State
@@ -75,6 +76,9 @@ draw = cudaq_runtime.draw
 
 ComplexMatrix = cudaq_runtime.ComplexMatrix
 to_qir = cudaq_runtime.get_qir
+get_jit_cache_statistics = cudaq_runtime.get_jit_cache_statistics
+set_jit_cache_size = cudaq_runtime.set_jit_cache_size
+clear_jit_cache = cudaq_runtime.clear_jit_cache
 testing = cudaq_runtime.testing
 
 
@@ -147,7 +147,8 @@ observe_result pyObservePar(const PyParType &type, py::object &kernel,
   auto nRanks = mpi::num_ranks();
 
   // Each rank gets a subset of the spin terms
-  auto spins = spin_operator.distribute_terms(nRanks);
+  auto spins = spin_operator.distribute_terms(
+      nRanks, term_distribution::cost_balanced);
 
   // Get this rank's set of spins to compute
   auto localH = spins[rank];
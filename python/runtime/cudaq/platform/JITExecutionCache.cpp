@@ -6,28 +6,74 @@
  * the terms of the Apache License 2.0 which accompanies this distribution.    *
  ******************************************************************************/
 #include "JITExecutionCache.h"
+#include "common/JIT.h"
 
 using namespace mlir;
 
 namespace cudaq {
 
+JITExecutionCache::JITExecutionCache() : capacity(getJITCacheSize()) {}
+
 JITExecutionCache::~JITExecutionCache() {
   std::scoped_lock<std::mutex> lock(mutex);
-  for (auto &[k, v] : cacheMap)
-    delete v;
   cacheMap.clear();
+  entries.clear();
+}
+
+void JITExecutionCache::evict() {
+  while (entries.size() > capacity) {
+    cacheMap.erase(entries.back().first);
+    entries.pop_back();
+    ++stats.evictions;
+  }
 }
+
 bool JITExecutionCache::hasJITEngine(std::size_t hashkey) {
   std::scoped_lock<std::mutex> lock(mutex);
   return cacheMap.count(hashkey);
 }
 
-void JITExecutionCache::cache(std::size_t hash, ExecutionEngine *jit) {
+void JITExecutionCache::cache(std::size_t hash,
+                              std::shared_ptr<ExecutionEngine> engine) {
   std::scoped_lock<std::mutex> lock(mutex);
-  cacheMap.insert({hash, jit});
+  if (capacity == 0 || cacheMap.count(hash))
+    return;
+  entries.emplace_front(hash, std::move(engine));
+  cacheMap.insert({hash, entries.begin()});
+  evict();
 }
-ExecutionEngine *JITExecutionCache::getJITEngine(std::size_t hash) {
+
+std::shared_ptr<ExecutionEngine>
+JITExecutionCache::getJITEngine(std::size_t hash) {
+  std::scoped_lock<std::mutex> lock(mutex);
+  auto iter = cacheMap.find(hash);
+  if (iter == cacheMap.end()) {
+    ++stats.misses;
+    return nullptr;
+  }
+  ++stats.hits;
+  entries.splice(entries.begin(), entries, iter->second);
+  return iter->second->second;
+}
+
+void JITExecutionCache::setCapacity(std::size_t newCapacity) {
+  std::scoped_lock<std::mutex> lock(mutex);
+  capacity = newCapacity;
+  evict();
+}
+
+void JITExecutionCache::clear() {
+  std::scoped_lock<std::mutex> lock(mutex);
+  cacheMap.clear();
+  entries.clear();
+  stats = Statistics();
+}
+
+JITExecutionCache::Statistics JITExecutionCache::getStatistics() {
   std::scoped_lock<std::mutex> lock(mutex);
-  return cacheMap.at(hash);
+  auto result = stats;
+  result.size = entries.size();
+  result.capacity = capacity;
+  return result;
 }
-} // namespace cudaq
\ No newline at end of file
+} // namespace cudaq
@@ -8,6 +8,8 @@
 #pragma once
 
 #include "mlir/ExecutionEngine/ExecutionEngine.h"
+#include <list>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 
@@ -18,17 +20,53 @@ namespace cudaq {
 /// @brief The JITExecutionCache is a utility class for
 /// storing ExecutionEngine pointers keyed on the hash
 /// for the string representation of the original MLIR ModuleOp.
+/// It keeps at most `capacity` engines and evicts the least recently
+/// used one beyond that. Engines are shared, so that an engine that is
+/// evicted while a kernel is running stays alive until it returns.
 class JITExecutionCache {
+public:
+  /// @brief Hit, miss and eviction counts of the cache.
+  struct Statistics {
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t evictions = 0;
+    std::size_t size = 0;
+    std::size_t capacity = 0;
+  };
+
 protected:
-  std::unordered_map<std::size_t, ExecutionEngine *> cacheMap;
+  using Entry = std::pair<std::size_t, std::shared_ptr<ExecutionEngine>>;
+  /// @brief Cached engines, most recently used first.
+  std::list<Entry> entries;
+  std::unordered_map<std::size_t, std::list<Entry>::iterator> cacheMap;
+  std::size_t capacity;
+  Statistics stats;
   std::mutex mutex;
 
+  /// @brief Evict the least recently used engines beyond the capacity.
+  void evict();
+
 public:
-  JITExecutionCache() = default;
+  /// @brief The constructor, the capacity is shared with the other JIT caches
+  /// of the runtime, see `cudaq::getJITCacheSize`.
+  JITExecutionCache();
   ~JITExecutionCache();
 
-  void cache(std::size_t hash, ExecutionEngine *);
+  /// @brief Cache the given engine, unless caching is disabled or an engine
+  /// is already cached for this hash.
+  void cache(std::size_t hash, std::shared_ptr<ExecutionEngine>);
   bool hasJITEngine(std::size_t hash);
-  ExecutionEngine *getJITEngine(std::size_t hash);
+
+  /// @brief Return the engine for the given hash, or null if it is not
+  /// cached. Records a hit or a miss.
+  std::shared_ptr<ExecutionEngine> getJITEngine(std::size_t hash);
+
+  /// @brief Set the maximum number of cached engines, 0 disables caching.
+  void setCapacity(std::size_t capacity);
+
+  /// @brief Drop all cached engines and reset the statistics.
+  void clear();
+
+  Statistics getStatistics();
 };
 } // namespace cudaq
@@ -35,34 +35,42 @@ using namespace mlir;
 namespace cudaq {
 static std::unique_ptr<JITExecutionCache> jitCache;
 
-std::tuple<ExecutionEngine *, void *, std::size_t>
+std::tuple<std::shared_ptr<ExecutionEngine>, void *, std::size_t>
 jitAndCreateArgs(const std::string &name, MlirModule module,
                  cudaq::OpaqueArguments &runtimeArgs,
                  const std::vector<std::string> &names, Type returnType) {
   auto mod = unwrap(module);
-  auto cloned = mod.clone();
-  auto context = cloned.getContext();
+
+  // Runs of single-qubit gates are fused into one gate, unless a noise model,
+  // which attaches channels to individual gates, is active or the kernel is
+  // traced, e.g. to draw it, which must show the gates as written.
+  auto *ctx = cudaq::get_platform().get_exec_ctx();
+  bool fuseGates = !ctx || (!ctx->noiseModel && ctx->name != "tracer");
 
   // Have we JIT compiled this before?
-  auto hash = llvm::hash_code{0};
+  auto hash = llvm::hash_code{fuseGates};
   mod.walk([&hash](Operation *op) {
     hash = llvm::hash_combine(hash, OperationEquivalence::computeHash(op));
   });
   auto hashKey = static_cast<size_t>(hash);
 
-  ExecutionEngine *jit = nullptr;
-  if (jitCache->hasJITEngine(hashKey))
-    jit = jitCache->getJITEngine(hashKey);
-  else {
-
+  // The engine is shared with the cache, so that it stays alive while the
+  // kernel runs even if the cache evicts it meanwhile.
+  std::shared_ptr<ExecutionEngine> jit = jitCache->getJITEngine(hashKey);
+  if (!jit) {
+    OwningOpRef<ModuleOp> cloned(mod.clone());
+    auto context = cloned->getContext();
     PassManager pm(context);
     pm.addNestedPass<func::FuncOp>(
         cudaq::opt::createPySynthCallableBlockArgs(names));
     pm.addPass(cudaq::opt::createGenerateDeviceCodeLoader(/*genAsQuake=*/true));
     pm.addPass(cudaq::opt::createGenerateKernelExecution());
     pm.addPass(cudaq::opt::createLambdaLiftingPass());
+    if (fuseGates)
+      pm.addNestedPass<func::FuncOp>(
+          cudaq::opt::createFuseSingleQubitGates());
     cudaq::opt::addPipelineToQIR<>(pm);
-    if (failed(pm.run(cloned)))
+    if (failed(pm.run(*cloned)))
       throw std::runtime_error(
           "cudaq::builder failed to JIT compile the Quake representation.");
 
@@ -95,11 +103,10 @@ jitAndCreateArgs(const std::string &name, MlirModule module,
       return llvmModule;
     };
 
-    auto jitOrError = ExecutionEngine::create(cloned, opts);
+    auto jitOrError = ExecutionEngine::create(*cloned, opts);
     assert(!!jitOrError);
 
-    auto uniqueJit = std::move(jitOrError.get());
-    jit = uniqueJit.release();
+    jit = std::move(jitOrError.get());
     jitCache->cache(hashKey, jit);
   }
 
@@ -361,5 +368,32 @@ void bindAltLaunchKernel(py::module &mod) {
         return getQIRLL(name, module, args, profile);
       },
       py::arg("kernel"), py::kw_only(), py::arg("profile") = "");
+
+  mod.def(
+      "get_jit_cache_statistics",
+      []() {
+        auto stats = jitCache->getStatistics();
+        py::dict result;
+        result["hits"] = stats.hits;
+        result["misses"] = stats.misses;
+        result["evictions"] = stats.evictions;
+        result["size"] = stats.size;
+        result["capacity"] = stats.capacity;
+        return result;
+      },
+      "Return the hit, miss and eviction counts, the number of cached "
+      "kernels and the capacity of the JIT compilation cache of kernels.");
+  mod.def(
+      "set_jit_cache_size",
+      [](std::size_t capacity) { jitCache->setCapacity(capacity); },
+      py::arg("capacity"),
+      "Set the maximum number of JIT compiled kernels kept in memory. Least "
+      "recently used kernels are evicted beyond that, 0 disables caching. The "
+      "initial size is read from the `CUDAQ_JIT_CACHE_SIZE` environment "
+      "variable, which also sets the size of the other JIT caches of the "
+      "runtime, and defaults to 64.");
+  mod.def(
+      "clear_jit_cache", []() { jitCache->clear(); },
+      "Drop all JIT compiled kernels and reset the cache statistics.");
 }
 } // namespace cudaq
\ No newline at end of file
@@ -66,6 +66,13 @@ void bindSpinOperator(py::module &mod) {
       .value("Z", pauli::Z)
       .value("I", pauli::I);
 
+  py::enum_<cudaq::term_distribution>(
+      mod, "TermDistribution",
+      "An enumeration of the strategies for distributing the terms of a "
+      ":class:`SpinOperator` into chunks.")
+      .value("EqualCount", term_distribution::equal_count)
+      .value("CostBalanced", term_distribution::cost_balanced);
+
   py::class_<cudaq::spin_op>(mod, "SpinOperator")
       /// @brief Bind the constructors.
       .def(py::init<>(), "Empty constructor, creates the identity term.")
@@ -116,10 +123,12 @@ void bindSpinOperator(py::module &mod) {
            "Print a string representation of this :class:`SpinOperator`.")
       .def("distribute_terms", &cudaq::spin_op::distribute_terms,
            py::arg("chunk_count"),
+           py::arg("strategy") = term_distribution::equal_count,
            "Return a list of :class:`SpinOperator` representing a distribution "
            "of the "
-           "terms in this :class:`SpinOperator` into `chunk_count` sized "
-           "chunks.")
+           "terms in this :class:`SpinOperator` into `chunk_count` chunks. "
+           "The chunks are equally sized by default, or of similar estimated "
+           "measurement cost with `TermDistribution.CostBalanced`.")
       .def_static("random", &cudaq::spin_op::random, py::arg("qubit_count"),
                   py::arg("term_count"),
                   py::arg("seed") = std::random_device{}(),
@@ -7,6 +7,7 @@
 # ============================================================================ #
 
 import cudaq, pytest, os, time
+import numpy as np
 from cudaq import spin
 from multiprocessing import Process
 
@@ -117,6 +118,69 @@ def test_quantinuum_exp_pauli():
     assert assert_close(res.expectation())
 
 
+def test_quantinuum_late_bound_parameters(monkeypatch, tmp_path):
+
+    @cudaq.kernel
+    def rotation(theta: float):
+        qubit = cudaq.qubit()
+        ry(theta, qubit)
+        mz(qubit)
+
+    def sample_all(cache_dir):
+        # Every kernel that is lowered for its argument values is stored in
+        # the compilation cache.
+        monkeypatch.setenv("CUDAQ_COMPILATION_CACHE_DIR", str(cache_dir))
+        cudaq.set_target('quantinuum', emulate='true')
+        for theta, expected in [(0., '0'), (np.pi, '1'), (0., '0')]:
+            counts = cudaq.sample(rotation, theta)
+            assert (len(counts) == 1)
+            assert (expected in counts)
+        return len(list(cache_dir.glob("*.json")))
+
+    # By default, the kernel is lowered once per distinct value.
+    assert sample_all(tmp_path / "default") == 2
+
+    # With late binding, the kernel is lowered once with placeholders and the
+    # values are substituted into that lowering, so no kernel is lowered for
+    # its values.
+    monkeypatch.setenv("CUDAQ_LATE_BIND_PARAMETERS", "1")
+    assert sample_all(tmp_path / "late_bound") == 0
+
+
+def test_quantinuum_late_bound_division(monkeypatch, tmp_path):
+
+    @cudaq.kernel
+    def halved(theta: float):
+        qubit = cudaq.qubit()
+        ry(theta / 2., qubit)
+        mz(qubit)
+
+    @cudaq.kernel
+    def inverted(theta: float):
+        qubit = cudaq.qubit()
+        ry(np.pi / theta, qubit)
+        mz(qubit)
+
+    monkeypatch.setenv("CUDAQ_LATE_BIND_PARAMETERS", "1")
+
+    def sample_all(kernel, cases, cache_dir):
+        monkeypatch.setenv("CUDAQ_COMPILATION_CACHE_DIR", str(cache_dir))
+        cudaq.set_target('quantinuum', emulate='true')
+        for theta, expected in cases:
+            counts = cudaq.sample(kernel, theta)
+            assert (len(counts) == 1)
+            assert (expected in counts)
+        return len(list(cache_dir.glob("*.json")))
+
+    # Dividing an argument by a constant is linear in it, hence bound late.
+    cases = [(0., '0'), (2. * np.pi, '1'), (0., '0')]
+    assert sample_all(halved, cases, tmp_path / "halved") == 0
+
+    # Dividing by an argument is not, so the kernel is lowered per value.
+    cases = [(1., '1'), (0.5, '0'), (1., '1')]
+    assert sample_all(inverted, cases, tmp_path / "inverted") == 2
+
+
 # leave for gdb debugging
 if __name__ == "__main__":
     loc = os.path.abspath(__file__)
@@ -120,6 +120,53 @@ def test_sdg_1_state_negate():
     assert counts["1"] == 1000
 
 
+def test_fused_single_qubit_gates():
+    """Tests kernels whose runs of single-qubit gates are fused into u3."""
+    kernel = cudaq.make_kernel()
+    qubits = kernel.qalloc(2)
+
+    # Both runs on qubit 0 are fused. The controlled gate, whose control is
+    # in the 0-state, separates them. The second run undoes the first one and
+    # then flips the qubit. Applying the transpose of either fused gate
+    # instead would leave the qubit in the 0-state.
+    kernel.h(qubits[0])
+    kernel.s(qubits[0])
+    kernel.cx(qubits[1], qubits[0])
+    kernel.sdg(qubits[0])
+    kernel.h(qubits[0])
+    kernel.x(qubits[0])
+    kernel.mz(qubits)
+
+    counts = cudaq.sample(kernel)
+    print(counts)
+    assert counts["10"] == 1000
+
+    # The fused gate keeps the global phase, so the state is exact.
+    kernel = cudaq.make_kernel()
+    qubit = kernel.qalloc()
+    kernel.h(qubit)
+    kernel.t(qubit)
+    kernel.rx(0.3, qubit)
+    kernel.s(qubit)
+    kernel.ry(1.1, qubit)
+
+    def rx(angle):
+        return np.array([[np.cos(angle / 2), -1j * np.sin(angle / 2)],
+                         [-1j * np.sin(angle / 2),
+                          np.cos(angle / 2)]])
+
+    def ry(angle):
+        return np.array([[np.cos(angle / 2), -np.sin(angle / 2)],
+                         [np.sin(angle / 2), np.cos(angle / 2)]])
+
+    h = np.array([[1, 1], [1, -1]]) / np.sqrt(2)
+    t = np.diag([1, np.exp(1j * np.pi / 4)])
+    s = np.diag([1, 1j])
+    want_state = ry(1.1) @ s @ rx(0.3) @ t @ h @ np.array([1, 0])
+    got_state = np.array(cudaq.get_state(kernel))
+    assert np.allclose(want_state, got_state)
+
+
 def test_tdg_0_state():
     """Tests the adjoint T-gate on a qubit starting in the 0-state."""
     kernel = cudaq.make_kernel()
@@ -900,3 +900,45 @@ def test_draw_fail():
 
     with pytest.raises(RuntimeError) as error:
         print(cudaq.draw(kernel))
+
+
+@pytest.fixture
+def jit_cache_size():
+    # Restore the capacity set by the environment, even if the test fails.
+    capacity = cudaq.get_jit_cache_statistics()['capacity']
+    yield
+    cudaq.set_jit_cache_size(capacity)
+
+
+def test_jit_cache_statistics(jit_cache_size):
+    cudaq.clear_jit_cache()
+    cudaq.set_jit_cache_size(2)
+
+    kernels = []
+    for angle in [0.1, 0.2, 0.3]:
+        kernel = cudaq.make_kernel()
+        q = kernel.qalloc()
+        kernel.ry(angle, q)
+        kernels.append(kernel)
+
+    for kernel in kernels:
+        cudaq.sample(kernel)
+    stats = cudaq.get_jit_cache_statistics()
+    assert stats['capacity'] == 2
+    assert stats['size'] == 2
+    assert stats['misses'] >= 3
+    assert stats['evictions'] >= 1
+
+    # The most recently used kernel is still cached.
+    hits = stats['hits']
+    counts = cudaq.sample(kernels[-1])
+    assert len(counts) > 0
+    assert cudaq.get_jit_cache_statistics()['hits'] > hits
+
+    # An evicted kernel is compiled again.
+    counts = cudaq.sample(kernels[0])
+    assert len(counts) > 0
+
+    cudaq.clear_jit_cache()
+    stats = cudaq.get_jit_cache_statistics()
+    assert stats['size'] == 0 and stats['hits'] == 0
@@ -0,0 +1,61 @@
+# ============================================================================ #
+# Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                   #
+# All rights reserved.                                                         #
+#                                                                              #
+# This source code and the accompanying materials are made available under     #
+# the terms of the Apache License 2.0 which accompanies this distribution.     #
+# ============================================================================ #
+
+import cudaq, pytest
+from cudaq import spin
+
+skipIfNoCPUMQPU = pytest.mark.skipif(not cudaq.has_target('qpp-mqpu'),
+                                     reason="qpp-mqpu backend not available")
+
+num_qpus = 3
+
+
+@pytest.fixture(autouse=True)
+def do_something():
+    cudaq.set_target('qpp-mqpu', nqpus=str(num_qpus))
+    yield
+    cudaq.__clearKernelRegistries()
+    cudaq.reset_target()
+
+
+@skipIfNoCPUMQPU
+def testNumQpus():
+    assert cudaq.get_target().num_qpus() == num_qpus
+
+
+@skipIfNoCPUMQPU
+def testObserveParallel():
+    kernel, theta = cudaq.make_kernel(float)
+    qreg = kernel.qalloc(2)
+    kernel.x(qreg[0])
+    kernel.ry(theta, qreg[1])
+    kernel.cx(qreg[1], qreg[0])
+
+    hamiltonian = 5.907 - 2.1433 * spin.x(0) * spin.x(1) - 2.1433 * spin.y(
+        0) * spin.y(1) + .21829 * spin.z(0) - 6.125 * spin.z(1)
+    result = cudaq.observe(kernel,
+                           hamiltonian,
+                           0.59,
+                           execution=cudaq.parallel.thread)
+    assert abs(result.expectation() - -1.7487948611472093) < 1e-5
+
+
+@skipIfNoCPUMQPU
+def testSampleAsyncOnEachQpu():
+    kernel, n = cudaq.make_kernel(int)
+    qreg = kernel.qalloc(n)
+    kernel.x(qreg)
+    kernel.mz(qreg)
+
+    futures = [
+        cudaq.sample_async(kernel, qpu + 1, qpu_id=qpu)
+        for qpu in range(num_qpus)
+    ]
+    for qpu, future in enumerate(futures):
+        counts = future.get()
+        assert counts.most_probable() == '1' * (qpu + 1)
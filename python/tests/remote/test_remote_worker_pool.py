@@ -0,0 +1,140 @@
+# ============================================================================ #
+# Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                   #
+# All rights reserved.                                                         #
+#                                                                              #
+# This source code and the accompanying materials are made available under     #
+# the terms of the Apache License 2.0 which accompanies this distribution.     #
+# ============================================================================ #
+import os, shutil, socket, subprocess, time
+import urllib.error, urllib.request
+import pytest
+
+import cudaq
+
+# The server runs 2 requests concurrently and queues 1 more, while the client
+# sends requests from 4 QPUs, all pointing to the same server.
+num_workers = 2
+queue_size = 1
+num_qpus = 4
+
+
+def find_qpud():
+    cudaq_dir = os.path.dirname(os.path.abspath(cudaq.__file__))
+    # Installed packages and build trees keep it in different places.
+    paths = [
+        os.path.join(cudaq_dir, "..", "bin"),
+        os.path.join(cudaq_dir, "..", "..", "bin"), None
+    ]
+    for path in paths:
+        qpud = shutil.which("cudaq-qpud", path=path)
+        if qpud:
+            return qpud
+    return None
+
+
+def find_free_port():
+    with socket.socket(socket.AF_INET, socket.SOCK_STREAM) as s:
+        s.bind(("localhost", 0))
+        return s.getsockname()[1]
+
+
+@pytest.fixture(scope="module")
+def server_url():
+    qpud = find_qpud()
+    if qpud is None:
+        pytest.skip("cudaq-qpud not found")
+    port = find_free_port()
+    process = subprocess.Popen([
+        qpud, "--port",
+        str(port), "--workers",
+        str(num_workers), "--queue-size",
+        str(queue_size)
+    ])
+    url = f"http://localhost:{port}"
+    for _ in range(100):
+        try:
+            urllib.request.urlopen(url, timeout=1)
+            break
+        except (urllib.error.URLError, ConnectionError):
+            time.sleep(0.1)
+    cudaq.set_target("remote-mqpu",
+                     url=",".join([f"localhost:{port}"] * num_qpus))
+    yield url
+    cudaq.reset_target()
+    process.terminate()
+    process.wait()
+
+
+def make_bits_kernel(bits):
+    kernel = cudaq.make_kernel()
+    qubits = kernel.qalloc(len(bits))
+    for i, bit in enumerate(bits):
+        if bit == "1":
+            kernel.x(qubits[i])
+    kernel.mz(qubits)
+    return kernel
+
+
+def make_slow_kernel(num_qubits=18, num_layers=100):
+    # An even number of Hadamard layers leaves the qubits in |0>, while keeping
+    # the simulator busy for a while.
+    kernel = cudaq.make_kernel()
+    qubits = kernel.qalloc(num_qubits)
+    for _ in range(num_layers):
+        kernel.h(qubits)
+    kernel.mz(qubits)
+    return kernel
+
+
+def test_concurrent_requests(server_url):
+    # Every request has its own expected result, so that results that are
+    # mixed up between concurrently handled requests are detected.
+    patterns = [format(i, "04b") for i in range(16)]
+    futures = [
+        cudaq.sample_async(make_bits_kernel(bits),
+                           shots_count=100,
+                           qpu_id=i % num_qpus)
+        for i, bits in enumerate(patterns)
+    ]
+    for bits, future in zip(patterns, futures):
+        counts = future.get()
+        assert len(counts) == 1
+        assert counts[bits] == 100
+
+
+def test_busy_server_retry(server_url):
+    # One more request than the server accepts, the last one is rejected with
+    # 503 Service Unavailable and retried by the client.
+    kernel = make_slow_kernel()
+    futures = [
+        cudaq.sample_async(kernel, shots_count=10, qpu_id=i)
+        for i in range(num_qpus)
+    ]
+
+    # While the server is full, other requests are rejected before their body
+    # is even parsed.
+    busy_response = None
+    for _ in range(200):
+        request = urllib.request.Request(f"{server_url}/job",
+                                         data=b"{}",
+                                         method="POST")
+        try:
+            urllib.request.urlopen(request, timeout=10)
+        except urllib.error.HTTPError as e:
+            if e.code == 503:
+                busy_response = e
+                break
+        time.sleep(0.05)
+    assert busy_response is not None
+    assert int(busy_response.headers["Retry-After"]) > 0
+
+    for future in futures:
+        counts = future.get()
+        assert len(counts) == 1
+        assert counts["0" * 18] == 10
+
+
+# leave for gdb debugging
+if __name__ == "__main__":
+    loc = os.path.abspath(__file__)
+    pytest.main([loc, "-rP"])
@@ -7,9 +7,11 @@
  ******************************************************************************/
 
 #pragma once
+#include "common/CompilationCache.h"
 #include "common/ExecutionContext.h"
 #include "common/Executor.h"
 #include "common/FmtCore.h"
+#include "common/JITCache.h"
 #include "common/Logger.h"
 #include "common/RestClient.h"
 #include "common/RuntimeMLIR.h"
@@ -18,18 +20,23 @@
 #include "cudaq/Optimizer/CodeGen/OpenQASMEmitter.h"
 #include "cudaq/Optimizer/CodeGen/Passes.h"
 #include "cudaq/Optimizer/Dialect/CC/CCDialect.h"
+#include "cudaq/Optimizer/Dialect/CC/CCOps.h"
 #include "cudaq/Optimizer/Dialect/Quake/QuakeDialect.h"
 #include "cudaq/Optimizer/Transforms/Passes.h"
 #include "cudaq/Support/Plugin.h"
+#include "cudaq/Support/Version.h"
 #include "cudaq/platform/qpu.h"
 #include "cudaq/platform/quantum_platform.h"
 #include "cudaq/spin_op.h"
 #include "nvqpp_config.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Bitcode/BitcodeReader.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Support/Base64.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SHA256.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Dialect/LLVMIR/LLVMDialect.h"
@@ -41,12 +48,16 @@
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Pass/PassRegistry.h"
 #include "mlir/Tools/mlir-translate/Translation.h"
+#include <cmath>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <netinet/in.h>
 #include <regex>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <unordered_map>
 
 using namespace mlir;
 
@@ -106,6 +117,49 @@ protected:
   /// of JIT engines for invoking the kernels.
   std::vector<ExecutionEngine *> jitEngines;
 
+  /// @brief The persistent cache of lowered codes, null if disabled. Enabled
+  /// by setting `CUDAQ_COMPILATION_CACHE_DIR`.
+  std::unique_ptr<cudaq::CompilationCache> compilationCache;
+
+  /// @brief Return the compilation cache key of the given synthesized module,
+  /// i.e. a hash of the module and everything else its lowering depends on.
+  std::string getCompilationCacheKey(ModuleOp moduleOp) {
+    llvm::SHA256 hasher;
+    auto update = [&](llvm::StringRef str) {
+      hasher.update(str);
+      // Separate the fields, so that different splits do not collide.
+      hasher.update(llvm::StringRef("\0", 1));
+    };
+    update("cudaq-compilation-cache-v1");
+    // Entries of other CUDA-Q or LLVM builds may lower differently.
+    update(cudaq::getVersion());
+    update(cudaq::getFullRepositoryVersion());
+    update(LLVM_VERSION_STRING);
+    std::string moduleStr;
+    {
+      llvm::raw_string_ostream os(moduleStr);
+      moduleOp.print(os);
+    }
+    update(moduleStr);
+    update(passPipelineConfig);
+    update(codegenTranslation);
+    update(postCodeGenPasses);
+    update(qpuName);
+    update(emulate ? "emulate" : "remote");
+    for (auto &[key, value] : backendConfig) {
+      update(key);
+      update(value);
+    }
+    if (executionContext) {
+      update(executionContext->name);
+      if (executionContext->name == "observe")
+        executionContext->spin.value()->for_each_term(
+            [&](cudaq::spin_op &term) { update(term.to_string(false)); });
+    }
+    auto digest = hasher.final();
+    return llvm::toHex(digest, /*LowerCase=*/true);
+  }
+
   /// @brief Invoke the kernel in the JIT engine
   void invokeJITKernel(ExecutionEngine *jit, const std::string &kernelName) {
     auto funcPtr = jit->lookup(std::string("__nvqpp__mlirgen__") + kernelName);
@@ -146,6 +200,8 @@ public:
     platformPath = cudaqLibPath.parent_path().parent_path() / "targets";
     // Default is to run sampling via the remote rest call
     executor = std::make_unique<cudaq::Executor>();
+    compilationCache = cudaq::CompilationCache::createFromEnvironment();
+    lateBindParameters = getEnvBool("CUDAQ_LATE_BIND_PARAMETERS");
   }
 
   BaseRemoteRESTQPU(BaseRemoteRESTQPU &&) = delete;
@@ -172,6 +228,11 @@ public:
 
   /// Clear the number of shots
   void clearShots() override { nShots = std::nullopt; }
+
+  /// @brief Return the timing of the last job submission of this QPU.
+  cudaq::Executor::SubmissionStatistics getSubmissionStatistics() const {
+    return executor->getSubmissionStatistics();
+  }
   virtual bool isRemote() override { return !emulate; }
 
   /// @brief Return true if locally emulating a remote QPU
@@ -353,66 +414,108 @@ public:
     return output_names;
   }
 
-  /// @brief Extract the Quake representation for the given kernel name and
-  /// lower it to the code format required for the specific backend. The
-  /// lowering process is controllable via the configuration file in the
-  /// platform directory for the targeted backend.
-  std::vector<cudaq::KernelExecution>
-  lowerQuakeCode(const std::string &kernelName, void *kernelArgs) {
+  /// @brief Partition the non-identity terms of `spin` into groups that can
+  /// be measured with the same basis changes, i.e. terms that are qubit-wise
+  /// compatible. Return, for each group, its name and the binary symplectic
+  /// form of its measurement basis. Groups of several terms are named by their
+  /// comma-separated term strings. If `shareCircuits` is false, every term
+  /// forms its own group.
+  static std::vector<std::pair<std::string, std::vector<bool>>>
+  groupMeasurementCompatibleTerms(cudaq::spin_op &spin, bool shareCircuits) {
+    std::vector<std::pair<std::string, std::vector<bool>>> groups;
+    for (const auto &term : spin) {
+      if (term.is_identity())
+        continue;
+      auto [binarySymplecticForm, coeffs] = term.get_raw_data();
+      auto &bsf = binarySymplecticForm[0];
+
+      // Find the first group whose basis agrees on every qubit this term
+      // measures.
+      auto iter = groups.end();
+      if (shareCircuits)
+        iter = std::find_if(groups.begin(), groups.end(), [&](auto &group) {
+          return group.second.size() == bsf.size() &&
+                 cudaq::details::isQubitWiseCompatible(group.second, bsf);
+        });
+
+      if (iter == groups.end()) {
+        groups.emplace_back(term.to_string(false), bsf);
+        continue;
+      }
+      iter->first += "," + term.to_string(false);
+      for (std::size_t i = 0; i < bsf.size(); i++)
+        iter->second[i] = iter->second[i] || bsf[i];
+    }
+    return groups;
+  }
 
-    auto [m_module, contextPtr, updatedArgs] =
-        extractQuakeCodeAndContext(kernelName, kernelArgs);
+  /// @brief Return the pipeline to run after appending the measurement basis
+  /// changes of an observe term to the already lowered ansatz. This is the
+  /// lowering pipeline without qubit mapping, since the basis changes are
+  /// single-qubit gates on qubits that have already been placed.
+  std::string getBasisChangePipeline() const {
+    auto pipeline = std::regex_replace(
+        passPipelineConfig, std::regex("qubit-mapping(\\{[^\\}]*\\})?"), "");
+    // Drop the separators and nested pipelines left empty.
+    pipeline = std::regex_replace(pipeline, std::regex("[\\w.]+\\(,*\\)"), "");
+    pipeline = std::regex_replace(pipeline, std::regex(",,+"), ",");
+    pipeline = std::regex_replace(pipeline, std::regex("\\(,"), "(");
+    pipeline = std::regex_replace(pipeline, std::regex(",\\)"), ")");
+    return std::regex_replace(pipeline, std::regex("^,|,$"), "");
+  }
 
-    MLIRContext &context = *contextPtr;
+  /// @brief Run the given pass pipeline on `moduleOp`.
+  void runPassPipeline(const std::string &kernelName,
+                       const std::string &pipeline, ModuleOp moduleOp) {
+    PassManager pm(moduleOp.getContext());
+    std::string errMsg;
+    llvm::raw_string_ostream os(errMsg);
+    cudaq::info("Pass pipeline for {} = {}", kernelName, pipeline);
+    if (failed(parsePassPipeline(pipeline, pm, os)))
+      throw std::runtime_error(
+          "Remote rest platform failed to add passes to pipeline (" + errMsg +
+          ").");
+    if (disableMLIRthreading || enablePrintMLIREachPass)
+      moduleOp.getContext()->disableMultithreading();
+    if (enablePrintMLIREachPass)
+      pm.enableIRPrinting();
+    if (failed(pm.run(moduleOp)))
+      throw std::runtime_error("Remote rest platform Quake lowering failed.");
+  }
 
-    // Extract the kernel name
-    auto func = m_module.lookupSymbol<mlir::func::FuncOp>(
-        std::string("__nvqpp__mlirgen__") + kernelName);
+  /// @brief Replace the arguments of the kernel in `moduleOp` by the values
+  /// in `args`, passing every floating-point value through `floatMapper` if
+  /// it is given.
+  void synthesizeArguments(const std::string &kernelName, ModuleOp moduleOp,
+                           void *args,
+                           std::function<double(double)> floatMapper = {}) {
+    cudaq::info("Run Quake Synth.\n");
+    PassManager pm(moduleOp.getContext());
+    if (floatMapper)
+      pm.addPass(cudaq::opt::createQuakeSynthesizer(kernelName, args,
+                                                    std::move(floatMapper)));
+    else
+      pm.addPass(cudaq::opt::createQuakeSynthesizer(kernelName, args));
+    if (disableMLIRthreading || enablePrintMLIREachPass)
+      moduleOp.getContext()->disableMultithreading();
+    if (enablePrintMLIREachPass)
+      pm.enableIRPrinting();
+    if (failed(pm.run(moduleOp)))
+      throw std::runtime_error("Could not successfully apply quake-synth.");
+  }
 
-    // Create a new Module to clone the function into
+  /// @brief Run the config-specified pass pipeline on the synthesized
+  /// `moduleOp` and, for observe, append the measurements of every group of
+  /// terms. Return the modules to translate and the mapping reorder indices.
+  std::pair<std::vector<std::pair<std::string, ModuleOp>>,
+            std::vector<std::size_t>>
+  lowerSynthesizedModule(const std::string &kernelName, ModuleOp moduleOp) {
+    auto &context = *moduleOp.getContext();
     auto location = FileLineColLoc::get(&context, "<builder>", 1, 1);
     ImplicitLocOpBuilder builder(location, &context);
 
-    // FIXME this should be added to the builder.
-    if (!func->hasAttr(cudaq::entryPointAttrName))
-      func->setAttr(cudaq::entryPointAttrName, builder.getUnitAttr());
-    auto moduleOp = builder.create<ModuleOp>();
-    moduleOp.push_back(func.clone());
-    moduleOp->setAttrs(m_module->getAttrDictionary());
-
-    // Lambda to apply a specific pipeline to the given ModuleOp
-    auto runPassPipeline = [&](const std::string &pipeline,
-                               ModuleOp moduleOpIn) {
-      PassManager pm(&context);
-      std::string errMsg;
-      llvm::raw_string_ostream os(errMsg);
-      cudaq::info("Pass pipeline for {} = {}", kernelName, pipeline);
-      if (failed(parsePassPipeline(pipeline, pm, os)))
-        throw std::runtime_error(
-            "Remote rest platform failed to add passes to pipeline (" + errMsg +
-            ").");
-      if (disableMLIRthreading || enablePrintMLIREachPass)
-        moduleOpIn.getContext()->disableMultithreading();
-      if (enablePrintMLIREachPass)
-        pm.enableIRPrinting();
-      if (failed(pm.run(moduleOpIn)))
-        throw std::runtime_error("Remote rest platform Quake lowering failed.");
-    };
-
-    if (updatedArgs) {
-      cudaq::info("Run Quake Synth.\n");
-      PassManager pm(&context);
-      pm.addPass(cudaq::opt::createQuakeSynthesizer(kernelName, updatedArgs));
-      if (disableMLIRthreading || enablePrintMLIREachPass)
-        moduleOp.getContext()->disableMultithreading();
-      if (enablePrintMLIREachPass)
-        pm.enableIRPrinting();
-      if (failed(pm.run(moduleOp)))
-        throw std::runtime_error("Could not successfully apply quake-synth.");
-    }
-
     // Run the config-specified pass pipeline
-    runPassPipeline(passPipelineConfig, moduleOp);
+    runPassPipeline(kernelName, passPipelineConfig, moduleOp);
 
     auto entryPointFunc = moduleOp.lookupSymbol<func::FuncOp>(
         std::string("__nvqpp__mlirgen__") + kernelName);
@@ -425,58 +528,71 @@ public:
           [](Attribute attr) { return attr.cast<IntegerAttr>().getInt(); });
     }
 
-    if (executionContext) {
-      if (executionContext->name == "sample")
-        executionContext->reorderIdx = mapping_reorder_idx;
-      else
-        executionContext->reorderIdx.clear();
-    }
-
     std::vector<std::pair<std::string, ModuleOp>> modules;
     // Apply observations if necessary
     if (executionContext && executionContext->name == "observe") {
       mapping_reorder_idx.clear();
-      runPassPipeline("canonicalize,cse", moduleOp);
+      runPassPipeline(kernelName, "canonicalize,cse", moduleOp);
+
+      // The ansatz has been lowered and mapped once above. Every group of
+      // measurement-compatible terms only appends its basis changes and
+      // measurements to a copy of it and runs the cheap basis change pipeline.
+      auto ansatz = moduleOp.lookupSymbol<func::FuncOp>(
+          std::string("__nvqpp__mlirgen__") + kernelName);
+
+      // Results of a shared circuit are split per term by position, which
+      // relies on results being ordered by virtual qubit. Only share circuits
+      // if the qubits have not been remapped.
+      bool shareCircuits = !ansatz->hasAttr("mapping_v2p");
       cudaq::spin_op &spin = *executionContext->spin.value();
-      for (const auto &term : spin) {
-        if (term.is_identity())
-          continue;
-
-        // Get the ansatz
-        auto ansatz = moduleOp.lookupSymbol<func::FuncOp>(
-            std::string("__nvqpp__mlirgen__") + kernelName);
+      auto groups = groupMeasurementCompatibleTerms(spin, shareCircuits);
+      cudaq::info("Observing {} terms with {} circuits.",
+                  spin.num_terms(), groups.size());
 
+      auto basisChangePipeline = getBasisChangePipeline();
+      for (auto &[groupName, basis] : groups) {
         // Create a new Module to clone the ansatz into it
         auto tmpModuleOp = builder.create<ModuleOp>();
         tmpModuleOp.push_back(ansatz.clone());
 
-        // Extract the binary symplectic encoding
-        auto [binarySymplecticForm, coeffs] = term.get_raw_data();
-
         // Create the pass manager, add the quake observe ansatz pass
         // and run it followed by the canonicalizer
         PassManager pm(&context);
         OpPassManager &optPM = pm.nest<func::FuncOp>();
-        optPM.addPass(
-            cudaq::opt::createObserveAnsatzPass(binarySymplecticForm[0]));
+        optPM.addPass(cudaq::opt::createObserveAnsatzPass(basis));
         if (disableMLIRthreading || enablePrintMLIREachPass)
           tmpModuleOp.getContext()->disableMultithreading();
         if (enablePrintMLIREachPass)
           pm.enableIRPrinting();
         if (failed(pm.run(tmpModuleOp)))
           throw std::runtime_error("Could not apply measurements to ansatz.");
-        runPassPipeline(passPipelineConfig, tmpModuleOp);
-        modules.emplace_back(term.to_string(false), tmpModuleOp);
+        runPassPipeline(kernelName, basisChangePipeline, tmpModuleOp);
+        modules.emplace_back(groupName, tmpModuleOp);
       }
     } else
       modules.emplace_back(kernelName, moduleOp);
+    return {modules, mapping_reorder_idx};
+  }
 
+  /// @brief Translate the lowered `modules` to the codegen format of the
+  /// backend, creating their JIT engines if emulating. If `cacheEntry` is
+  /// given, record the lowered modules in it.
+  std::vector<cudaq::KernelExecution>
+  translateModules(std::vector<std::pair<std::string, ModuleOp>> &modules,
+                   const std::vector<std::size_t> &mapping_reorder_idx,
+                   cudaq::CompilationCache::Entry *cacheEntry = nullptr) {
     if (emulate) {
       // If we are in emulation mode, we need to first get a
       // full QIR representation of the code. Then we'll map to
       // an LLVM Module, create a JIT ExecutionEngine pointer
       // and use that for execution
       for (auto &[name, module] : modules) {
+        if (cacheEntry) {
+          std::string moduleStr;
+          llvm::raw_string_ostream os(moduleStr);
+          module.print(os);
+          cacheEntry->modules.push_back(os.str());
+        }
         auto clonedModule = module.clone();
         jitEngines.emplace_back(
             cudaq::createQIRJITEngine(clonedModule, codegenTranslation));
@@ -505,6 +621,313 @@ public:
 
       codes.emplace_back(name, codeStr, j, mapping_reorder_idx);
     }
+    return codes;
+  }
+
+  /// @brief Set the reorder indices of the current execution context.
+  void setReorderIdx(const std::vector<std::size_t> &mapping_reorder_idx) {
+    if (!executionContext)
+      return;
+    if (executionContext->name == "sample")
+      executionContext->reorderIdx = mapping_reorder_idx;
+    else
+      executionContext->reorderIdx.clear();
+  }
+
+  /// @brief Return the placeholder synthesized for the floating-point
+  /// argument value at `index` when lowering a late-bound template. The
+  /// values are exact in single precision. The alternate placeholders have
+  /// the opposite sign and a different magnitude, so that a lowering which
+  /// folds them in a value-dependent way produces different code for the two
+  /// sets.
+  static double getLateBoundPlaceholder(std::size_t index, bool alternate) {
+    double value = 1.14453125 + 0.0078125 * index;
+    return alternate ? -2.0 * value - 0.00390625 : value;
+  }
+
+  /// @brief The maximum number of floating-point argument values that are
+  /// late bound, beyond it the placeholders are no longer exact.
+  static constexpr std::size_t maxLateBoundValues = 1 << 16;
+
+  /// @brief Return true if `value` is one of the first `numValues`
+  /// placeholders.
+  static bool isLateBoundPlaceholder(double value, std::size_t numValues) {
+    double index = (value - getLateBoundPlaceholder(0, false)) /
+                   (getLateBoundPlaceholder(1, false) -
+                    getLateBoundPlaceholder(0, false));
+    return index >= 0 && index < numValues && index == std::floor(index) &&
+           getLateBoundPlaceholder(index, false) == value;
+  }
+
+  /// @brief Return true if every floating-point value in the synthesized
+  /// `moduleOp` only flows into gate parameters, memory or arithmetic that is
+  /// linear in it. Comparisons, conversions to integers, calls and math
+  /// functions may make the lowered code depend on the argument values.
+  /// `numValues` is the number of placeholders synthesized into `moduleOp`.
+  static bool hasLateBindableArguments(ModuleOp moduleOp,
+                                       std::size_t numValues) {
+    auto result = moduleOp.walk([&](Operation *op) {
+      if (isa<func::CallOp, func::CallIndirectOp, cudaq::cc::CallCallableOp>(
+              op))
+        return WalkResult::interrupt();
+      if (llvm::none_of(op->getOperandTypes(),
+                        [](Type ty) { return isa<FloatType>(ty); }))
+        return WalkResult::advance();
+      if (isa_and_nonnull<quake::QuakeDialect>(op->getDialect()) ||
+          isa<arith::AddFOp, arith::SubFOp, arith::MulFOp, arith::NegFOp,
+              arith::ExtFOp, arith::TruncFOp, cudaq::cc::StoreOp>(op))
+        return WalkResult::advance();
+      // A division is only linear in its numerator, so the denominator must be
+      // a constant that is not an argument value.
+      if (auto div = dyn_cast<arith::DivFOp>(op))
+        if (auto constant = div.getRhs().getDefiningOp<arith::ConstantOp>())
+          if (auto value = dyn_cast<FloatAttr>(constant.getValue()))
+            if (!isLateBoundPlaceholder(value.getValueAsDouble(), numValues))
+              return WalkResult::advance();
+      if (auto cast = dyn_cast<cudaq::cc::CastOp>(op))
+        if (isa<FloatType>(cast.getType()))
+          return WalkResult::advance();
+      return WalkResult::interrupt();
+    });
+    return !result.wasInterrupted();
+  }
+
+  /// @brief Replace every floating-point attribute in `op` whose value is a
+  /// key of `bindings`, directly or as an array element, by the mapped value.
+  static void bindFloatConstants(Operation *op,
+                                 const std::map<double, double> &bindings) {
+    auto bind = [&](Attribute attr) -> Attribute {
+      auto floatAttr = dyn_cast<FloatAttr>(attr);
+      if (!floatAttr)
+        return {};
+      auto iter = bindings.find(floatAttr.getValueAsDouble());
+      if (iter == bindings.end())
+        return {};
+      return FloatAttr::get(floatAttr.getType(), iter->second);
+    };
+    op->walk([&](Operation *nested) {
+      SmallVector<NamedAttribute> updates;
+      for (auto namedAttr : nested->getAttrs()) {
+        if (auto bound = bind(namedAttr.getValue())) {
+          updates.emplace_back(namedAttr.getName(), bound);
+          continue;
+        }
+        auto arrayAttr = dyn_cast<ArrayAttr>(namedAttr.getValue());
+        if (!arrayAttr)
+          continue;
+        SmallVector<Attribute> elements(arrayAttr.begin(), arrayAttr.end());
+        bool changed = false;
+        for (auto &element : elements)
+          if (auto bound = bind(element)) {
+            element = bound;
+            changed = true;
+          }
+        if (changed)
+          updates.emplace_back(namedAttr.getName(),
+                               ArrayAttr::get(nested->getContext(), elements));
+      }
+      for (auto &update : updates)
+        nested->setAttr(update.getName(), update.getValue());
+    });
+  }
+
+  /// @brief The lowering of a kernel with placeholders synthesized for its
+  /// floating-point argument values.
+  struct LateBoundTemplate {
+    /// @brief False if the lowering depends on the argument values.
+    bool valid = false;
+    /// @brief The names and printed lowered modules, to translate.
+    std::vector<std::pair<std::string, std::string>> modules;
+    std::vector<std::size_t> mappingReorderIdx;
+  };
+
+  /// @brief Flag indicating whether floating-point kernel arguments are bound
+  /// late. Enabled by setting `CUDAQ_LATE_BIND_PARAMETERS`.
+  bool lateBindParameters = false;
+
+  /// @brief The maximum number of late-bound templates kept in memory.
+  static constexpr std::size_t maxLateBoundTemplates = 64;
+
+  /// @brief The late-bound templates by the compilation cache key of the
+  /// kernel synthesized with placeholders, least recently used ones are
+  /// evicted beyond `maxLateBoundTemplates`.
+  cudaq::LRUCache<std::string, LateBoundTemplate> lateBoundTemplates{
+      maxLateBoundTemplates};
+
+  /// @brief Lower the kernel in the unsynthesized `moduleOp` with its
+  /// floating-point arguments bound late. The kernel is lowered once with
+  /// placeholders for these values and the result is kept as a template.
+  /// Every call then only substitutes its values for the placeholders in
+  /// the lowered template and translates it. Return nothing if the kernel has
+  /// no floating-point arguments or its lowering depends on their values.
+  std::optional<std::vector<cudaq::KernelExecution>>
+  lowerLateBound(const std::string &kernelName, ModuleOp moduleOp,
+                 void *args) {
+    std::vector<double> values;
+    auto synthesized = moduleOp.clone();
+    synthesizeArguments(kernelName, synthesized, args, [&](double value) {
+      values.push_back(value);
+      return getLateBoundPlaceholder(values.size() - 1, false);
+    });
+    if (values.empty() || values.size() > maxLateBoundValues ||
+        !hasLateBindableArguments(synthesized, values.size())) {
+      synthesized.erase();
+      return std::nullopt;
+    }
+
+    auto key = getCompilationCacheKey(synthesized);
+    LateBoundTemplate lateBound;
+    if (auto cached = lateBoundTemplates.lookup(key)) {
+      lateBound = *cached;
+    } else {
+      // Lower the kernel with both sets of placeholders. The template is only
+      // valid if binding the alternate placeholders in the first lowering
+      // reproduces the second one exactly.
+      cudaq::info("Creating late-bound template for {}.", kernelName);
+      auto [modules, reorderIdx] =
+          lowerSynthesizedModule(kernelName, synthesized);
+      auto alternate = moduleOp.clone();
+      std::size_t count = 0;
+      synthesizeArguments(kernelName, alternate, args, [&](double) {
+        return getLateBoundPlaceholder(count++, true);
+      });
+      auto [altModules, altReorderIdx] =
+          lowerSynthesizedModule(kernelName, alternate);
+
+      std::map<double, double> alternates;
+      for (std::size_t i = 0; i < values.size(); i++)
+        alternates[getLateBoundPlaceholder(i, false)] =
+            getLateBoundPlaceholder(i, true);
+      auto print = [](ModuleOp module) {
+        std::string moduleStr;
+        llvm::raw_string_ostream os(moduleStr);
+        module.print(os);
+        return os.str();
+      };
+      lateBound.valid = modules.size() == altModules.size() &&
+                        reorderIdx == altReorderIdx;
+      lateBound.mappingReorderIdx = reorderIdx;
+      for (std::size_t i = 0; lateBound.valid && i < modules.size(); i++) {
+        auto moduleStr = print(modules[i].second);
+        auto bound = modules[i].second.clone();
+        bindFloatConstants(bound, alternates);
+        lateBound.valid = modules[i].first == altModules[i].first &&
+                          print(bound) == print(altModules[i].second);
+        bound.erase();
+        lateBound.modules.emplace_back(modules[i].first, moduleStr);
+      }
+      if (!lateBound.valid) {
+        cudaq::info("The lowering of {} depends on its argument values, "
+                    "not binding them late.",
+                    kernelName);
+        lateBound.modules.clear();
+      }
+      for (auto &[name, module] : modules)
+        if (module != synthesized)
+          module.erase();
+      for (auto &[name, module] : altModules)
+        if (module != alternate)
+          module.erase();
+      alternate.erase();
+      lateBoundTemplates.insert(key, lateBound);
+    }
+    synthesized.erase();
+    if (!lateBound.valid)
+      return std::nullopt;
+
+    std::map<double, double> bindings;
+    for (std::size_t i = 0; i < values.size(); i++)
+      bindings[getLateBoundPlaceholder(i, false)] = values[i];
+    std::vector<std::pair<std::string, ModuleOp>> modules;
+    for (auto &[name, moduleStr] : lateBound.modules) {
+      auto parsed =
+          parseSourceString<ModuleOp>(moduleStr, moduleOp.getContext());
+      if (!parsed)
+        throw std::runtime_error("Could not parse late-bound Quake code for " +
+                                 kernelName + ".");
+      auto module = parsed.release();
+      bindFloatConstants(module, bindings);
+      modules.emplace_back(name, module);
+    }
+    setReorderIdx(lateBound.mappingReorderIdx);
+    auto codes = translateModules(modules, lateBound.mappingReorderIdx);
+    for (auto &[name, module] : modules)
+      module.erase();
+    return codes;
+  }
+
+  /// @brief Extract the Quake representation for the given kernel name and
+  /// lower it to the code format required for the specific backend. The
+  /// lowering process is controllable via the configuration file in the
+  /// platform directory for the targeted backend.
+  std::vector<cudaq::KernelExecution>
+  lowerQuakeCode(const std::string &kernelName, void *kernelArgs) {
+
+    auto [m_module, contextPtr, updatedArgs] =
+        extractQuakeCodeAndContext(kernelName, kernelArgs);
+
+    MLIRContext &context = *contextPtr;
+
+    // Extract the kernel name
+    auto func = m_module.lookupSymbol<mlir::func::FuncOp>(
+        std::string("__nvqpp__mlirgen__") + kernelName);
+
+    // Create a new Module to clone the function into
+    auto location = FileLineColLoc::get(&context, "<builder>", 1, 1);
+    ImplicitLocOpBuilder builder(location, &context);
+
+    // FIXME this should be added to the builder.
+    if (!func->hasAttr(cudaq::entryPointAttrName))
+      func->setAttr(cudaq::entryPointAttrName, builder.getUnitAttr());
+    auto moduleOp = builder.create<ModuleOp>();
+    moduleOp.push_back(func.clone());
+    moduleOp->setAttrs(m_module->getAttrDictionary());
+
+    if (updatedArgs && lateBindParameters)
+      if (auto codes = lowerLateBound(kernelName, moduleOp, updatedArgs)) {
+        cleanupContext(contextPtr);
+        return *codes;
+      }
+
+    if (updatedArgs)
+      synthesizeArguments(kernelName, moduleOp, updatedArgs);
+
+    // Everything below only depends on the synthesized module and the target
+    // configuration, look up its result in the compilation cache.
+    std::string cacheKey;
+    if (compilationCache) {
+      cacheKey = getCompilationCacheKey(moduleOp);
+      if (auto entry = compilationCache->lookup(cacheKey)) {
+        setReorderIdx(entry->codes.empty()
+                          ? std::vector<std::size_t>{}
+                          : entry->codes.front().mapping_reorder_idx);
+        if (emulate)
+          for (auto &moduleStr : entry->modules) {
+            auto parsed = parseSourceString<ModuleOp>(moduleStr, &context);
+            if (!parsed)
+              throw std::runtime_error(
+                  "Could not parse cached Quake code for " + kernelName + ".");
+            auto cachedModule = parsed.release();
+            jitEngines.emplace_back(
+                cudaq::createQIRJITEngine(cachedModule, codegenTranslation));
+          }
+        cleanupContext(contextPtr);
+        return entry->codes;
+      }
+    }
+
+    auto [modules, mapping_reorder_idx] =
+        lowerSynthesizedModule(kernelName, moduleOp);
+    setReorderIdx(mapping_reorder_idx);
+
+    cudaq::CompilationCache::Entry cacheEntry;
+    auto codes = translateModules(modules, mapping_reorder_idx,
+                                  compilationCache ? &cacheEntry : nullptr);
+
+    if (compilationCache) {
+      cacheEntry.codes = codes;
+      compilationCache->store(cacheKey, cacheEntry);
+    }
 
     cleanupContext(contextPtr);
     return codes;
@@ -595,7 +1018,12 @@ public:
 
               // If there are multiple codes, this is likely a spin_op.
               // If so, use the code name instead of the global register.
-              if (codes.size() > 1) {
+              if (cudaq::details::isGroupedTermsName(codes[i].name)) {
+                auto termResults = cudaq::details::splitGroupedTermResults(
+                    codes[i].name, context.result);
+                results.insert(results.end(), termResults.begin(),
+                               termResults.end());
+              } else if (codes.size() > 1) {
                 results.emplace_back(context.result.to_map(), codes[i].name);
                 results.back().sequentialData =
                     context.result.sequential_data();
@@ -40,13 +40,16 @@
 #include "common/RemoteKernelExecutor.h"
 #include "common/RestClient.h"
 #include "common/UnzipUtils.h"
+#include "common/WireFormat.h"
 #include "cudaq.h"
 
+#include <atomic>
 #include <dlfcn.h>
 #include <fstream>
 #include <iostream>
 #include <limits>
 #include <streambuf>
+#include <thread>
 
 namespace {
 /// Util class to execute a functor when an object of this class goes
@@ -101,6 +104,29 @@ protected:
   static inline const std::vector<std::string> serverPasses = {};
   // Random number generator.
   std::mt19937 randEngine{std::random_device{}()};
+  // Whether to send requests in the compact binary wire format. Enabled once
+  // the server has replied in that format, i.e., it supports it. Setting
+  // `CUDAQ_REMOTE_WIRE_FORMAT=json` forces JSON messages, e.g., for debugging.
+  std::atomic<bool> m_sendBinaryRequests = false;
+  const bool m_acceptBinaryResponses = []() {
+    const char *wireFormat = std::getenv("CUDAQ_REMOTE_WIRE_FORMAT");
+    return !wireFormat || std::string_view(wireFormat) != "json";
+  }();
+
+  // Return the request in a form suitable for the binary wire format, i.e.,
+  // with the IR and the arguments as raw bytes.
+  static json toBinaryRequest(const cudaq::RestRequest &request) {
+    json requestJson = request;
+    std::vector<char> codeBytes;
+    if (auto err = llvm::decodeBase64(request.code, codeBytes)) {
+      LLVMConsumeError(llvm::wrap(std::move(err)));
+      return requestJson;
+    }
+    requestJson["code"] = json::binary(
+        std::vector<std::uint8_t>(codeBytes.begin(), codeBytes.end()));
+    requestJson["args"] = json::binary(request.args);
+    return requestJson;
+  }
 
 public:
   virtual void setConfig(
@@ -279,11 +305,39 @@ public:
     //  Ref: https://gms.tf/when-curl-sends-100-continue.html
     std::map<std::string, std::string> headers{
         {"Expect:", ""}, {"Content-type", "application/json"}};
-    json requestJson = request;
+    if (m_acceptBinaryResponses)
+      headers["Accept"] =
+          std::string(cudaq::wire::CONTENT_TYPE) + ", application/json";
+    const bool sendBinary = m_acceptBinaryResponses && m_sendBinaryRequests;
+    json requestJson = sendBinary ? toBinaryRequest(request) : json(request);
     try {
       cudaq::RestClient restClient;
-      auto resultJs =
-          restClient.post(m_url, "job", requestJson, headers, false);
+      // A server running with a worker pool rejects requests with 503 Service
+      // Unavailable while its request queue is full. Retry after the delay it
+      // asks for.
+      constexpr std::size_t maxBusyRetries = 60;
+      json resultJs;
+      for (std::size_t attempt = 0;; ++attempt) {
+        try {
+          resultJs = sendBinary ? restClient.postBinary(m_url, "job",
+                                                        requestJson, headers)
+                                : restClient.post(m_url, "job", requestJson,
+                                                  headers, false);
+          break;
+        } catch (std::exception &e) {
+          if (restClient.getLastStatusCode() != 503 ||
+              attempt == maxBusyRetries)
+            throw;
+          auto delay = restClient.getRetryAfter().value_or(
+              std::chrono::milliseconds(1000));
+          cudaq::info("Remote server is busy, retrying in {} ms.",
+                      delay.count());
+          std::this_thread::sleep_for(delay);
+        }
+      }
+      // A server that replies in the binary format also accepts it.
+      if (cudaq::wire::isBinaryContentType(restClient.getLastContentType()))
+        m_sendBinaryRequests = true;
 
       if (!resultJs.contains("executionContext")) {
         std::stringstream errorMsg;
@@ -0,0 +1,172 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CompilationCache.h"
+#include "Logger.h"
+#include <algorithm>
+#include <fstream>
+#include <random>
+
+namespace cudaq {
+/// The version of the entry format, bump when it changes.
+static constexpr int cacheFormatVersion = 1;
+
+/// The default size limit of the cache, in MB.
+static constexpr std::size_t defaultCacheSizeMB = 1024;
+
+CompilationCache::CompilationCache(const std::filesystem::path &dir,
+                                   std::size_t maxSize)
+    : directory(dir), maxSizeInBytes(maxSize) {
+  std::error_code ec;
+  std::filesystem::create_directories(directory, ec);
+  if (ec)
+    throw std::runtime_error("Could not create the compilation cache "
+                             "directory " +
+                             directory.string() + ": " + ec.message());
+}
+
+std::unique_ptr<CompilationCache> CompilationCache::createFromEnvironment() {
+  auto *dir = std::getenv("CUDAQ_COMPILATION_CACHE_DIR");
+  if (!dir || std::string(dir).empty())
+    return nullptr;
+
+  std::size_t sizeMB = defaultCacheSizeMB;
+  if (auto *size = std::getenv("CUDAQ_COMPILATION_CACHE_SIZE_MB")) {
+    try {
+      sizeMB = std::stoull(size);
+    } catch (std::exception &) {
+      throw std::runtime_error(
+          "Invalid CUDAQ_COMPILATION_CACHE_SIZE_MB value: " +
+          std::string(size));
+    }
+  }
+
+  cudaq::info("Using compilation cache at {} (limit {} MB).", dir, sizeMB);
+  return std::make_unique<CompilationCache>(dir, sizeMB * 1024 * 1024);
+}
+
+std::filesystem::path
+CompilationCache::getEntryPath(const std::string &key) const {
+  return directory / (key + ".json");
+}
+
+std::optional<CompilationCache::Entry>
+CompilationCache::lookup(const std::string &key) {
+  auto path = getEntryPath(key);
+  std::ifstream in(path);
+  std::optional<Entry> entry;
+  if (in.good()) {
+    try {
+      nlohmann::json j;
+      in >> j;
+      if (j.value("version", 0) == cacheFormatVersion) {
+        Entry parsed;
+        for (auto &code : j.at("codes")) {
+          auto name = code.at("name").get<std::string>();
+          auto codeStr = code.at("code").get<std::string>();
+          auto outputNames = code.at("output_names");
+          auto reorderIdx =
+              code.at("mapping_reorder_idx").get<std::vector<std::size_t>>();
+          parsed.codes.emplace_back(name, codeStr, outputNames, reorderIdx);
+        }
+        parsed.modules = j.at("modules").get<std::vector<std::string>>();
+        entry = std::move(parsed);
+      }
+    } catch (std::exception &) {
+      // A corrupted entry, or one with missing or mistyped fields, is a miss.
+      // It will be overwritten.
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    entry ? hits++ : misses++;
+  }
+  if (!entry) {
+    cudaq::info("Compilation cache miss for {}.", key);
+    return std::nullopt;
+  }
+  cudaq::info("Compilation cache hit for {}.", key);
+
+  // Mark the entry as recently used.
+  std::error_code ec;
+  std::filesystem::last_write_time(
+      path, std::filesystem::file_time_type::clock::now(), ec);
+  return entry;
+}
+
+void CompilationCache::store(const std::string &key, const Entry &entry) {
+  nlohmann::json j;
+  j["version"] = cacheFormatVersion;
+  j["codes"] = nlohmann::json::array();
+  for (auto &code : entry.codes)
+    j["codes"].push_back({{"name", code.name},
+                          {"code", code.code},
+                          {"output_names", code.output_names},
+                          {"mapping_reorder_idx", code.mapping_reorder_idx}});
+  j["modules"] = entry.modules;
+
+  // Write to a unique temporary file first and rename it, so that concurrent
+  // processes never observe a partially written entry.
+  auto path = getEntryPath(key);
+  auto tmpPath = path;
+  tmpPath += "." + std::to_string(std::random_device{}()) + ".tmp";
+  {
+    std::ofstream out(tmpPath);
+    if (!out.good()) {
+      cudaq::info("Could not write compilation cache entry {}.",
+                  tmpPath.string());
+      return;
+    }
+    out << j.dump();
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, path, ec);
+  if (ec) {
+    std::filesystem::remove(tmpPath, ec);
+    return;
+  }
+
+  evict();
+}
+
+void CompilationCache::evict() {
+  std::lock_guard<std::mutex> lock(mutex);
+
+  struct CachedFile {
+    std::filesystem::path path;
+    std::filesystem::file_time_type lastUsed;
+    std::uintmax_t size;
+  };
+  std::vector<CachedFile> files;
+  std::uintmax_t totalSize = 0;
+  std::error_code ec;
+  for (auto &file : std::filesystem::directory_iterator(directory, ec)) {
+    if (file.path().extension() != ".json")
+      continue;
+    auto size = file.file_size(ec);
+    if (ec)
+      continue;
+    files.push_back({file.path(), file.last_write_time(ec), size});
+    totalSize += size;
+  }
+  if (totalSize <= maxSizeInBytes)
+    return;
+
+  std::sort(files.begin(), files.end(), [](auto &a, auto &b) {
+    return a.lastUsed < b.lastUsed;
+  });
+  for (auto &file : files) {
+    if (totalSize <= maxSizeInBytes)
+      break;
+    cudaq::info("Evicting compilation cache entry {}.", file.path.string());
+    if (std::filesystem::remove(file.path, ec))
+      totalSize -= file.size;
+  }
+}
+} // namespace cudaq
@@ -0,0 +1,81 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "common/ServerHelper.h"
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace cudaq {
+
+/// @brief The CompilationCache persists the lowered codes of kernel launches
+/// on disk, so that identical launches, also across processes, skip
+/// compilation. Entries are content addressed, i.e. the caller provides a key
+/// that is a hash of everything the compilation depends on. Least recently
+/// used entries are evicted once the cache exceeds its size limit.
+class CompilationCache {
+public:
+  /// @brief A cached compilation result.
+  struct Entry {
+    /// The codes to submit, e.g. QIR, OpenQASM or IQM payloads.
+    std::vector<KernelExecution> codes;
+    /// The lowered Quake modules of the codes, only stored for targets that
+    /// are emulated locally and need to JIT compile them.
+    std::vector<std::string> modules;
+  };
+
+  /// @brief The constructor, entries are stored in the given directory, which
+  /// is created if needed.
+  CompilationCache(const std::filesystem::path &directory,
+                   std::size_t maxSizeInBytes);
+
+  /// @brief Create the cache configured by the `CUDAQ_COMPILATION_CACHE_DIR`
+  /// and `CUDAQ_COMPILATION_CACHE_SIZE_MB` environment variables. Return null
+  /// if no cache directory is set.
+  static std::unique_ptr<CompilationCache> createFromEnvironment();
+
+  /// @brief Return the entry stored for the given key, if any.
+  std::optional<Entry> lookup(const std::string &key);
+
+  /// @brief Store the entry for the given key, evicting the least recently
+  /// used entries if the cache grows beyond its size limit.
+  void store(const std::string &key, const Entry &entry);
+
+  /// @brief Return the number of lookups that found an entry.
+  std::size_t getHits() const { return hits; }
+
+  /// @brief Return the number of lookups that found no entry.
+  std::size_t getMisses() const { return misses; }
+
+protected:
+  /// @brief The directory holding the cache entries.
+  std::filesystem::path directory;
+
+  /// @brief The maximum total size of the cache entries.
+  std::size_t maxSizeInBytes;
+
+  /// @brief Lookup statistics.
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+
+  /// @brief Guards the statistics and eviction.
+  std::mutex mutex;
+
+  /// @brief Return the file holding the entry for the given key.
+  std::filesystem::path getEntryPath(const std::string &key) const;
+
+  /// @brief Remove the least recently used entries until the cache fits in
+  /// its size limit.
+  void evict();
+};
+} // namespace cudaq
@@ -8,8 +8,78 @@
 
 #include "Executor.h"
 #include "common/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <future>
 
 namespace cudaq {
+using Clock = std::chrono::steady_clock;
+
+static std::chrono::microseconds elapsedSince(Clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                               start);
+}
+
+std::vector<ServerMessage>
+Executor::postJobs(const std::string &jobPostPath, RestHeaders &headers,
+                   std::vector<ServerMessage> &jobs,
+                   std::vector<KernelExecution> &codesToExecute) {
+  std::vector<ServerMessage> responses(jobs.size());
+  std::vector<std::chrono::microseconds> latencies(jobs.size());
+
+  // Every worker posts with its own client, taking the next job that has not
+  // been posted yet.
+  std::atomic<std::size_t> nextJob = 0;
+  auto postWorker = [&](RestClient &restClient) {
+    auto workerHeaders = headers;
+    for (std::size_t i = nextJob++; i < jobs.size(); i = nextJob++) {
+      cudaq::info("Job (name={}) created, posting to {}",
+                  codesToExecute[i].name, jobPostPath);
+
+      // Post it, get the response
+      auto start = Clock::now();
+      responses[i] = restClient.post(jobPostPath, "", jobs[i], workerHeaders);
+      latencies[i] = elapsedSince(start);
+      cudaq::info("Job (name={}) posted in {} us, response was {}",
+                  codesToExecute[i].name, latencies[i].count(),
+                  responses[i].dump());
+    }
+  };
+
+  auto numWorkers = std::min(jobs.size(), maxConcurrentSubmissions);
+  while (submissionClients.size() + 1 < numWorkers)
+    submissionClients.emplace_back(std::make_unique<RestClient>());
+
+  std::vector<std::future<void>> workers;
+  for (std::size_t w = 1; w < numWorkers; w++)
+    workers.emplace_back(std::async(std::launch::async, postWorker,
+                                    std::ref(*submissionClients[w - 1])));
+
+  // Post on this thread as well, and only rethrow errors once all workers
+  // are done since they reference local state.
+  std::exception_ptr error;
+  try {
+    postWorker(client);
+  } catch (...) {
+    error = std::current_exception();
+  }
+  for (auto &worker : workers) {
+    try {
+      worker.get();
+    } catch (...) {
+      if (!error)
+        error = std::current_exception();
+    }
+  }
+  if (error)
+    std::rethrow_exception(error);
+
+  for (auto latency : latencies)
+    submissionStatistics.maxRequestLatency =
+        std::max(submissionStatistics.maxRequestLatency, latency);
+  return responses;
+}
+
 details::future
 Executor::execute(std::vector<KernelExecution> &codesToExecute) {
 
@@ -24,22 +94,51 @@ Executor::execute(std::vector<KernelExecution> &codesToExecute) {
 
   auto config = serverHelper->getConfig();
 
-  std::vector<details::future::Job> ids;
-  for (std::size_t i = 0; auto &job : jobs) {
-    cudaq::info("Job (name={}) created, posting to {}", codesToExecute[i].name,
-                jobPostPath);
+  submissionStatistics = SubmissionStatistics();
+  submissionStatistics.numJobs = jobs.size();
+  auto submissionStart = Clock::now();
 
-    // Post it, get the response
-    auto response = client.post(jobPostPath, "", job, headers);
-    cudaq::info("Job (name={}) posted, response was {}", codesToExecute[i].name,
-                response.dump());
+  // Prefer a single request to the batch endpoint of the provider, if any.
+  std::vector<std::string> batchIds;
+  if (jobs.size() > 1) {
+    if (auto batch = serverHelper->createBatchJob(jobPostPath, jobs)) {
+      auto &[batchPostPath, batchJob] = *batch;
+      cudaq::info("Posting batch of {} jobs to {}", jobs.size(), batchPostPath);
+      auto response = client.post(batchPostPath, "", batchJob, headers);
+      cudaq::info("Batch posted, response was {}", response.dump());
+      batchIds = serverHelper->extractBatchJobIds(response);
+      if (batchIds.size() != jobs.size())
+        throw std::runtime_error(
+            "Invalid batch submission response, expected " +
+            std::to_string(jobs.size()) + " job ids but got " +
+            std::to_string(batchIds.size()) + ".");
+      submissionStatistics.batched = true;
+      submissionStatistics.maxRequestLatency = elapsedSince(submissionStart);
+    }
+  }
+
+  std::vector<ServerMessage> responses;
+  if (!submissionStatistics.batched)
+    responses = postJobs(jobPostPath, headers, jobs, codesToExecute);
+
+  submissionStatistics.totalLatency = elapsedSince(submissionStart);
+  cudaq::info("Submitted {} jobs in {} us (longest request {} us).",
+              jobs.size(), submissionStatistics.totalLatency.count(),
+              submissionStatistics.maxRequestLatency.count());
 
+  std::vector<details::future::Job> ids;
+  for (std::size_t i = 0; auto &job : jobs) {
     // Add the job id and the job name.
-    auto task_id = serverHelper->extractJobId(response);
-    if (task_id.empty()) {
-      nlohmann::json tmp(job.at("tasks"));
-      serverHelper->constructGetJobPath(tmp[0]);
-      task_id = tmp[0].at("task_id");
+    std::string task_id;
+    if (submissionStatistics.batched) {
+      task_id = batchIds[i];
+    } else {
+      task_id = serverHelper->extractJobId(responses[i]);
+      if (task_id.empty()) {
+        nlohmann::json tmp(job.at("tasks"));
+        serverHelper->constructGetJobPath(tmp[0]);
+        task_id = tmp[0].at("task_id");
+      }
     }
     cudaq::info("Task ID is {}", task_id);
     ids.emplace_back(task_id, codesToExecute[i].name);
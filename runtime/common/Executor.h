@@ -10,6 +10,9 @@
 #include "common/ExecutionContext.h"
 #include "common/RestClient.h"
 #include "common/ServerHelper.h"
+#include <chrono>
+#include <memory>
+#include <vector>
 
 namespace cudaq {
 
@@ -18,10 +21,40 @@ namespace cudaq {
 /// clean abstraction launching a vector of Jobs for sampling and observation
 /// tasks, both synchronously and asynchronously.
 class Executor : public registry::RegisteredType<Executor> {
+public:
+  /// @brief Timing of the last job submission.
+  struct SubmissionStatistics {
+    /// The number of jobs submitted.
+    std::size_t numJobs = 0;
+    /// True if the jobs were submitted in a single batch request.
+    bool batched = false;
+    /// The time from the first request until all jobs were accepted.
+    std::chrono::microseconds totalLatency{0};
+    /// The longest round trip of a single submission request.
+    std::chrono::microseconds maxRequestLatency{0};
+  };
+
 protected:
   /// @brief The REST Client used to interact with the remote system
   RestClient client;
 
+  /// @brief Additional clients used to post jobs concurrently. They are kept
+  /// across executions so that their connections can be reused.
+  std::vector<std::unique_ptr<RestClient>> submissionClients;
+
+  /// @brief The maximum number of jobs posted concurrently.
+  static constexpr std::size_t maxConcurrentSubmissions = 8;
+
+  /// @brief Timing of the last call to `execute`.
+  SubmissionStatistics submissionStatistics;
+
+  /// @brief Post the given jobs concurrently and return the server responses
+  /// in job order.
+  std::vector<ServerMessage>
+  postJobs(const std::string &jobPostPath, RestHeaders &headers,
+           std::vector<ServerMessage> &jobs,
+           std::vector<KernelExecution> &codesToExecute);
+
   /// @brief The ServerHelper, providing system-specific JSON-formatted
   /// job posts and results translation
   ServerHelper *serverHelper;
@@ -42,6 +75,11 @@ public:
   /// @brief Execute the provided quantum codes and return a future object
   /// The caller can make this synchronous by just immediately calling .get().
   details::future execute(std::vector<KernelExecution> &codesToExecute);
+
+  /// @brief Return the timing of the last job submission.
+  SubmissionStatistics getSubmissionStatistics() const {
+    return submissionStatistics;
+  }
 };
 
 } // namespace cudaq
@@ -11,60 +11,325 @@
 #include "ObserveResult.h"
 #include "RestClient.h"
 #include "ServerHelper.h"
+#include "cudaq/utils/cudaq_utils.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <random>
 #include <thread>
 
 namespace cudaq::details {
 
-sample_result future::get() {
-  if (wrapsFutureSampling)
-    return inFuture.get();
+/// Remote jobs are first polled quickly, then with exponentially increasing
+/// and jittered intervals up to the maximum, unless the server suggests an
+/// interval itself.
+static constexpr std::chrono::microseconds initialPollingInterval(100);
+static constexpr std::chrono::microseconds maxPollingInterval(1000000);
 
-#ifdef CUDAQ_RESTCLIENT_AVAILABLE
-  RestClient client;
-  auto serverHelper = registry::get<ServerHelper>(qpuName);
-  serverHelper->initialize(serverConfig);
-  auto headers = serverHelper->getHeaders();
+/// The maximum number of threads polling the jobs of one future.
+static constexpr std::size_t maxPollingThreads = 8;
 
-  std::vector<ExecutionResult> results;
-  for (auto &id : jobs) {
-    cudaq::info("Future retrieving results for {}.", id.first);
+/// The number of consecutive transient HTTP errors (e.g. rate limiting)
+/// tolerated while polling a job before giving up.
+static constexpr std::size_t maxTransientErrors = 10;
 
-    auto jobGetPath = serverHelper->constructGetJobPath(id.first);
+struct future::PollingState {
+  using Clock = std::chrono::steady_clock;
 
-    cudaq::info("Future got job retrieval path as {}.", jobGetPath);
-    auto resultResponse = client.get(jobGetPath, "", headers);
-    while (!serverHelper->jobIsDone(resultResponse)) {
-      std::this_thread::sleep_for(std::chrono::microseconds(100));
-      resultResponse = client.get(jobGetPath, "", headers);
+  /// A pending status request of a job.
+  struct ScheduledPoll {
+    Clock::time_point due;
+    std::size_t job;
+    std::size_t attempt;
+    std::size_t transientErrors;
+    bool operator>(const ScheduledPoll &other) const {
+      return due > other.due;
     }
-    auto c = serverHelper->processResults(resultResponse, id.first);
+  };
+
+  /// The jobs being polled and their result retrieval paths.
+  std::vector<Job> jobs;
+  std::vector<std::string> jobPaths;
 
+  /// The server helper is not assumed to be thread safe, all accesses are
+  /// serialized.
+  std::unique_ptr<ServerHelper> helper;
+  std::mutex helperMutex;
+  RestHeaders headers;
+
+  /// Polling progress, guarded by `mutex`.
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::priority_queue<ScheduledPoll, std::vector<ScheduledPoll>,
+                      std::greater<ScheduledPoll>>
+      schedule;
+  std::vector<std::vector<ExecutionResult>> results;
+  std::vector<bool> done;
+  std::size_t numDone = 0;
+  std::exception_ptr error;
+  bool cancelled = false;
+
+  /// Completion callbacks and the results they have been invoked with so far,
+  /// guarded by `callbackMutex`.
+  std::mutex callbackMutex;
+  std::vector<JobCallback> callbacks;
+  std::vector<std::optional<sample_result>> announced;
+
+  std::vector<std::thread> workers;
+
+  ~PollingState() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      cancelled = true;
+    }
+    cv.notify_all();
+    for (auto &worker : workers)
+      if (worker.joinable())
+        worker.join();
+  }
+
+  /// Return true if all jobs completed or one of them failed. Must be called
+  /// while holding `mutex`.
+  bool finished() const { return numDone == jobs.size() || error; }
+
+  /// Record the results of a completed job and notify the listeners.
+  void complete(std::size_t idx, sample_result &c) {
     // If there are multiple jobs, this is likely a spin_op.
     // If so, use the job name instead of the global register.
-    if (jobs.size() > 1) {
-      results.emplace_back(c.to_map(), id.second);
-      results.back().sequentialData = c.sequential_data();
+    std::vector<ExecutionResult> jobResults;
+    if (isGroupedTermsName(jobs[idx].second)) {
+      jobResults = splitGroupedTermResults(jobs[idx].second, c);
+    } else if (jobs.size() > 1) {
+      jobResults.emplace_back(c.to_map(), jobs[idx].second);
+      jobResults.back().sequentialData = c.sequential_data();
     } else {
       // For each register, add the results into result.
       for (auto &regName : c.register_names()) {
-        results.emplace_back(c.to_map(regName), regName);
-        results.back().sequentialData = c.sequential_data(regName);
+        jobResults.emplace_back(c.to_map(regName), regName);
+        jobResults.back().sequentialData = c.sequential_data(regName);
       }
     }
+
+    // Run the callbacks before marking the job done, so that they have all
+    // returned once `get()` does.
+    {
+      std::lock_guard<std::mutex> lock(callbackMutex);
+      announced[idx] = c;
+      for (auto &callback : callbacks)
+        callback(jobs[idx], c);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      results[idx] = std::move(jobResults);
+      done[idx] = true;
+      numDone++;
+    }
+    cv.notify_all();
   }
 
-  return sample_result(results);
+  /// Record the failure of polling, which stops all workers.
+  void fail(std::exception_ptr e) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!error)
+        error = e;
+    }
+    cv.notify_all();
+  }
+
+#ifdef CUDAQ_RESTCLIENT_AVAILABLE
+  /// Return the delay until the next status request of a job.
+  static std::chrono::microseconds
+  nextInterval(std::size_t attempt, std::chrono::microseconds serverHint,
+               std::optional<std::chrono::milliseconds> retryAfter,
+               std::mt19937 &gen) {
+    if (retryAfter)
+      serverHint = std::max<std::chrono::microseconds>(serverHint, *retryAfter);
+    if (serverHint.count() > 0)
+      return serverHint;
+
+    std::int64_t backoff = initialPollingInterval.count()
+                           << std::min<std::size_t>(attempt, 20);
+    backoff = std::min<std::int64_t>(backoff, maxPollingInterval.count());
+    // Jitter to avoid synchronized requests from many outstanding jobs.
+    std::uniform_int_distribution<std::int64_t> jitter(backoff / 2, backoff);
+    return std::chrono::microseconds(jitter(gen));
+  }
+
+  /// Request the status of a job. Return the delay until the job should be
+  /// polled again, or nothing if it is complete or polling failed.
+  std::optional<std::chrono::microseconds>
+  poll(RestClient &client, RestHeaders &requestHeaders, ScheduledPoll &next,
+       std::mt19937 &gen) {
+    try {
+      auto response = client.get(jobPaths[next.job], "", requestHeaders);
+      std::unique_lock<std::mutex> helperLock(helperMutex);
+      if (!helper->jobIsDone(response)) {
+        auto hint = helper->nextResultPollingInterval(response);
+        helperLock.unlock();
+        next.transientErrors = 0;
+        return nextInterval(next.attempt, hint, client.getRetryAfter(), gen);
+      }
+
+      cudaq::info("Future retrieving results for {}.", jobs[next.job].first);
+      auto c = helper->processResults(response, jobs[next.job].first);
+      helperLock.unlock();
+      complete(next.job, c);
+    } catch (...) {
+      // Rate limiting and temporarily unavailable servers are retried.
+      auto status = client.getLastStatusCode();
+      bool isTransient =
+          status == 429 || status == 502 || status == 503 || status == 504;
+      if (isTransient && ++next.transientErrors <= maxTransientErrors) {
+        cudaq::info("Polling job {} returned status code {}, retrying.",
+                    jobs[next.job].first, status);
+        return nextInterval(next.attempt, std::chrono::microseconds(0),
+                            client.getRetryAfter(), gen);
+      }
+      fail(std::current_exception());
+    }
+    return std::nullopt;
+  }
+
+  /// The worker loop, repeatedly takes the job due the earliest and polls it.
+  void run() {
+    RestClient client;
+    auto requestHeaders = headers;
+    std::mt19937 gen(std::random_device{}());
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!cancelled && !error) {
+      if (schedule.empty()) {
+        // All remaining jobs are being polled by other workers.
+        if (numDone == jobs.size())
+          return;
+        cv.wait(lock);
+        continue;
+      }
+
+      auto next = schedule.top();
+      if (next.due > Clock::now()) {
+        cv.wait_until(lock, next.due);
+        continue;
+      }
+      schedule.pop();
+      lock.unlock();
+
+      auto delay = poll(client, requestHeaders, next, gen);
+
+      lock.lock();
+      if (delay) {
+        next.due = Clock::now() + *delay;
+        next.attempt++;
+        schedule.push(next);
+        cv.notify_one();
+      }
+    }
+  }
+#endif
+};
+
+future::PollingState &future::startPolling() {
+  if (polling)
+    return *polling;
+
+#ifdef CUDAQ_RESTCLIENT_AVAILABLE
+  auto state = std::make_shared<PollingState>();
+  state->jobs = jobs;
+  state->results.resize(jobs.size());
+  state->done.resize(jobs.size(), false);
+  state->announced.resize(jobs.size());
+
+  if (!jobs.empty()) {
+    state->helper = registry::get<ServerHelper>(qpuName);
+    state->helper->initialize(serverConfig);
+    state->headers = state->helper->getHeaders();
+    auto now = PollingState::Clock::now();
+    for (std::size_t i = 0; i < state->jobs.size(); i++) {
+      auto jobGetPath =
+          state->helper->constructGetJobPath(state->jobs[i].first);
+      cudaq::info("Future got job retrieval path as {}.", jobGetPath);
+      state->jobPaths.push_back(jobGetPath);
+      state->schedule.push({now, i, 0, 0});
+    }
+
+    // Poll all outstanding jobs concurrently.
+    auto numWorkers = std::min(jobs.size(), maxPollingThreads);
+    for (std::size_t i = 0; i < numWorkers; i++)
+      state->workers.emplace_back([ptr = state.get()]() { ptr->run(); });
+  }
+
+  polling = state;
+  return *polling;
 #else
   throw std::runtime_error("cudaq::details::future::get() requires REST Client "
                            "but CUDA Quantum was built without it.");
-  return sample_result();
 #endif
 }
 
+bool future::is_ready() {
+  if (wrapsFutureSampling)
+    return inFuture.wait_for(std::chrono::seconds(0)) ==
+           std::future_status::ready;
+
+  auto &state = startPolling();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.finished();
+}
+
+sample_result future::get() {
+  if (wrapsFutureSampling)
+    return inFuture.get();
+
+  auto &state = startPolling();
+  std::unique_lock<std::mutex> lock(state.mutex);
+  state.cv.wait(lock, [&state]() { return state.finished(); });
+  if (state.error)
+    std::rethrow_exception(state.error);
+
+  std::vector<ExecutionResult> results;
+  for (auto &jobResults : state.results)
+    results.insert(results.end(), jobResults.begin(), jobResults.end());
+  return sample_result(results);
+}
+
+sample_result future::get_partial() {
+  if (wrapsFutureSampling)
+    return sample_result();
+
+  auto &state = startPolling();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  if (state.error)
+    std::rethrow_exception(state.error);
+
+  std::vector<ExecutionResult> results;
+  for (std::size_t i = 0; i < state.results.size(); i++)
+    if (state.done[i])
+      results.insert(results.end(), state.results[i].begin(),
+                     state.results[i].end());
+  return sample_result(results);
+}
+
+void future::on_job_completed(JobCallback callback) {
+  if (wrapsFutureSampling)
+    throw std::runtime_error("Job completion callbacks require a cudaq::future "
+                             "for remote jobs.");
+
+  auto &state = startPolling();
+  std::lock_guard<std::mutex> lock(state.callbackMutex);
+  for (std::size_t i = 0; i < state.announced.size(); i++)
+    if (state.announced[i])
+      callback(state.jobs[i], *state.announced[i]);
+  state.callbacks.push_back(std::move(callback));
+}
+
 future &future::operator=(future &other) {
   jobs = other.jobs;
   qpuName = other.qpuName;
   serverConfig = other.serverConfig;
+  polling = std::move(other.polling);
   if (other.wrapsFutureSampling) {
     wrapsFutureSampling = true;
     inFuture = std::move(other.inFuture);
@@ -76,6 +341,7 @@ future &future::operator=(future &&other) {
   jobs = other.jobs;
   qpuName = other.qpuName;
   serverConfig = other.serverConfig;
+  polling = std::move(other.polling);
   if (other.wrapsFutureSampling) {
     wrapsFutureSampling = true;
     inFuture = std::move(other.inFuture);
@@ -83,6 +349,58 @@ future &future::operator=(future &&other) {
   return *this;
 }
 
+bool isGroupedTermsName(const std::string &name) {
+  return name.find(',') != std::string::npos;
+}
+
+std::vector<ExecutionResult> splitGroupedTermResults(const std::string &name,
+                                                     sample_result &counts) {
+  auto terms = cudaq::split(name, ',');
+  auto nQubits = terms.front().size();
+
+  // The position of every measured qubit in the result bit strings.
+  std::vector<std::size_t> position(nQubits, 0);
+  std::size_t numMeasured = 0;
+  for (std::size_t i = 0; i < nQubits; i++) {
+    position[i] = numMeasured;
+    if (std::any_of(terms.begin(), terms.end(),
+                    [i](const std::string &t) { return t[i] != 'I'; }))
+      numMeasured++;
+  }
+
+  auto globalCounts = counts.to_map();
+  auto sequentialData = counts.sequential_data();
+  std::vector<ExecutionResult> results;
+  for (auto &term : terms) {
+    if (term.size() != nQubits)
+      throw std::runtime_error("Invalid grouped spin_op term name " + name);
+    std::vector<std::size_t> bits;
+    for (std::size_t i = 0; i < nQubits; i++)
+      if (term[i] != 'I')
+        bits.push_back(position[i]);
+
+    auto marginal = [&](const std::string &bitString) {
+      if (bitString.size() != numMeasured)
+        throw std::runtime_error(
+            "Results of grouped spin_op terms " + name + " have " +
+            std::to_string(bitString.size()) + " bits, expected " +
+            std::to_string(numMeasured) + ".");
+      std::string result(bits.size(), '0');
+      for (std::size_t k = 0; k < bits.size(); k++)
+        result[k] = bitString[bits[k]];
+      return result;
+    };
+
+    CountsDictionary termCounts;
+    for (auto &[bitString, count] : globalCounts)
+      termCounts[marginal(bitString)] += count;
+    results.emplace_back(termCounts, term);
+    for (auto &shot : sequentialData)
+      results.back().sequentialData.push_back(marginal(shot));
+  }
+  return results;
+}
+
 std::ostream &operator<<(std::ostream &os, future &f) {
   if (f.wrapsFutureSampling)
     throw std::runtime_error(
@@ -13,6 +13,7 @@
 #include <functional>
 #include <future>
 #include <map>
+#include <memory>
 
 namespace cudaq {
 namespace details {
@@ -31,7 +32,19 @@ class future {
 public:
   using Job = std::pair<std::string, std::string>;
 
+  /// @brief Callback invoked with a remote job and its results as soon as
+  /// that job has completed.
+  using JobCallback = std::function<void(const Job &, const sample_result &)>;
+
 protected:
+  /// @brief The state shared with the threads polling the remote jobs,
+  /// created when polling starts.
+  struct PollingState;
+  std::shared_ptr<PollingState> polling;
+
+  /// @brief Start polling all remote jobs concurrently, if not yet started.
+  PollingState &startPolling();
+
   /// @brief Vector of job ids that make up the execution
   /// that this future corresponds to.
   std::vector<Job> jobs;
@@ -74,12 +87,39 @@ public:
 
   sample_result get();
 
+  /// @brief Return the results of the remote jobs that have completed so far,
+  /// in job order, without waiting for the others. Starts polling the remote
+  /// jobs if needed. Futures wrapping a local execution have no partial
+  /// results and return an empty `sample_result`.
+  sample_result get_partial();
+
+  /// @brief Register a callback that is invoked, from a polling thread, for
+  /// every remote job as soon as it completes. It is invoked immediately for
+  /// jobs that have already completed. Starts polling the remote jobs if
+  /// needed. Callbacks are never invoked concurrently.
+  void on_job_completed(JobCallback callback);
+
+  /// @brief Return true if `get()` would not block. For remote jobs, this
+  /// starts polling the server in the background.
+  bool is_ready();
+
   friend std::ostream &operator<<(std::ostream &, future &);
   friend std::istream &operator>>(std::istream &, future &);
 };
 
 std::ostream &operator<<(std::ostream &os, future &f);
 std::istream &operator>>(std::istream &os, future &f);
+
+/// @brief Return true if the job name refers to a group of `spin_op` terms
+/// measured by a single circuit, i.e. a comma-separated list of terms.
+bool isGroupedTermsName(const std::string &name);
+
+/// @brief Split the results of a circuit measuring a group of compatible
+/// `spin_op` terms into one result per term, named by the term. The results
+/// must contain one bit per qubit measured by any of the terms, ordered by
+/// qubit index.
+std::vector<ExecutionResult> splitGroupedTermResults(const std::string &name,
+                                                     sample_result &counts);
 } // namespace details
 
 /// @brief the async_result type is a user facing, future-like
@@ -135,6 +175,16 @@ public:
     return T();
   }
 
+  /// @brief Return true if the data is available without waiting.
+  bool is_ready() { return result.is_ready(); }
+
+  /// @brief Register a callback invoked with each remote job and its
+  /// results as soon as that job completes, e.g. every term of an
+  /// asynchronous observe.
+  void on_job_completed(details::future::JobCallback callback) {
+    result.on_job_completed(std::move(callback));
+  }
+
   template <typename U>
   friend std::ostream &operator<<(std::ostream &, async_result<U> &);
 
@@ -7,6 +7,9 @@
  ******************************************************************************/
 
 #include "JIT.h"
+#include "JITCache.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/ExecutionEngine/JITEventListener.h"
 #include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/ExecutionEngine/Orc/CompileUtils.h"
@@ -18,9 +21,14 @@
 #include "llvm/IR/Module.h"
 #include "llvm/IRReader/IRReader.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Host.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/PrettyStackTrace.h"
+#include "llvm/Support/SHA256.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/ToolOutputFile.h"
@@ -28,13 +36,92 @@
 #include "mlir/ExecutionEngine/ExecutionEngine.h"
 #include <cxxabi.h>
 
+#define DEBUG_TYPE "cudaq-jit"
+
 namespace cudaq {
+std::string PersistentObjectCache::getObjectPath(const llvm::Module *m) const {
+  llvm::SmallString<128> path(directory);
+  llvm::sys::path::append(path, m->getModuleIdentifier() + ".o");
+  return path.str().str();
+}
 
-void invokeWrappedKernel(std::string_view irString,
-                         const std::string &entryPointFn, void *args,
-                         std::uint64_t argsSize, std::size_t numTimes,
-                         std::function<void(std::size_t)> postExecCallback) {
+std::unique_ptr<PersistentObjectCache>
+PersistentObjectCache::createFromEnvironment() {
+  auto *dir = std::getenv("CUDAQ_JIT_OBJECT_CACHE_DIR");
+  return dir && *dir ? std::make_unique<PersistentObjectCache>(dir) : nullptr;
+}
+
+void PersistentObjectCache::notifyObjectCompiled(const llvm::Module *m,
+                                                 llvm::MemoryBufferRef obj) {
+  if (llvm::sys::fs::create_directories(directory))
+    return;
+  // Write to a unique temporary file and rename it, so that concurrent
+  // processes never load a partially written object.
+  auto path = getObjectPath(m);
+  int fd;
+  llvm::SmallString<128> tmpPath;
+  if (llvm::sys::fs::createUniqueFile(llvm::Twine(path) + ".%%%%%%.tmp", fd,
+                                      tmpPath))
+    return;
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    os << obj.getBuffer();
+  }
+  if (llvm::sys::fs::rename(tmpPath, path))
+    llvm::sys::fs::remove(tmpPath);
+}
 
+std::unique_ptr<llvm::MemoryBuffer>
+PersistentObjectCache::getObject(const llvm::Module *m) {
+  auto buffer = llvm::MemoryBuffer::getFile(getObjectPath(m));
+  if (!buffer)
+    return nullptr;
+  LLVM_DEBUG(llvm::dbgs() << "Loaded cached object for "
+                          << m->getModuleIdentifier() << '\n');
+  return std::move(*buffer);
+}
+} // namespace cudaq
+
+namespace {
+/// Return the object cache configured by `CUDAQ_JIT_OBJECT_CACHE_DIR`, or
+/// null if disabled.
+llvm::ObjectCache *getObjectCache() {
+  static auto objectCache =
+      cudaq::PersistentObjectCache::createFromEnvironment();
+  return objectCache.get();
+}
+
+/// A JIT compiled kernel and its wrapper.
+struct WrappedKernel {
+  std::unique_ptr<llvm::orc::LLJIT> jit;
+  void *kernel = nullptr;
+  void (*wrapper)(const void *, unsigned long, void *) = nullptr;
+};
+
+/// The LRU cache of JIT compiled kernels, keyed by the hash of their IR and
+/// entry point.
+using WrappedKernelCache =
+    cudaq::LRUCache<std::string, std::shared_ptr<WrappedKernel>>;
+
+/// Return the hash of everything the compiled kernel depends on.
+std::string getWrappedKernelKey(std::string_view irString,
+                                const std::string &entryPointFn) {
+  llvm::SHA256 hasher;
+  auto update = [&](llvm::StringRef str) {
+    hasher.update(str);
+    hasher.update(llvm::StringRef("\0", 1));
+  };
+  update(LLVM_VERSION_STRING);
+  update(llvm::sys::getProcessTriple());
+  update(llvm::sys::getHostCPUName());
+  update(llvm::StringRef(irString.data(), irString.size()));
+  update(entryPointFn);
+  return llvm::toHex(hasher.final(), /*LowerCase=*/true);
+}
+
+std::shared_ptr<WrappedKernel> jitWrappedKernel(std::string_view irString,
+                                                const std::string &entryPointFn,
+                                                const std::string &key) {
   std::unique_ptr<llvm::LLVMContext> ctx(new llvm::LLVMContext);
   // Parse bitcode
   llvm::SMDiagnostic Err;
@@ -42,6 +129,8 @@ void invokeWrappedKernel(std::string_view irString,
   std::unique_ptr<llvm::Module> llvmModule = llvm::parseIR(*fileBuf, Err, *ctx);
   if (!llvmModule)
     throw "Failed to parse embedded bitcode";
+  // The object cache names objects after the module identifier.
+  llvmModule->setModuleIdentifier(key);
 
   // Retrieve the symbol names for the kernel and its wrapper.
   const std::pair<std::string, std::string> mangledKernelNames = [&]() {
@@ -116,10 +205,22 @@ void invokeWrappedKernel(std::string_view irString,
     return objectLayer;
   };
 
+  // Compile through the persistent object cache, if enabled.
+  auto compileFunctionCreator = [&](llvm::orc::JITTargetMachineBuilder jtmb)
+      -> llvm::Expected<
+          std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>> {
+    auto targetMachine = jtmb.createTargetMachine();
+    if (!targetMachine)
+      return targetMachine.takeError();
+    return std::make_unique<llvm::orc::TMOwningSimpleCompiler>(
+        std::move(*targetMachine), getObjectCache());
+  };
+
   // Create the LLJIT with the object link layer
   auto jit = llvm::cantFail(
       llvm::orc::LLJITBuilder()
           .setObjectLinkingLayerCreator(objectLinkingLayerCreator)
+          .setCompileFunctionCreator(compileFunctionCreator)
           .create());
 
   // Add a ThreadSafemodule to the engine and return.
@@ -133,15 +234,48 @@ void invokeWrappedKernel(std::string_view irString,
           dataLayout.getGlobalPrefix())));
 
   // Symbol lookup: kernel and wrapper
+  auto wrappedKernel = std::make_shared<WrappedKernel>();
   auto kernelSymbolAddr = llvm::cantFail(jit->lookup(mangledKernelNames.first));
-  void *fptr = kernelSymbolAddr.toPtr<void *>();
+  wrappedKernel->kernel = kernelSymbolAddr.toPtr<void *>();
   auto wrapperSymbolAddr =
       llvm::cantFail(jit->lookup(mangledKernelNames.second));
-  auto *fptrWrapper =
+  wrappedKernel->wrapper =
       wrapperSymbolAddr.toPtr<void (*)(const void *, unsigned long, void *)>();
+  wrappedKernel->jit = std::move(jit);
+  return wrappedKernel;
+}
+
+/// Return the cached JIT compiled kernel, compiling it on a miss.
+std::shared_ptr<WrappedKernel>
+getOrCreateWrappedKernel(std::string_view irString,
+                         const std::string &entryPointFn) {
+  // Repeated launches of the same kernel, e.g. in variational loops, reuse the
+  // JIT compiled code. The cache is intentionally leaked, so that the JITs
+  // outlive any static destructors that may still invoke kernels.
+  static auto *cache = new WrappedKernelCache(cudaq::getJITCacheSize());
+  const auto key = getWrappedKernelKey(irString, entryPointFn);
+  if (auto wrappedKernel = cache->lookup(key))
+    return *wrappedKernel;
+  return cache->insert(key, jitWrappedKernel(irString, entryPointFn, key));
+}
+} // namespace
+
+namespace cudaq {
+
+void compileWrappedKernel(std::string_view irString,
+                          const std::string &entryPointFn) {
+  getOrCreateWrappedKernel(irString, entryPointFn);
+}
+
+void invokeWrappedKernel(std::string_view irString,
+                         const std::string &entryPointFn, void *args,
+                         std::uint64_t argsSize, std::size_t numTimes,
+                         std::function<void(std::size_t)> postExecCallback) {
+  auto wrappedKernel = getOrCreateWrappedKernel(irString, entryPointFn);
+
   for (std::size_t i = 0; i < numTimes; ++i) {
     // Invoke the wrapper with serialized data and the kernel.
-    fptrWrapper(args, argsSize, fptr);
+    wrappedKernel->wrapper(args, argsSize, wrappedKernel->kernel);
     if (postExecCallback) {
       postExecCallback(i);
     }
@@ -8,10 +8,25 @@
 #pragma once
 
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <string>
 
 namespace cudaq {
+/// The default number of JIT compiled kernels kept in memory by each JIT cache
+/// of the runtime.
+constexpr std::size_t defaultJITCacheSize = 64;
+
+/// Return the number of JIT compiled kernels kept in memory by each JIT cache
+/// of the runtime, i.e. the kernels of `invokeWrappedKernel`, the MLIR kernels
+/// of the remote QPU server and the Python kernels. It is set by the
+/// `CUDAQ_JIT_CACHE_SIZE` environment variable, 0 disables caching.
+inline std::size_t getJITCacheSize() {
+  if (auto *size = std::getenv("CUDAQ_JIT_CACHE_SIZE"))
+    return std::strtoull(size, nullptr, 10);
+  return defaultJITCacheSize;
+}
+
 /// Util to invoke a wrapped kernel defined by LLVM IR with serialized
 /// arguments.
 // We don't use `mlir::ExecutionEngine` because:
@@ -24,4 +39,11 @@ void invokeWrappedKernel(
     std::string_view llvmIr, const std::string &kernelName, void *args,
     std::uint64_t argsSize, std::size_t numTimes = 1,
     std::function<void(std::size_t)> postExecCallback = {});
+
+/// Util to JIT compile a wrapped kernel without invoking it. JIT compiled
+/// kernels are cached, hence a subsequent `invokeWrappedKernel` with the same
+/// IR and kernel name can skip the compilation. This allows compiling and
+/// executing kernels on different threads.
+void compileWrappedKernel(std::string_view llvmIr,
+                          const std::string &kernelName);
 } // namespace cudaq
@@ -0,0 +1,96 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+#pragma once
+
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace cudaq {
+
+/// @brief A thread-safe least recently used cache, used to keep the JIT
+/// compiled code of recently launched kernels. Values are copied out of the
+/// cache, hence JIT compiled code is held by shared pointers, so that code
+/// evicted while it runs stays alive until it returns.
+template <typename Key, typename Value>
+class LRUCache {
+  using Entry = std::pair<Key, Value>;
+  /// Cached entries, most recently used first.
+  std::list<Entry> entries;
+  std::unordered_map<Key, typename std::list<Entry>::iterator> index;
+  std::size_t capacity;
+  std::mutex mutex;
+
+public:
+  /// @brief The constructor, a capacity of 0 disables caching.
+  explicit LRUCache(std::size_t capacity) : capacity(capacity) {}
+
+  /// @brief Return the value cached for the key, if any, and mark it as the
+  /// most recently used one.
+  std::optional<Value> lookup(const Key &key) {
+    std::scoped_lock<std::mutex> lock(mutex);
+    auto iter = index.find(key);
+    if (iter == index.end())
+      return std::nullopt;
+    entries.splice(entries.begin(), entries, iter->second);
+    return iter->second->second;
+  }
+
+  /// @brief Cache the value for the key, evicting the least recently used
+  /// entry beyond the capacity. If a value is already cached for the key,
+  /// e.g. compiled concurrently by another thread, it is kept and returned.
+  Value insert(const Key &key, Value value) {
+    std::scoped_lock<std::mutex> lock(mutex);
+    auto iter = index.find(key);
+    if (iter != index.end()) {
+      entries.splice(entries.begin(), entries, iter->second);
+      return iter->second->second;
+    }
+    if (capacity == 0)
+      return value;
+    entries.emplace_front(key, std::move(value));
+    index[key] = entries.begin();
+    if (entries.size() > capacity) {
+      index.erase(entries.back().first);
+      entries.pop_back();
+    }
+    return entries.front().second;
+  }
+
+  /// @brief Return the number of cached entries.
+  std::size_t size() {
+    std::scoped_lock<std::mutex> lock(mutex);
+    return entries.size();
+  }
+};
+
+/// @brief An llvm::ObjectCache that persists the objects compiled by the JIT in
+/// a directory, so that they are reused across processes. Objects are named
+/// after the identifier of their module, which is set to the hash of its IR.
+class PersistentObjectCache : public llvm::ObjectCache {
+  std::string directory;
+
+  std::string getObjectPath(const llvm::Module *m) const;
+
+public:
+  PersistentObjectCache(std::string dir) : directory(std::move(dir)) {}
+
+  /// @brief Create the cache configured by the `CUDAQ_JIT_OBJECT_CACHE_DIR`
+  /// environment variable. Return null if it is not set.
+  static std::unique_ptr<PersistentObjectCache> createFromEnvironment();
+
+  void notifyObjectCompiled(const llvm::Module *m,
+                            llvm::MemoryBufferRef obj) override;
+
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *m) override;
+};
+} // namespace cudaq
@@ -9,15 +9,23 @@
 #include "MeasureCounts.h"
 
 #include <algorithm>
+#include <bit>
+#include <cstdlib>
 #include <numeric>
+#include <stdexcept>
 #include <string.h>
 
+#include <cstring>
 #include <iostream>
 #include <map>
 #include <vector>
 
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
 namespace cudaq {
-std::string longToBitString(int size, long x) {
+std::string longToBitString(int size, std::uint64_t x) {
   std::string s(size, '0');
   int counter = 0;
   do {
@@ -28,6 +36,473 @@ std::string longToBitString(int size, long x) {
   return s;
 }
 
+namespace {
+/// @brief Extract the bits of `x` selected by `mask` into the low bits of the
+/// result, keeping their order.
+inline std::uint64_t extractBits(std::uint64_t x, std::uint64_t mask) {
+#if defined(__BMI2__)
+  return _pext_u64(x, mask);
+#else
+  std::uint64_t result = 0;
+  for (std::uint64_t bit = 1; mask; bit <<= 1, mask &= mask - 1)
+    if (x & mask & (~mask + 1))
+      result |= bit;
+  return result;
+#endif
+}
+
+/// @brief Gathers the bits at the given indices of packed bit strings into
+/// packed bit strings such that `newBitStr(:)=oldBitStr(index(:))`. If the
+/// indices are increasing, the bits of every source word are extracted at
+/// once.
+class BitGather {
+  std::size_t numWords;
+  /// @brief Source word and mask of the bits to extract from it, if the
+  /// indices are increasing
+  std::vector<std::pair<std::size_t, std::uint64_t>> masks;
+  std::vector<std::size_t> index;
+
+public:
+  BitGather(const std::vector<std::size_t> &idx, std::size_t numBits)
+      : numWords((idx.size() + 63) / 64), index(idx) {
+    for (auto i : index)
+      if (i >= numBits)
+        throw std::runtime_error("Invalid bit index (" + std::to_string(i) +
+                                 ", size=" + std::to_string(numBits) + ")");
+    if (!std::is_sorted(index.begin(), index.end()) ||
+        std::adjacent_find(index.begin(), index.end()) != index.end())
+      return;
+    for (auto i : index) {
+      if (masks.empty() || masks.back().first != i / 64)
+        masks.emplace_back(i / 64, 0);
+      masks.back().second |= std::uint64_t(1) << (i % 64);
+    }
+  }
+
+  void operator()(const std::uint64_t *src, std::uint64_t *dst) const {
+    std::fill(dst, dst + numWords, 0);
+    if (masks.empty()) {
+      for (std::size_t i = 0; i < index.size(); i++)
+        dst[i / 64] |= ((src[index[i] / 64] >> (index[i] % 64)) & 1)
+                       << (i % 64);
+      return;
+    }
+    std::size_t pos = 0;
+    for (auto [word, mask] : masks) {
+      auto bits = extractBits(src[word], mask);
+      auto offset = pos % 64;
+      dst[pos / 64] |= bits << offset;
+      auto numExtracted = static_cast<std::size_t>(std::popcount(mask));
+      if (offset + numExtracted > 64)
+        dst[pos / 64 + 1] |= bits >> (64 - offset);
+      pos += numExtracted;
+    }
+  }
+};
+
+/// @brief The version of the binary encoding of `ExecutionResult`
+constexpr std::uint8_t encodingVersion = 1;
+
+/// @brief Flags of an encoded `ExecutionResult`
+enum EncodingFlags : std::uint8_t {
+  HasExpectation = 1,
+  HasSequentialData = 2,
+  HasStringKeys = 4,
+};
+
+void writeVarint(std::ostream &os, std::uint64_t value) {
+  char bytes[10];
+  std::size_t n = 0;
+  do {
+    bytes[n] = static_cast<char>(value & 0x7f);
+    value >>= 7;
+    if (value)
+      bytes[n] |= static_cast<char>(0x80);
+    n++;
+  } while (value);
+  os.write(bytes, n);
+}
+
+std::uint64_t readVarint(std::istream &is) {
+  std::uint64_t value = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    auto byte = is.get();
+    if (byte == std::char_traits<char>::eof())
+      throw std::runtime_error("Unexpected end of encoded sample result.");
+    value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return value;
+  }
+  throw std::runtime_error("Invalid integer in encoded sample result.");
+}
+
+void writeString(std::ostream &os, std::string_view str) {
+  writeVarint(os, str.size());
+  os.write(str.data(), str.size());
+}
+
+void readBytes(std::istream &is, char *data, std::size_t size) {
+  if (!is.read(data, size))
+    throw std::runtime_error("Unexpected end of encoded sample result.");
+}
+
+std::string readString(std::istream &is) {
+  auto size = readVarint(is);
+  std::string str;
+  // Grow the string while reading, a corrupt size must not allocate at once.
+  constexpr std::size_t chunk = 1 << 16;
+  while (str.size() < size) {
+    auto n = std::min<std::size_t>(chunk, size - str.size());
+    auto offset = str.size();
+    str.resize(offset + n);
+    readBytes(is, str.data() + offset, n);
+  }
+  return str;
+}
+
+/// @brief Read the length of the packed bit strings.
+std::uint64_t readNumBits(std::istream &is) {
+  auto numBits = readVarint(is);
+  if (numBits > (std::uint64_t(1) << 32))
+    throw std::runtime_error("Invalid bit string length (" +
+                             std::to_string(numBits) +
+                             ") in encoded sample result.");
+  return numBits;
+}
+
+/// @brief Return true if all bit strings in `counts` are of '0's and '1's
+/// and of the same length.
+bool isPackable(const CountsDictionary &counts) {
+  if (counts.empty())
+    return true;
+  auto numBits = counts.begin()->first.size();
+  return std::all_of(counts.begin(), counts.end(), [&](const auto &entry) {
+    return entry.first.size() == numBits &&
+           std::all_of(entry.first.begin(), entry.first.end(),
+                       [](char c) { return c == '0' || c == '1'; });
+  });
+}
+} // namespace
+
+SequentialData::SequentialData(const std::vector<std::string> &bitStrings) {
+  for (auto &bitString : bitStrings)
+    append(bitString, 1);
+}
+
+void SequentialData::unpack() {
+  strings = str();
+  words.clear();
+  words.shrink_to_fit();
+  numBits = 0;
+  unpacked = true;
+}
+
+void SequentialData::append(std::string_view bitString, std::size_t count) {
+  if (count == 0)
+    return;
+  if (!unpacked) {
+    bool isBinary = std::all_of(bitString.begin(), bitString.end(),
+                                [](char c) { return c == '0' || c == '1'; });
+    if (numShots == 0 && isBinary)
+      numBits = bitString.size();
+    if (!isBinary || bitString.size() != numBits)
+      unpack();
+  }
+  numShots += count;
+  if (unpacked) {
+    strings.insert(strings.end(), count, std::string(bitString));
+    return;
+  }
+
+  std::vector<std::uint64_t> packed(wordsPerShot(), 0);
+  for (std::size_t i = 0; i < numBits; i++)
+    if (bitString[i] == '1')
+      packed[i / 64] |= std::uint64_t(1) << (i % 64);
+  for (std::size_t j = 0; j < count; j++)
+    words.insert(words.end(), packed.begin(), packed.end());
+}
+
+void SequentialData::append(const SequentialData &other) {
+  if (other.empty())
+    return;
+  if (empty() && !unpacked) {
+    *this = other;
+    return;
+  }
+  if (!unpacked && !other.unpacked && numBits == other.numBits) {
+    words.insert(words.end(), other.words.begin(), other.words.end());
+    numShots += other.numShots;
+    return;
+  }
+  for (std::size_t shot = 0; shot < other.numShots; shot++)
+    append(other[shot], 1);
+}
+
+std::string SequentialData::operator[](std::size_t shot) const {
+  if (shot >= numShots)
+    throw std::out_of_range("Invalid shot index (" + std::to_string(shot) +
+                            ", size=" + std::to_string(numShots) + ")");
+  if (unpacked)
+    return strings[shot];
+  std::string bitString(numBits, '0');
+  const auto *shotWords = words.data() + shot * wordsPerShot();
+  for (std::size_t i = 0; i < numBits; i++)
+    if ((shotWords[i / 64] >> (i % 64)) & 1)
+      bitString[i] = '1';
+  return bitString;
+}
+
+std::vector<std::string> SequentialData::str() const {
+  if (unpacked)
+    return strings;
+  std::vector<std::string> bitStrings;
+  bitStrings.reserve(numShots);
+  for (std::size_t shot = 0; shot < numShots; shot++)
+    bitStrings.push_back((*this)[shot]);
+  return bitStrings;
+}
+
+SequentialData
+SequentialData::gather(const std::vector<std::size_t> &index) const {
+  SequentialData result;
+  if (unpacked) {
+    result.unpacked = true;
+    result.numShots = numShots;
+    result.strings.reserve(numShots);
+    for (auto &s : strings) {
+      std::string newBits(index.size(), '0');
+      int i = 0;
+      for (auto oldIdx : index) {
+        if (oldIdx >= s.size())
+          throw std::runtime_error("Invalid bit index (" +
+                                   std::to_string(oldIdx) +
+                                   ", size=" + std::to_string(s.size()) + ")");
+        newBits[i++] = s[oldIdx];
+      }
+      result.strings.push_back(std::move(newBits));
+    }
+    return result;
+  }
+  if (empty())
+    return result;
+
+  BitGather gatherBits(index, numBits);
+  result.numShots = numShots;
+  result.numBits = index.size();
+  const auto stride = wordsPerShot();
+  const auto newStride = result.wordsPerShot();
+  result.words.resize(numShots * newStride);
+  for (std::size_t shot = 0; shot < numShots; shot++)
+    gatherBits(words.data() + shot * stride,
+               result.words.data() + shot * newStride);
+  return result;
+}
+
+void SequentialData::serialize(std::ostream &os) const {
+  os.put(unpacked ? 0 : 1);
+  writeVarint(os, numShots);
+  if (unpacked) {
+    for (auto &s : strings)
+      writeString(os, s);
+    return;
+  }
+  writeVarint(os, numBits);
+  const auto numBytes = (numBits + 7) / 8;
+  std::string bytes(numBytes, 0);
+  for (std::size_t shot = 0; shot < numShots; shot++) {
+    const auto *shotWords = words.data() + shot * wordsPerShot();
+    for (std::size_t j = 0; j < numBytes; j++)
+      bytes[j] = static_cast<char>(shotWords[j / 8] >> (8 * (j % 8)));
+    os.write(bytes.data(), numBytes);
+  }
+}
+
+void SequentialData::deserialize(std::istream &is) {
+  clear();
+  auto packed = is.get();
+  if (packed == std::char_traits<char>::eof())
+    throw std::runtime_error("Unexpected end of encoded sample result.");
+  auto shots = readVarint(is);
+  if (!packed) {
+    for (std::uint64_t shot = 0; shot < shots; shot++)
+      append(readString(is), 1);
+    return;
+  }
+  auto bits = readNumBits(is);
+  const auto numBytes = (bits + 7) / 8;
+  std::string bytes(numBytes, 0);
+  for (std::uint64_t shot = 0; shot < shots; shot++) {
+    readBytes(is, bytes.data(), numBytes);
+    if (shot == 0)
+      numBits = bits;
+    words.resize(words.size() + wordsPerShot(), 0);
+    auto *shotWords = words.data() + shot * wordsPerShot();
+    for (std::size_t j = 0; j < numBytes; j++)
+      shotWords[j / 8] |= static_cast<std::uint64_t>(
+                              static_cast<unsigned char>(bytes[j]))
+                          << (8 * (j % 8));
+    numShots++;
+  }
+}
+
+void SequentialData::clear() { *this = SequentialData(); }
+
+bool SequentialData::operator==(const SequentialData &other) const {
+  if (numShots != other.numShots)
+    return false;
+  if (!unpacked && !other.unpacked)
+    return numBits == other.numBits && words == other.words;
+  return str() == other.str();
+}
+
+BitCounts::BitCounts(std::size_t bits)
+    : numBits(bits), wordsPerKey((bits + 63) / 64) {}
+
+std::size_t BitCounts::hash(const std::uint64_t *key) const {
+  std::uint64_t h = 0x9e3779b97f4a7c15ull ^ numBits;
+  for (std::size_t i = 0; i < wordsPerKey; i++) {
+    h ^= key[i] + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+    h *= 0xff51afd7ed558ccdull;
+  }
+  return static_cast<std::size_t>(h ^ (h >> 32));
+}
+
+void BitCounts::rehash(std::size_t numSlots) {
+  slots.assign(numSlots, 0);
+  for (std::size_t entry = 0; entry < counts.size(); entry++) {
+    auto slot = hash(keys.data() + entry * wordsPerKey) & (numSlots - 1);
+    while (slots[slot])
+      slot = (slot + 1) & (numSlots - 1);
+    slots[slot] = entry + 1;
+  }
+}
+
+void BitCounts::reserve(std::size_t numKeys) {
+  keys.reserve(numKeys * wordsPerKey);
+  counts.reserve(numKeys);
+  std::size_t numSlots = std::max<std::size_t>(slots.size(), 16);
+  while (numSlots < 2 * numKeys)
+    numSlots *= 2;
+  if (numSlots != slots.size())
+    rehash(numSlots);
+}
+
+std::optional<BitCounts>
+BitCounts::fromDictionary(const CountsDictionary &dictionary) {
+  if (dictionary.empty())
+    return BitCounts();
+  auto numBits = dictionary.begin()->first.size();
+  BitCounts result(numBits);
+  result.keys.resize(dictionary.size() * result.wordsPerKey);
+  result.counts.reserve(dictionary.size());
+  // The bit strings are distinct, so are their keys. Append them without
+  // looking them up, the hash table is only built once a key is added.
+  auto *key = result.keys.data();
+  for (auto &[bits, count] : dictionary) {
+    if (bits.size() != numBits)
+      return std::nullopt;
+    for (std::size_t i = 0; i < numBits; i++) {
+      if (bits[i] == '1')
+        key[i / 64] |= std::uint64_t(1) << (i % 64);
+      else if (bits[i] != '0')
+        return std::nullopt;
+    }
+    result.counts.push_back(count);
+    key += result.wordsPerKey;
+  }
+  return result;
+}
+
+void BitCounts::add(const std::uint64_t *key, std::size_t count) {
+  if (slots.empty())
+    reserve(counts.size() + 1);
+  const auto mask = slots.size() - 1;
+  auto slot = hash(key) & mask;
+  while (auto entry = slots[slot]) {
+    if (std::equal(key, key + wordsPerKey,
+                   keys.data() + (entry - 1) * wordsPerKey)) {
+      counts[entry - 1] += count;
+      return;
+    }
+    slot = (slot + 1) & mask;
+  }
+  keys.insert(keys.end(), key, key + wordsPerKey);
+  counts.push_back(count);
+  slots[slot] = counts.size();
+  // Keep the load factor below one half.
+  if (2 * counts.size() > slots.size())
+    rehash(2 * slots.size());
+}
+
+void BitCounts::add(std::string_view bitString, std::size_t count) {
+  if (bitString.size() != numBits)
+    throw std::runtime_error("Invalid bit string length (" +
+                             std::to_string(bitString.size()) +
+                             ", expected=" + std::to_string(numBits) + ")");
+  scratch.assign(wordsPerKey, 0);
+  for (std::size_t i = 0; i < numBits; i++)
+    if (bitString[i] == '1')
+      scratch[i / 64] |= std::uint64_t(1) << (i % 64);
+  add(scratch.data(), count);
+}
+
+BitCounts BitCounts::gather(const std::vector<std::size_t> &index) const {
+  BitGather gatherBits(index, numBits);
+  BitCounts result(index.size());
+
+  // A permutation of the bits keeps the keys distinct, append them without
+  // looking them up.
+  std::vector<bool> seen(numBits, false);
+  bool isPermutation = index.size() == numBits;
+  for (std::size_t i = 0; isPermutation && i < index.size(); i++) {
+    isPermutation = !seen[index[i]];
+    seen[index[i]] = true;
+  }
+  if (isPermutation) {
+    result.keys.resize(keys.size());
+    result.counts = counts;
+    for (std::size_t entry = 0; entry < counts.size(); entry++)
+      gatherBits(keys.data() + entry * wordsPerKey,
+                 result.keys.data() + entry * wordsPerKey);
+    return result;
+  }
+
+  result.reserve(counts.size());
+  std::vector<std::uint64_t> key(result.wordsPerKey);
+  for (std::size_t entry = 0; entry < counts.size(); entry++) {
+    gatherBits(keys.data() + entry * wordsPerKey, key.data());
+    result.add(key.data(), counts[entry]);
+  }
+  return result;
+}
+
+CountsDictionary BitCounts::toDictionary() const {
+  CountsDictionary dictionary;
+  dictionary.reserve(counts.size());
+  std::string bits(numBits, '0');
+  for (std::size_t entry = 0; entry < counts.size(); entry++) {
+    const auto *key = keys.data() + entry * wordsPerKey;
+    for (std::size_t i = 0; i < numBits; i++)
+      bits[i] = (key[i / 64] >> (i % 64)) & 1 ? '1' : '0';
+    dictionary.emplace(bits, counts[entry]);
+  }
+  return dictionary;
+}
+
+/// @brief Return false if the `CUDAQ_RECORD_SEQUENTIAL_DATA` environment
+/// variable disables recording the bit strings of every shot.
+static bool recordSequentialData() {
+  static const bool record = [] {
+    auto *env = std::getenv("CUDAQ_RECORD_SEQUENTIAL_DATA");
+    if (!env)
+      return true;
+    std::string value(env);
+    return !(value == "0" || value == "false" || value == "off" ||
+             value == "no");
+  }();
+  return record;
+}
+
 ExecutionResult::ExecutionResult(CountsDictionary c) : counts(c) {}
 ExecutionResult::ExecutionResult(std::string name) : registerName(name) {}
 ExecutionResult::ExecutionResult(double e) : expectationValue(e) {}
@@ -58,7 +533,8 @@ void ExecutionResult::appendResult(std::string bitString, std::size_t count) {
   else
     iter->second += count;
 
-  sequentialData.insert(sequentialData.end(), count, bitString);
+  if (recordSequentialData())
+    sequentialData.append(bitString, count);
 }
 
 bool ExecutionResult::operator==(const ExecutionResult &result) const {
@@ -83,7 +559,11 @@ std::vector<std::size_t> ExecutionResult::serialize() const {
   for (auto &kv : counts) {
     auto bits = kv.first;
     auto count = kv.second;
-    auto l = std::stol(bits, NULL, 2);
+    if (bits.size() > 64)
+      throw std::runtime_error(
+          "Cannot serialize bit strings of more than 64 bits to integers, use "
+          "the binary encoding of ExecutionResult::serialize(std::ostream&).");
+    auto l = bits.empty() ? 0 : std::stoull(bits, NULL, 2);
     retData.push_back(l);
     retData.push_back(bits.length());
     retData.push_back(count);
@@ -116,6 +596,123 @@ void ExecutionResult::deserialize(std::vector<std::size_t> &data) {
   }
 }
 
+void ExecutionResult::serialize(std::ostream &os,
+                                bool withSequentialData) const {
+  const bool stringKeys = !isPackable(counts);
+  withSequentialData = withSequentialData && !sequentialData.empty();
+  std::uint8_t flags = (expectationValue ? HasExpectation : 0) |
+                       (withSequentialData ? HasSequentialData : 0) |
+                       (stringKeys ? HasStringKeys : 0);
+  os.put(encodingVersion);
+  os.put(flags);
+  writeString(os, registerName);
+  if (expectationValue) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &*expectationValue, sizeof(bits));
+    char bytes[8];
+    for (int i = 0; i < 8; i++)
+      bytes[i] = static_cast<char>(bits >> (8 * i));
+    os.write(bytes, 8);
+  }
+
+  writeVarint(os, counts.size());
+  if (stringKeys) {
+    for (auto &[bits, count] : counts) {
+      writeString(os, bits);
+      writeVarint(os, count);
+    }
+  } else {
+    const auto numBits = counts.empty() ? 0 : counts.begin()->first.size();
+    writeVarint(os, numBits);
+    std::string key((numBits + 7) / 8, 0);
+    for (auto &[bits, count] : counts) {
+      std::fill(key.begin(), key.end(), 0);
+      for (std::size_t i = 0; i < numBits; i++)
+        if (bits[i] == '1')
+          key[i / 8] |= static_cast<char>(1 << (i % 8));
+      os.write(key.data(), key.size());
+      writeVarint(os, count);
+    }
+  }
+
+  if (withSequentialData)
+    sequentialData.serialize(os);
+  if (!os)
+    throw std::runtime_error("Could not write the encoded sample result.");
+}
+
+void ExecutionResult::deserialize(std::istream &is) {
+  auto version = is.get();
+  auto flags = is.get();
+  if (version == std::char_traits<char>::eof() ||
+      flags == std::char_traits<char>::eof())
+    throw std::runtime_error("Unexpected end of encoded sample result.");
+  if (version != encodingVersion)
+    throw std::runtime_error("Unsupported sample result encoding version (" +
+                             std::to_string(version) + ").");
+
+  counts.clear();
+  sequentialData.clear();
+  expectationValue = std::nullopt;
+  registerName = readString(is);
+  if (flags & HasExpectation) {
+    char bytes[8];
+    readBytes(is, bytes, 8);
+    std::uint64_t bits = 0;
+    for (int i = 0; i < 8; i++)
+      bits |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[i]))
+              << (8 * i);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    expectationValue = value;
+  }
+
+  auto numOutcomes = readVarint(is);
+  if (flags & HasStringKeys) {
+    for (std::uint64_t k = 0; k < numOutcomes; k++) {
+      auto bits = readString(is);
+      counts[bits] += readVarint(is);
+    }
+  } else {
+    auto numBits = readNumBits(is);
+    std::string key((numBits + 7) / 8, 0);
+    std::string bits(numBits, '0');
+    for (std::uint64_t k = 0; k < numOutcomes; k++) {
+      readBytes(is, key.data(), key.size());
+      for (std::size_t i = 0; i < numBits; i++)
+        bits[i] = (key[i / 8] >> (i % 8)) & 1 ? '1' : '0';
+      counts[bits] += readVarint(is);
+    }
+  }
+
+  if (flags & HasSequentialData)
+    sequentialData.deserialize(is);
+}
+
+void sample_result::serialize(std::ostream &os,
+                              bool withSequentialData) const {
+  writeVarint(os, sampleResults.size());
+  for (auto &[name, result] : sampleResults)
+    result.serialize(os, withSequentialData);
+}
+
+void sample_result::deserialize(std::istream &is) {
+  auto numResults = readVarint(is);
+  for (std::uint64_t i = 0; i < numResults; i++) {
+    ExecutionResult result;
+    result.deserialize(is);
+    append(result);
+  }
+
+  // The number of shots is that of the global register, if there is one.
+  auto iter = sampleResults.find(GlobalRegisterName);
+  if (iter != sampleResults.end() && !iter->second.counts.empty()) {
+    totalShots = 0;
+    for (auto &[bits, count] : iter->second.counts)
+      totalShots += count;
+  }
+}
+
 std::vector<std::size_t> sample_result::serialize() const {
   std::vector<std::size_t> retData;
   for (auto &result : sampleResults) {
@@ -237,19 +834,13 @@ sample_result &sample_result::operator+=(const sample_result &other) {
 
       // we already have a sample result with this name, so
       // now lets just merge them
-      auto &sr = sampleResults[regName];
-      for (auto &[bits, count] : otherResults.second.counts) {
-        auto &ourCounts = sr.counts;
-        if (ourCounts.count(bits))
-          ourCounts[bits] += count;
-        else
-          ourCounts.insert({bits, count});
-      }
+      auto &sr = foundIter->second;
+      auto &ourCounts = sr.counts;
+      ourCounts.reserve(ourCounts.size() + otherResults.second.counts.size());
+      for (auto &[bits, count] : otherResults.second.counts)
+        ourCounts[bits] += count;
 
-      if (!otherResults.second.sequentialData.empty())
-        sr.sequentialData.insert(sr.sequentialData.end(),
-                                 otherResults.second.sequentialData.begin(),
-                                 otherResults.second.sequentialData.end());
+      sr.sequentialData.append(otherResults.second.sequentialData);
     }
   }
   return *this;
@@ -367,10 +958,9 @@ double sample_result::expectation(const std::string_view registerName) const {
   if (iter->second.expectationValue.has_value())
     return iter->second.expectationValue.value();
 
-  auto counts = iter->second.counts;
-  for (auto &kv : counts) {
+  for (auto &kv : iter->second.counts) {
     auto par = has_even_parity(kv.first);
-    auto p = probability(kv.first, registerName);
+    auto p = (double)kv.second / totalShots;
     if (!par) {
       p = -p;
     }
@@ -426,18 +1016,29 @@ sample_result::get_marginal(const std::vector<std::size_t> &marginalIndices,
   if (iter == sampleResults.end())
     return sample_result();
 
-  auto counts = iter->second.counts;
+  auto &result = iter->second;
   auto mutableIndices = marginalIndices;
 
   std::sort(mutableIndices.begin(), mutableIndices.end());
 
+  // Marginalize the packed counts and per-shot data, falling back to the bit
+  // strings if these are not of '0's and '1's of the same length.
+  if (auto packed = BitCounts::fromDictionary(result.counts)) {
+    ExecutionResult sr(packed->gather(mutableIndices).toDictionary());
+    const auto &shots = result.sequentialData;
+    if (shots.isPacked() && !shots.empty() &&
+        shots[0].size() == packed->getNumBits())
+      sr.sequentialData = shots.gather(mutableIndices);
+    return sample_result(sr);
+  }
+
   ExecutionResult sr;
-  for (auto &[bits, count] : counts) {
+  for (auto &[bits, count] : result.counts) {
     std::string newBits;
     for ([[maybe_unused]] auto &m : mutableIndices)
       newBits += "0";
     for (int counter = 0; auto &index : mutableIndices) {
-      if (index > bits.size())
+      if (index >= bits.size())
         throw std::runtime_error("Invalid marginal index (" +
                                  std::to_string(index) +
                                  ", size=" + std::to_string(bits.size()));
@@ -506,26 +1107,26 @@ void sample_result::reorder(const std::vector<std::size_t> &idx,
     return;
 
   // First process the counts
-  CountsDictionary newCounts;
-  for (auto [bits, count] : iter->second.counts) {
+  auto &counts = iter->second.counts;
+  for (auto &[bits, count] : counts)
     if (idx.size() != bits.size())
       throw std::runtime_error("Calling reorder() with invalid parameter idx");
 
-    std::string newBits(bits);
-    int i = 0;
-    for (auto oldIdx : idx)
-      newBits[i++] = bits[oldIdx];
-    newCounts[newBits] = count;
+  if (auto packed = BitCounts::fromDictionary(counts)) {
+    counts = packed->gather(idx).toDictionary();
+  } else {
+    CountsDictionary newCounts;
+    for (auto &[bits, count] : counts) {
+      std::string newBits(bits);
+      int i = 0;
+      for (auto oldIdx : idx)
+        newBits[i++] = bits[oldIdx];
+      newCounts[newBits] = count;
+    }
+    counts = newCounts;
   }
-  iter->second.counts = newCounts;
 
   // Now process the sequential data
-  for (auto &s : iter->second.sequentialData) {
-    std::string newBits(s);
-    int i = 0;
-    for (auto oldIdx : idx)
-      newBits[i++] = s[oldIdx];
-    s = newBits;
-  }
+  iter->second.sequentialData.reorder(idx);
 }
 } // namespace cudaq
@@ -8,8 +8,12 @@
 
 #pragma once
 
+#include <cstdint>
+#include <iosfwd>
+#include <iterator>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -20,6 +24,170 @@ using CountsDictionary = std::unordered_map<std::string, std::size_t>;
 
 inline static const std::string GlobalRegisterName = "__global__";
 
+/// @brief The bit strings observed in every shot, in shot order. Bit strings
+/// of '0's and '1's that all have the same length are stored packed into a
+/// shots x bits matrix, 64 bits per word, and only materialized as strings
+/// when read. Any other bit string, e.g. of qudit levels, switches the
+/// storage to plain strings.
+class SequentialData {
+private:
+  /// @brief The number of recorded shots
+  std::size_t numShots = 0;
+
+  /// @brief The length of the packed bit strings
+  std::size_t numBits = 0;
+
+  /// @brief The packed bit strings, `(numBits + 63) / 64` words per shot.
+  /// Character `i` of a bit string is bit `i % 64` of its word `i / 64`.
+  std::vector<std::uint64_t> words;
+
+  /// @brief True if the bit strings are stored as `strings`
+  bool unpacked = false;
+  std::vector<std::string> strings;
+
+  std::size_t wordsPerShot() const { return (numBits + 63) / 64; }
+
+  /// @brief Switch the storage to plain strings.
+  void unpack();
+
+public:
+  /// @brief Iterator materializing the bit string of every shot
+  class const_iterator {
+  private:
+    const SequentialData *data = nullptr;
+    std::size_t shot = 0;
+
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::string;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = std::string;
+
+    const_iterator() = default;
+    const_iterator(const SequentialData *d, std::size_t s) : data(d), shot(s) {}
+    std::string operator*() const { return (*data)[shot]; }
+    const_iterator &operator++() {
+      ++shot;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      auto copy = *this;
+      ++shot;
+      return copy;
+    }
+    bool operator==(const const_iterator &other) const {
+      return data == other.data && shot == other.shot;
+    }
+    bool operator!=(const const_iterator &other) const {
+      return !(*this == other);
+    }
+  };
+
+  SequentialData() = default;
+
+  /// @brief Construct from the bit strings of every shot
+  SequentialData(const std::vector<std::string> &bitStrings);
+
+  /// @brief Record `count` shots that observed `bitString`.
+  void append(std::string_view bitString, std::size_t count = 1);
+
+  /// @brief Record all shots of `other` after the ones of this.
+  void append(const SequentialData &other);
+
+  /// @brief Record a shot that observed `bitString`.
+  void push_back(std::string_view bitString) { append(bitString, 1); }
+
+  /// @brief Return the bit string observed in the given shot.
+  std::string operator[](std::size_t shot) const;
+
+  /// @brief Return the bit strings of all shots.
+  std::vector<std::string> str() const;
+
+  /// @brief Return the data with the bits of every shot gathered such that
+  /// `newBitStr(:)=oldBitStr(index(:))`.
+  SequentialData gather(const std::vector<std::size_t> &index) const;
+
+  /// @brief Reorder the bits of every shot such that
+  /// `newBitStr(:)=oldBitStr(index(:))`.
+  void reorder(const std::vector<std::size_t> &index) {
+    *this = gather(index);
+  }
+
+  /// @brief Return true if the bit strings are stored packed.
+  bool isPacked() const { return !unpacked; }
+
+  /// @brief Write the data to `os`, see `ExecutionResult::serialize`.
+  void serialize(std::ostream &os) const;
+
+  /// @brief Read data written by `serialize` from `is`.
+  void deserialize(std::istream &is);
+
+  std::size_t size() const { return numShots; }
+  bool empty() const { return numShots == 0; }
+  void clear();
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, numShots); }
+
+  bool operator==(const SequentialData &other) const;
+};
+
+/// @brief Counts of bit strings of '0's and '1's of a fixed length, keyed by
+/// the bit strings packed into 64-bit words the same way as in
+/// `SequentialData`. Marginalizing and reordering counts work on the packed
+/// words, only `toDictionary` creates the bit strings.
+class BitCounts {
+private:
+  std::size_t numBits = 0;
+  std::size_t wordsPerKey = 0;
+
+  /// @brief The distinct keys, `wordsPerKey` words each, and their counts
+  std::vector<std::uint64_t> keys;
+  std::vector<std::size_t> counts;
+
+  /// @brief Open addressing hash table of one plus the index of a key, 0 for
+  /// an empty slot. Its size is a power of two. Empty until a key is added
+  /// with `add`.
+  std::vector<std::size_t> slots;
+
+  /// @brief Buffer for packing bit strings
+  std::vector<std::uint64_t> scratch;
+
+  std::size_t hash(const std::uint64_t *key) const;
+  void rehash(std::size_t numSlots);
+
+public:
+  /// @brief Construct empty counts of bit strings of `numBits` bits.
+  explicit BitCounts(std::size_t numBits = 0);
+
+  /// @brief Return the counts in `dictionary` or nothing if its bit strings
+  /// are not all of '0's and '1's and of the same length.
+  static std::optional<BitCounts>
+  fromDictionary(const CountsDictionary &dictionary);
+
+  /// @brief Make room for `numKeys` distinct keys.
+  void reserve(std::size_t numKeys);
+
+  /// @brief Add `count` observations of the packed `key`.
+  void add(const std::uint64_t *key, std::size_t count);
+
+  /// @brief Add `count` observations of `bitString`, which must have
+  /// `numBits` '0's and '1's.
+  void add(std::string_view bitString, std::size_t count);
+
+  /// @brief Return the counts with the bits of every key gathered such that
+  /// `newBitStr(:)=oldBitStr(index(:))`. Keys that become equal are merged.
+  BitCounts gather(const std::vector<std::size_t> &index) const;
+
+  /// @brief Return the counts keyed by bit strings.
+  CountsDictionary toDictionary() const;
+
+  /// @brief Return the number of distinct bit strings.
+  std::size_t size() const { return counts.size(); }
+  std::size_t getNumBits() const { return numBits; }
+};
+
 /// The `ExecutionResult` models the result of a typical
 /// quantum state sampling task. It will contain the
 /// observed measurement bit strings and corresponding number
@@ -35,14 +203,17 @@ struct ExecutionResult {
   /// Register name for the classical bits
   std::string registerName = GlobalRegisterName;
 
-  /// @brief Sequential bit strings observed (not collated into a map)
-  std::vector<std::string> sequentialData;
+  /// @brief Sequential bit strings observed (not collated into a map). Not
+  /// recorded if the `CUDAQ_RECORD_SEQUENTIAL_DATA` environment variable is
+  /// set to 0.
+  SequentialData sequentialData;
 
   /// @brief Serialize this sample result to a vector of integers.
   /// Encoding: 1st element is size of the register name N, then next N
   /// represent register name, next is the number of bitstrings M,
   /// then for each bit string a triple {string mapped to long, bit string
-  /// length, count}
+  /// length, count}. Only supports bit strings of up to 64 bits, see
+  /// `serialize(std::ostream &)` for a compact encoding without this limit.
   /// @return
   std::vector<std::size_t> serialize() const;
 
@@ -51,6 +222,17 @@ struct ExecutionResult {
   /// `serialize`.
   void deserialize(std::vector<std::size_t> &data);
 
+  /// @brief Write this result to `os` in a compact, versioned binary
+  /// encoding. Bit strings of '0's and '1's of the same length are packed
+  /// into bytes, any others are written as strings, and counts are written
+  /// as variable-length integers. The bit strings of every shot are included
+  /// if `withSequentialData` is true. Registers of any width are supported.
+  void serialize(std::ostream &os, bool withSequentialData = true) const;
+
+  /// @brief Read a result written by `serialize(std::ostream &)` from `is`.
+  /// Throws if the data is malformed or of an unsupported version.
+  void deserialize(std::istream &is);
+
   /// @brief Constructor
   ExecutionResult() = default;
 
@@ -95,7 +277,9 @@ struct ExecutionResult {
   /// @param count
   void appendResult(std::string bitString, std::size_t count);
 
-  std::vector<std::string> getSequentialData() const { return sequentialData; }
+  std::vector<std::string> getSequentialData() const {
+    return sequentialData.str();
+  }
 };
 
 /// @brief The sample_result abstraction wraps a set of `ExecutionResult`s for
@@ -173,6 +357,14 @@ public:
   /// @param data
   void deserialize(std::vector<std::size_t> &data);
 
+  /// @brief Write all `ExecutionResult`s to `os` in the compact binary
+  /// encoding of `ExecutionResult::serialize(std::ostream &, bool)`.
+  void serialize(std::ostream &os, bool withSequentialData = true) const;
+
+  /// @brief Add the `ExecutionResult`s written by
+  /// `serialize(std::ostream &, bool)` to this sample_result.
+  void deserialize(std::istream &is);
+
   /// @brief Return true if this sample_result is the same as the given one
   /// @param counts
   /// @return
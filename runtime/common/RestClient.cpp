@@ -8,8 +8,11 @@
 
 #include "RestClient.h"
 #include "Logger.h"
+#include "WireFormat.h"
 #include "cudaq/utils/cudaq_utils.h"
 #include <cpr/cpr.h>
+#include <cstdlib>
+#include <strings.h>
 #include <zlib.h>
 
 namespace cudaq {
@@ -49,6 +52,29 @@ std::string decompress_gzip(const std::string &data) {
   return decompressed;
 }
 
+/// Return the delay requested by the `Retry-After` header, if any. Only the
+/// delay-seconds form is supported, not the HTTP-date one.
+static std::optional<std::chrono::milliseconds>
+getRetryAfterHint(const cpr::Header &header) {
+  auto iter = header.find("Retry-After");
+  if (iter == header.end())
+    return std::nullopt;
+  char *end = nullptr;
+  auto seconds = std::strtol(iter->second.c_str(), &end, 10);
+  if (end == iter->second.c_str() || seconds < 0)
+    return std::nullopt;
+  return std::chrono::seconds(seconds);
+}
+
+/// Parse the body of a response, which is either JSON or, if the server chose
+/// to reply in the binary wire format, a binary message.
+static nlohmann::json parseResponse(const cpr::Response &r) {
+  auto iter = r.header.find("Content-Type");
+  if (iter != r.header.end() && wire::isBinaryContentType(iter->second))
+    return wire::decode(r.text);
+  return nlohmann::json::parse(r.text);
+}
+
 RestClient::RestClient() : sslOptions(std::make_unique<cpr::SslOptions>()) {
   auto caInfo = [&]() -> std::string {
     if (auto *curlCABundleStr = getenv("CURL_CA_BUNDLE")) {
@@ -98,16 +124,52 @@ nlohmann::json RestClient::post(const std::string_view remoteUrl,
     cudaq::info("Posting to {}/{} with data = {}", remoteUrl, path,
                 post.dump());
 
+  return postBody(remoteUrl, path, post.dump(), headers, enableSsl);
+}
+
+nlohmann::json RestClient::postBinary(
+    const std::string_view remoteUrl, const std::string_view path,
+    const nlohmann::json &message, std::map<std::string, std::string> &headers,
+    bool enableSsl) {
+  // Replace the content type the caller may have set for JSON messages.
+  std::erase_if(headers, [](const auto &header) {
+    return strcasecmp(header.first.c_str(), "Content-Type") == 0;
+  });
+  headers["Content-Type"] = wire::CONTENT_TYPE;
+  return postBody(remoteUrl, path, wire::encode(message), headers, enableSsl);
+}
+
+nlohmann::json RestClient::postBody(const std::string_view remoteUrl,
+                                    const std::string_view path,
+                                    std::string body,
+                                    std::map<std::string, std::string> &headers,
+                                    bool enableSsl) {
+  cpr::Header cprHeaders;
+  for (auto &kv : headers)
+    cprHeaders.insert({kv.first, kv.second});
+
   auto actualPath = std::string(remoteUrl) + std::string(path);
-  auto r = cpr::Post(cpr::Url{actualPath}, cpr::Body(post.dump()), cprHeaders,
-                     cpr::VerifySsl(enableSsl), *sslOptions);
+  std::unique_lock<std::mutex> lock(sessionMutex);
+  if (!postSession)
+    postSession = std::make_unique<cpr::Session>();
+  postSession->SetUrl(cpr::Url{actualPath});
+  postSession->SetHeader(cprHeaders);
+  postSession->SetParameters(cpr::Parameters{});
+  postSession->SetBody(cpr::Body(std::move(body)));
+  postSession->SetVerifySsl(cpr::VerifySsl(enableSsl));
+  postSession->SetSslOptions(*sslOptions);
+  auto r = postSession->Post();
+  lastStatusCode = r.status_code;
+  lastRetryAfter = getRetryAfterHint(r.header);
+  lastContentType = r.header["Content-Type"];
+  lock.unlock();
 
   if (r.status_code > validHttpCode || r.status_code == 0)
     throw std::runtime_error("HTTP POST Error - status code " +
                              std::to_string(r.status_code) + ": " +
                              r.error.message + ": " + r.text);
 
-  return nlohmann::json::parse(r.text);
+  return parseResponse(r);
 }
 
 void RestClient::put(const std::string_view remoteUrl,
@@ -147,10 +209,21 @@ nlohmann::json RestClient::get(const std::string_view remoteUrl,
   for (auto &kv : headers)
     cprHeaders.insert({kv.first, kv.second});
 
-  cpr::Parameters cprParams;
   auto actualPath = std::string(remoteUrl) + std::string(path);
-  auto r = cpr::Get(cpr::Url{actualPath}, cprHeaders, cprParams,
-                    cpr::VerifySsl(enableSsl), *sslOptions);
+  std::unique_lock<std::mutex> lock(sessionMutex);
+  if (!getSession)
+    getSession = std::make_unique<cpr::Session>();
+  getSession->SetUrl(cpr::Url{actualPath});
+  getSession->SetHeader(cprHeaders);
+  getSession->SetParameters(cpr::Parameters{});
+  getSession->SetVerifySsl(cpr::VerifySsl(enableSsl));
+  getSession->SetSslOptions(*sslOptions);
+  auto r = getSession->Get();
+
+  lastStatusCode = r.status_code;
+  lastRetryAfter = getRetryAfterHint(r.header);
+  lastContentType = r.header["Content-Type"];
+  lock.unlock();
 
   if (r.status_code > validHttpCode || r.status_code == 0)
     throw std::runtime_error("HTTP GET Error - status code " +
@@ -162,7 +235,7 @@ nlohmann::json RestClient::get(const std::string_view remoteUrl,
     auto tmp = decompress_gzip(r.text);
     r.text = tmp;
   }
-  return nlohmann::json::parse(r.text);
+  return parseResponse(r);
 }
 
 void RestClient::del(const std::string_view remoteUrl,
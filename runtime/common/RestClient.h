@@ -8,13 +8,17 @@
 
 #pragma once
 #include "nlohmann/json.hpp"
+#include <chrono>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <string>
 
 // Forward declarations to avoid including CPR header files
 namespace cpr {
 struct SslOptions;
-}
+class Session;
+} // namespace cpr
 
 namespace cudaq {
 
@@ -28,6 +32,25 @@ protected:
   /// SSL options to use for transfers
   std::unique_ptr<cpr::SslOptions> sslOptions;
 
+  /// Sessions reused across GET and POST requests respectively, so that
+  /// repeated requests (e.g. submitting or polling jobs) keep the connection
+  /// to the server alive.
+  std::unique_ptr<cpr::Session> getSession;
+  std::unique_ptr<cpr::Session> postSession;
+  std::mutex sessionMutex;
+
+  /// Status code, `Retry-After` hint and content type of the last GET or POST
+  /// response.
+  long lastStatusCode = 0;
+  std::optional<std::chrono::milliseconds> lastRetryAfter;
+  std::string lastContentType;
+
+  /// Post the body to the remote path at the provided URL.
+  nlohmann::json postBody(const std::string_view remoteUrl,
+                          const std::string_view path, std::string body,
+                          std::map<std::string, std::string> &headers,
+                          bool enableSsl);
+
 public:
   /// @brief set verbose printout
   /// @param v
@@ -39,11 +62,31 @@ public:
   /// @brief Destructor
   ~RestClient();
 
+  /// @brief Return the HTTP status code of the last GET or POST request, or 0
+  /// if the request did not reach the server.
+  long getLastStatusCode() const { return lastStatusCode; }
+
+  /// @brief Return the delay the server asked for via the `Retry-After` header
+  /// of the last GET or POST response, if any.
+  std::optional<std::chrono::milliseconds> getRetryAfter() const {
+    return lastRetryAfter;
+  }
+
+  /// @brief Return the content type of the last GET or POST response.
+  const std::string &getLastContentType() const { return lastContentType; }
+
   /// Post the message to the remote path at the provided URL.
   nlohmann::json post(const std::string_view remoteUrl,
                       const std::string_view path, nlohmann::json &postStr,
                       std::map<std::string, std::string> &headers,
                       bool enableLogging = true, bool enableSsl = false);
+  /// Post the message to the remote path at the provided URL, encoded in the
+  /// compact binary wire format, see `WireFormat.h`.
+  nlohmann::json postBinary(const std::string_view remoteUrl,
+                            const std::string_view path,
+                            const nlohmann::json &message,
+                            std::map<std::string, std::string> &headers,
+                            bool enableSsl = false);
   /// Get the contents of the remote server at the given URL and path.
   nlohmann::json get(const std::string_view remoteUrl,
                      const std::string_view path,
@@ -14,7 +14,9 @@
 #include "Future.h"
 #include "MeasureCounts.h"
 #include "Registry.h"
+#include <chrono>
 #include <filesystem>
+#include <optional>
 
 namespace cudaq {
 
@@ -106,6 +108,23 @@ public:
   /// @brief Extract the job id from the server response from posting the job.
   virtual std::string extractJobId(ServerMessage &postResponse) = 0;
 
+  /// @brief Combine the job messages created by `createJob` into a single
+  /// request to the provider's batch submission endpoint. Return the batch
+  /// post path and message, or nothing if the provider has no such endpoint,
+  /// in which case the jobs are posted individually.
+  virtual std::optional<std::pair<std::string, ServerMessage>>
+  createBatchJob(const std::string &jobPostPath,
+                 std::vector<ServerMessage> &jobs) {
+    return std::nullopt;
+  }
+
+  /// @brief Extract the ids of the jobs of a batch, in submission order, from
+  /// the server response from posting the batch created by `createBatchJob`.
+  virtual std::vector<std::string>
+  extractBatchJobIds(ServerMessage &batchPostResponse) {
+    throw std::runtime_error(name() + " does not support batch submission.");
+  }
+
   /// @brief Get the specific path required to retrieve job results.
   /// Construct specifically from the job id.
   virtual std::string constructGetJobPath(std::string &jobId) = 0;
@@ -117,6 +136,14 @@ public:
   /// @brief Return true if the job is done.
   virtual bool jobIsDone(ServerMessage &getJobResponse) = 0;
 
+  /// @brief Return the interval the server suggests to wait before polling
+  /// the job again, given its latest status response. Zero means the server
+  /// has no preference and the client backs off on its own.
+  virtual std::chrono::microseconds
+  nextResultPollingInterval(ServerMessage &getJobResponse) {
+    return std::chrono::microseconds(0);
+  }
+
   /// @brief Given a successful job and the success response,
   /// retrieve the results and map them to a sample_result.
   /// @param postJobResponse
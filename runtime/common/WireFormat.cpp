@@ -0,0 +1,153 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "WireFormat.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <zlib.h>
+
+namespace cudaq::wire {
+static constexpr char magic[4] = {'C', 'Q', 'W', 'F'};
+static constexpr std::size_t headerSize = 16;
+static constexpr std::uint8_t compressedFlag = 0x1;
+/// The maximum compression ratio of zlib's deflate, a larger uncompressed size
+/// in the header cannot be right.
+static constexpr std::uint64_t maxCompressionRatio = 1032;
+
+static void writeLittleEndian(char *out, std::uint64_t value) {
+  for (std::size_t i = 0; i < 8; ++i)
+    out[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+}
+
+static std::uint64_t readLittleEndian(const char *in) {
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < 8; ++i)
+    value |= static_cast<std::uint64_t>(static_cast<unsigned char>(in[i]))
+             << (8 * i);
+  return value;
+}
+
+/// Return the media type of a header value without its parameters and
+/// surrounding whitespace.
+static std::string_view getMediaType(std::string_view value,
+                                     std::string_view &parameters) {
+  const auto end = value.find(';');
+  parameters = end == std::string_view::npos ? std::string_view()
+                                             : value.substr(end + 1);
+  value = value.substr(0, end);
+  const auto first = value.find_first_not_of(" \t");
+  if (first == std::string_view::npos)
+    return {};
+  const auto last = value.find_last_not_of(" \t");
+  return value.substr(first, last - first + 1);
+}
+
+static bool equalsIgnoreCase(std::string_view lhs, std::string_view rhs) {
+  return lhs.size() == rhs.size() &&
+         std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](char a, char b) {
+           return std::tolower(static_cast<unsigned char>(a)) ==
+                  std::tolower(static_cast<unsigned char>(b));
+         });
+}
+
+bool acceptsBinary(std::string_view acceptHeader) {
+  while (!acceptHeader.empty()) {
+    const auto end = acceptHeader.find(',');
+    const auto mediaRange = acceptHeader.substr(0, end);
+    acceptHeader = end == std::string_view::npos ? std::string_view()
+                                                 : acceptHeader.substr(end + 1);
+    std::string_view parameters;
+    if (!equalsIgnoreCase(getMediaType(mediaRange, parameters), CONTENT_TYPE))
+      continue;
+    // A quality of 0 means "not acceptable".
+    const auto q = parameters.find("q=");
+    if (q == std::string_view::npos)
+      return true;
+    const std::string quality(parameters.substr(q + 2));
+    return std::strtod(quality.c_str(), nullptr) > 0.0;
+  }
+  return false;
+}
+
+bool isBinaryContentType(std::string_view contentType) {
+  std::string_view parameters;
+  return equalsIgnoreCase(getMediaType(contentType, parameters), CONTENT_TYPE);
+}
+
+std::string encode(const nlohmann::json &message,
+                   std::size_t compressionThreshold) {
+  const auto payload = nlohmann::json::to_msgpack(message);
+
+  std::string data(headerSize, '\0');
+  std::memcpy(data.data(), magic, sizeof(magic));
+  data[4] = static_cast<char>(FORMAT_VERSION);
+  writeLittleEndian(data.data() + 8, payload.size());
+
+  if (payload.size() > compressionThreshold) {
+    // Favor speed, the bulk of large payloads are highly redundant per-shot
+    // measurement data that compresses well at the fastest level.
+    uLongf compressedSize = compressBound(payload.size());
+    data.resize(headerSize + compressedSize);
+    const auto status = compress2(
+        reinterpret_cast<Bytef *>(data.data() + headerSize), &compressedSize,
+        payload.data(), payload.size(), Z_BEST_SPEED);
+    if (status == Z_OK && compressedSize < payload.size()) {
+      data[5] = static_cast<char>(compressedFlag);
+      data.resize(headerSize + compressedSize);
+      return data;
+    }
+    data.resize(headerSize);
+  }
+
+  data.append(reinterpret_cast<const char *>(payload.data()), payload.size());
+  return data;
+}
+
+bool isBinaryMessage(std::string_view data) {
+  return data.size() >= headerSize &&
+         std::memcmp(data.data(), magic, sizeof(magic)) == 0;
+}
+
+nlohmann::json decode(std::string_view data) {
+  if (!isBinaryMessage(data))
+    throw std::runtime_error("Invalid binary message: missing header.");
+  const auto version = static_cast<std::uint8_t>(data[4]);
+  if (version > FORMAT_VERSION)
+    throw std::runtime_error(
+        "Unsupported binary message version " + std::to_string(version) +
+        " (supported up to " + std::to_string(FORMAT_VERSION) + ").");
+
+  const auto flags = static_cast<std::uint8_t>(data[5]);
+  const auto size = readLittleEndian(data.data() + 8);
+  const auto *payload = data.data() + headerSize;
+  const auto payloadSize = data.size() - headerSize;
+  if (!(flags & compressedFlag)) {
+    if (payloadSize != size)
+      throw std::runtime_error("Invalid binary message: truncated payload.");
+    return nlohmann::json::from_msgpack(payload, payload + payloadSize);
+  }
+
+  // Check the size before allocating, the header may be corrupted.
+  if (size > MAX_PAYLOAD_SIZE || size / maxCompressionRatio > payloadSize)
+    throw std::runtime_error("Invalid binary message: payload size " +
+                             std::to_string(size) + " is out of bounds.");
+  std::string decompressed(size, '\0');
+  uLongf decompressedSize = size;
+  const auto status =
+      uncompress(reinterpret_cast<Bytef *>(decompressed.data()),
+                 &decompressedSize, reinterpret_cast<const Bytef *>(payload),
+                 payloadSize);
+  if (status != Z_OK || decompressedSize != size)
+    throw std::runtime_error(
+        "Invalid binary message: failed to decompress the payload.");
+  return nlohmann::json::from_msgpack(decompressed);
+}
+} // namespace cudaq::wire
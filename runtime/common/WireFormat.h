@@ -0,0 +1,67 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "nlohmann/json.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/*! \file
+    \brief Compact binary encoding of the JSON messages exchanged with remote
+    servers, e.g., the remote simulation server.
+
+    A binary message is a fixed-size header followed by the MessagePack
+    encoding of the JSON message, optionally compressed with zlib. Binary
+    values (`nlohmann::json::binary_t`), e.g., IR and serialized arguments,
+    are stored as raw bytes rather than Base64 strings or arrays of numbers.
+
+    Header layout, integers are little-endian:
+      magic        4 bytes  "CQWF"
+      version      1 byte   `cudaq::wire::FORMAT_VERSION`
+      flags        1 byte   bit 0: the payload is zlib compressed
+      reserved     2 bytes
+      size         8 bytes  size of the uncompressed payload
+*/
+
+namespace cudaq::wire {
+/// @brief The HTTP content type of binary messages. Clients that accept
+/// binary responses list it in their `Accept` header.
+inline constexpr const char *CONTENT_TYPE = "application/vnd.cudaq.binary";
+
+/// @brief The version of the binary encoding, bumped on incompatible changes.
+inline constexpr std::uint8_t FORMAT_VERSION = 1;
+
+/// @brief The maximum size of the uncompressed payload of a message that is
+/// decoded, so that a corrupted or malicious header cannot make the decoder
+/// allocate arbitrary amounts of memory.
+inline constexpr std::uint64_t MAX_PAYLOAD_SIZE = std::uint64_t{4} << 30;
+
+/// @brief Return true if the HTTP `Accept` header lists the binary content
+/// type with a nonzero quality. Wildcards do not match, since clients that do
+/// not list the binary format may not be able to decode it.
+bool acceptsBinary(std::string_view acceptHeader);
+
+/// @brief Return true if the HTTP `Content-Type` header is the binary content
+/// type, ignoring parameters and case.
+bool isBinaryContentType(std::string_view contentType);
+
+/// @brief Encode the message in the binary wire format. Payloads larger than
+/// `compressionThreshold` bytes are compressed.
+std::string encode(const nlohmann::json &message,
+                   std::size_t compressionThreshold = 1024);
+
+/// @brief Return true if the data starts with the header of a binary message.
+bool isBinaryMessage(std::string_view data);
+
+/// @brief Decode a binary message. Throws if the data is not a valid binary
+/// message of a supported version, or if its payload is larger than
+/// `MAX_PAYLOAD_SIZE`.
+nlohmann::json decode(std::string_view data);
+} // namespace cudaq::wire
@@ -10,6 +10,7 @@
 
 #include "cudaq/platform.h"
 #include "host_config.h"
+#include <algorithm>
 
 namespace cudaq {
 
@@ -37,17 +38,16 @@ using BroadcastFunctorType = const std::function<ReturnType(
 
 /// @brief Given the input BroadcastFunctorType, apply it to all argument sets
 /// in the provided ArgumentSet `params`. Distribute the work over the provided
-/// number of QPUs.
+/// number of QPUs. The argument sets are split into contiguous chunks that are
+/// not bound to a QPU, so that QPUs that finish early steal the remaining
+/// chunks of slower ones.
 template <typename ResType, typename... Args>
 std::vector<ResType>
 broadcastFunctionOverArguments(std::size_t numQpus, quantum_platform &platform,
                                BroadcastFunctorType<ResType, Args...> &apply,
                                ArgumentSet<Args...> &params) {
-  using FutureCollection = std::vector<std::future<std::vector<ResType>>>;
-
   // Assert all arg vectors are the same size
   auto N = std::get<0>(params).size();
-  auto nExecsPerQpu = N / numQpus + (N % numQpus != 0);
 
   // Validate the input deck
   cudaq::tuple_for_each(params, [&](auto &&element) {
@@ -56,82 +56,91 @@ broadcastFunctionOverArguments(std::size_t numQpus, quantum_platform &platform,
                                "over - vector sizes not the same.");
   });
 
+  if (N == 0)
+    return {};
+
+  // Oversubscribe the QPUs with a few chunks each to let the work-stealing
+  // queues balance uneven execution times.
+  constexpr std::size_t chunksPerQpu = 4;
+  auto numChunks =
+      std::min(N, std::max<std::size_t>(numQpus, 1) * chunksPerQpu);
+  auto chunkSize = N / numChunks + (N % numChunks != 0);
+  numChunks = N / chunkSize + (N % chunkSize != 0);
+
   // Fetch the thread-specific seed outside the functor and then pass it inside.
   std::size_t seed = cudaq::get_random_seed();
 
-  FutureCollection futures;
-  for (std::size_t qpuId = 0; qpuId < numQpus; qpuId++) {
-    std::promise<std::vector<ResType>> _promise;
+  std::vector<ResType> allResults(N);
+  std::vector<std::future<void>> futures;
+  for (std::size_t chunk = 0; chunk < numChunks; chunk++) {
+    std::promise<void> _promise;
     futures.emplace_back(_promise.get_future());
-    std::function<void()> functor = detail::make_copyable_function(
-        [&params, &apply, qpuId, nExecsPerQpu, seed,
-         promise = std::move(_promise)]() mutable {
+    StealableQuantumTask functor = detail::make_copyable_function(
+        [&params, &apply, &allResults, chunk, chunkSize, N, seed,
+         promise = std::move(_promise)](std::size_t qpuId) mutable {
           // Compute the lower and upper bounds of the
-          // argument set that should be computed on the current QPU
-          auto lowerBound = qpuId * nExecsPerQpu;
-          auto upperBound = lowerBound + nExecsPerQpu;
-
-          // Store the results
-          std::vector<ResType> results;
-
-          // Loop over all sets of arguments, the ith element of each vector
-          // in the ArgumentSet tuple
-          for (std::size_t i = lowerBound, counter = 0; i < upperBound; i++) {
-            // Construct the current set of arguments as a new tuple
-            // We want a tuple so we can use std::apply with the
-            // existing sample()/observe() functions.
-            std::tuple<std::size_t, std::size_t, std::size_t, Args...>
-                currentArgs;
-
-            // Fill the argument tuple with the QPU id, current argument
-            // iteration, and the total number of arguments that will be applied
-            // on this QPU.
-            std::get<0>(currentArgs) = qpuId;
-            std::get<1>(currentArgs) = counter;
-            std::get<2>(currentArgs) = nExecsPerQpu;
-            counter++;
-
-            // If seed is 0, then it has not been set.
-            if (seed > 0)
-              cudaq::set_random_seed(seed);
-
-            // Fill the argument tuple with the actual arguments.
-            cudaq::tuple_for_each_with_idx(
-                params,
+          // argument set that should be computed in this chunk
+          auto lowerBound = chunk * chunkSize;
+          auto upperBound = std::min(lowerBound + chunkSize, N);
+          // A single execution is not run in batch mode.
+          auto numExecs = upperBound - lowerBound;
+          auto batchSize = numExecs > 1 ? numExecs : 0;
+
+          try {
+            // Loop over all sets of arguments, the ith element of each vector
+            // in the ArgumentSet tuple
+            for (std::size_t i = lowerBound, counter = 0; i < upperBound;
+                 i++) {
+              // Construct the current set of arguments as a new tuple
+              // We want a tuple so we can use std::apply with the
+              // existing sample()/observe() functions.
+              std::tuple<std::size_t, std::size_t, std::size_t, Args...>
+                  currentArgs;
+
+              // Fill the argument tuple with the QPU id, current argument
+              // iteration, and the total number of arguments that will be
+              // applied in this chunk.
+              std::get<0>(currentArgs) = qpuId;
+              std::get<1>(currentArgs) = counter;
+              std::get<2>(currentArgs) = batchSize;
+              counter++;
+
+              // If seed is 0, then it has not been set.
+              if (seed > 0)
+                cudaq::set_random_seed(seed);
+
+              // Fill the argument tuple with the actual arguments.
+              cudaq::tuple_for_each_with_idx(
+                  params,
 #if CUDAQ_USE_STD20
-                [&]<typename IDX_TYPE>(auto &&element, IDX_TYPE &&idx) {
-                  std::get<IDX_TYPE::value + 3>(currentArgs) = element[i];
-                }
+                  [&]<typename IDX_TYPE>(auto &&element, IDX_TYPE &&idx) {
+                    std::get<IDX_TYPE::value + 3>(currentArgs) = element[i];
+                  }
 #else
-                [&](auto &&element, auto &&idx) {
-                  std::get<std::remove_cv_t<
-                               std::remove_reference_t<decltype(idx)>>::value +
-                           3>(currentArgs) = element[i];
-                }
+                  [&](auto &&element, auto &&idx) {
+                    std::get<std::remove_cv_t<std::remove_reference_t<
+                                 decltype(idx)>>::value +
+                             3>(currentArgs) = element[i];
+                  }
 #endif
-            );
-
-            // Call observe/sample with the current set of arguments
-            // (provided as a tuple)
-            auto result = std::apply(apply, currentArgs);
-
-            // Store the result.
-            results.push_back(result);
+              );
+
+              // Call observe/sample with the current set of arguments
+              // (provided as a tuple) and store the result in place.
+              allResults[i] = std::apply(apply, currentArgs);
+            }
+            promise.set_value();
+          } catch (...) {
+            promise.set_exception(std::current_exception());
           }
-
-          // Set the promised results.
-          promise.set_value(results);
         });
 
-    platform.enqueueAsyncTask(qpuId, functor);
+    platform.enqueueStealableTask(functor);
   }
 
-  // Get all the async-generated results and return.
-  std::vector<ResType> allResults;
-  for (auto &f : futures) {
-    auto res = f.get();
-    allResults.insert(allResults.end(), res.begin(), res.end());
-  }
+  // Wait for all the async-generated results and return.
+  for (auto &f : futures)
+    f.get();
 
   return allResults;
 }
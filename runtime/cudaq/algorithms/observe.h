@@ -15,7 +15,11 @@
 #include "cudaq/concepts.h"
 #include "cudaq/spin_op.h"
 #include "host_config.h"
+#include <algorithm>
+#include <chrono>
 #include <functional>
+#include <optional>
+#include <thread>
 #if CUDAQ_USE_STD20
 #include <ranges>
 #endif
@@ -170,37 +174,83 @@ auto runObservationAsync(KernelFunctor &&wrappedKernel, spin_op &H,
       details::future(platform.enqueueAsyncTask(qpu_id, task)), &H);
 }
 
+/// @brief The number of term chunks created per QPU when the expectation
+/// value computations are scheduled dynamically among local QPUs.
+static constexpr std::size_t termChunksPerQpu = 4;
+
 /// @brief Distribute the expectation value computations among the
 /// available platform QPUs. The `asyncLauncher` functor takes as input the
 /// QPU index and the `spin_op` chunk and returns an `async_observe_result`.
+/// Terms are split into chunks of similar estimated cost, keeping terms that
+/// share a measurement basis together. If all QPUs are local, more chunks than
+/// QPUs are created and each QPU picks up the next pending chunk as soon as it
+/// finishes its current one, so that no QPU idles while others have a backlog.
 inline auto distributeComputations(
     std::function<async_observe_result(std::size_t, spin_op &)> &&asyncLauncher,
     spin_op &H, std::size_t nQpus) {
 
-  // Distribute the given spin_op into subsets for each QPU
-  auto spins = H.distribute_terms(nQpus);
-
-  // Observe each sub-spin_op asynchronously
-  std::vector<async_observe_result> asyncResults;
-#if CUDAQ_USE_STD20
-  for (std::size_t i = 0; auto &op : spins) {
-#else
-  std::size_t i = 0;
-  for (auto &op : spins) {
-#endif
-    asyncResults.emplace_back(asyncLauncher(i, op));
-    i++;
-  }
-
-  // Wait for the results, should be executing
-  // in parallel on the available QPUs.
+  // Remote QPUs only report completion once queried, hence require a static
+  // assignment of one chunk per QPU.
+  auto &platform = cudaq::get_platform();
+  bool dynamicScheduling = nQpus > 1;
+  for (std::size_t i = 0; i < nQpus && dynamicScheduling; i++)
+    dynamicScheduling = !platform.is_remote(i);
+
+  // Distribute the given spin_op into subsets
+  auto numChunks = nQpus;
+  if (dynamicScheduling)
+    numChunks =
+        std::max(nQpus, std::min(H.num_terms(), nQpus * termChunksPerQpu));
+  auto spins = H.distribute_terms(numChunks, term_distribution::cost_balanced);
+
+  // Observe each sub-spin_op asynchronously, handing the next pending chunk to
+  // the first QPU that becomes available.
   double result = 0.0;
   sample_result data;
-  for (auto &asyncResult : asyncResults) {
+  std::size_t nextChunk = 0;
+  auto launchNext =
+      [&](std::size_t qpuId) -> std::optional<async_observe_result> {
+    while (nextChunk < spins.size() && spins[nextChunk].num_terms() == 0)
+      nextChunk++;
+    if (nextChunk == spins.size())
+      return std::nullopt;
+    return asyncLauncher(qpuId, spins[nextChunk++]);
+  };
+  auto collect = [&](async_observe_result &asyncResult) {
     auto res = asyncResult.get();
     auto incomingData = res.raw_data();
     result += incomingData.expectation();
     data += incomingData;
+  };
+
+  std::vector<std::optional<async_observe_result>> inFlight;
+  for (std::size_t i = 0; i < nQpus; i++)
+    inFlight.emplace_back(launchNext(i));
+
+  if (!dynamicScheduling) {
+    // Wait for the results, should be executing
+    // in parallel on the available QPUs.
+    for (auto &asyncResult : inFlight)
+      if (asyncResult)
+        collect(*asyncResult);
+    return observe_result(result, H, data);
+  }
+
+  std::size_t numInFlight = std::count_if(
+      inFlight.begin(), inFlight.end(), [](auto &r) { return r.has_value(); });
+  while (numInFlight > 0) {
+    bool progressed = false;
+    for (std::size_t i = 0; i < nQpus; i++) {
+      if (!inFlight[i] || !inFlight[i]->is_ready())
+        continue;
+      collect(*inFlight[i]);
+      inFlight[i] = launchNext(i);
+      if (!inFlight[i])
+        numInFlight--;
+      progressed = true;
+    }
+    if (!progressed)
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
   }
 
   return observe_result(result, H, data);
@@ -311,20 +361,23 @@ observe_result observe(std::size_t shots, QuantumKernel &&kernel, spin_op H,
         [&kernel, shots, ... args = std::forward<Args>(args)](
             std::size_t i, spin_op &op) mutable {
           return observe_async(shots, i, std::forward<QuantumKernel>(kernel),
-                               op, std::forward<Args>(args)...);
+                               op, args...);
         },
         H, nQpus);
 #else
     return details::distributeComputations(
         [&kernel, shots,
-         args = std::forward_as_tuple(std::forward<Args>(args)...)](
+         args = std::make_tuple(std::forward<Args>(args)...)](
             std::size_t i, spin_op &op) mutable {
+          // The launcher runs once per term chunk, so the captured arguments
+          // are passed as lvalues rather than moved into the first task.
           return std::apply(
-              [&](auto &&...args) {
-                observe_async(shots, i, std::forward<QuantumKernel>(kernel), op,
-                              std::forward<Args>(args)...);
+              [&](auto &...args) {
+                return observe_async(shots, i,
+                                     std::forward<QuantumKernel>(kernel), op,
+                                     args...);
               },
-              std::move(args));
+              args);
         },
         H, nQpus);
 #endif
@@ -346,7 +399,8 @@ observe_result observe(std::size_t shots, QuantumKernel &&kernel, spin_op H,
     auto nRanks = mpi::num_ranks();
 
     // Each rank gets a subset of the spin terms
-    auto spins = H.distribute_terms(nRanks);
+    auto spins =
+        H.distribute_terms(nRanks, term_distribution::cost_balanced);
 
     // Get this rank's set of spins to compute
     auto localH = spins[rank];
@@ -357,18 +411,21 @@ observe_result observe(std::size_t shots, QuantumKernel &&kernel, spin_op H,
         [&kernel, shots, ... args = std::forward<Args>(args)](
             std::size_t i, spin_op &op) mutable {
           return observe_async(shots, i, std::forward<QuantumKernel>(kernel),
-                               op, std::forward<Args>(args)...);
+                               op, args...);
         },
 #else
         [&kernel, shots,
-         args = std::forward_as_tuple(std::forward<Args>(args)...)](
+         args = std::make_tuple(std::forward<Args>(args)...)](
             std::size_t i, spin_op &op) mutable {
+          // The launcher runs once per term chunk, so the captured arguments
+          // are passed as lvalues rather than moved into the first task.
           return std::apply(
-              [&](auto &&...args) {
-                observe_async(shots, i, std::forward<QuantumKernel>(kernel), op,
-                              std::forward<Args>(args)...);
+              [&](auto &...args) {
+                return observe_async(shots, i,
+                                     std::forward<QuantumKernel>(kernel), op,
+                                     args...);
               },
-              std::move(args));
+              args);
         },
 #endif
         localH, nQpus);
@@ -421,18 +478,21 @@ observe_result observe(std::size_t shots, QuantumKernel &&kernel, spin_op H,
         [&kernel, shots, ... args = std::forward<Args>(args)](
             std::size_t i, spin_op &op) mutable {
           return observe_async(shots, i, std::forward<QuantumKernel>(kernel),
-                               op, std::forward<Args>(args)...);
+                               op, args...);
         },
 #else
         [&kernel, shots,
-         args = std::forward_as_tuple(std::forward<Args>(args)...)](
+         args = std::make_tuple(std::forward<Args>(args)...)](
             std::size_t i, spin_op &op) mutable {
+          // The launcher runs once per term chunk, so the captured arguments
+          // are passed as lvalues rather than moved into the first task.
           return std::apply(
-              [&](auto &&...args) {
-                observe_async(shots, i, std::forward<QuantumKernel>(kernel), op,
-                              std::forward<Args>(args)...);
+              [&](auto &...args) {
+                return observe_async(shots, i,
+                                     std::forward<QuantumKernel>(kernel), op,
+                                     args...);
               },
-              std::move(args));
+              args);
         },
 #endif
         H, nQpus);
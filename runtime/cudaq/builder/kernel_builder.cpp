@@ -16,10 +16,14 @@
 #include "cudaq/Optimizer/Dialect/Quake/QuakeDialect.h"
 #include "cudaq/Optimizer/Dialect/Quake/QuakeOps.h"
 #include "cudaq/Optimizer/Transforms/Passes.h"
+#include "cudaq/platform.h"
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
 #include "mlir/Dialect/Affine/IR/AffineOps.h"
 #include "mlir/Dialect/Affine/Passes.h"
 #include "mlir/Dialect/LLVMIR/LLVMDialect.h"
 #include "mlir/ExecutionEngine/ExecutionEngine.h"
+#include "mlir/ExecutionEngine/OptUtils.h"
 #include "mlir/IR/AsmState.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/ImplicitLocOpBuilder.h"
@@ -31,6 +35,8 @@
 #include "mlir/Target/LLVMIR/ModuleTranslation.h"
 #include "mlir/Transforms/Passes.h"
 
+#include <chrono>
+#include <future>
 #include <numeric>
 
 using namespace mlir;
@@ -107,6 +113,104 @@ MLIRContext *initializeContext() {
 void deleteContext(MLIRContext *context) { delete context; }
 void deleteJitEngine(ExecutionEngine *jit) { delete jit; }
 
+/// @brief Number of launches after which a kernel is considered hot and an
+/// optimized engine is compiled for it, unless overridden by the
+/// `CUDAQ_BUILDER_JIT_TIER_THRESHOLD` environment variable (0 disables it).
+static constexpr std::size_t defaultJitTierThreshold = 10;
+
+static std::size_t getJitTierThreshold() {
+  // Not cached, so that it can be changed at run time, e.g. by tests.
+  if (auto *envVal = std::getenv("CUDAQ_BUILDER_JIT_TIER_THRESHOLD"))
+    return std::strtoull(envVal, nullptr, 10);
+  return defaultJitTierThreshold;
+}
+
+/// @brief Return true if runs of single-qubit gates may be fused into one
+/// gate. Noise models attach channels to individual gates, and the tracer,
+/// used by `cudaq::draw` and resource counting, records the gates of the
+/// kernel as written, so the fusion is disabled under either.
+static bool canFuseSingleQubitGates() {
+  auto *ctx = cudaq::get_platform().get_exec_ctx();
+  return !ctx || (!ctx->noiseModel && ctx->name != "tracer");
+}
+
+/// @brief Tiered JIT state of a `kernel_builder`. The first compilation of the
+/// kernel runs without code generation optimizations, since those are too slow
+/// for large circuits. Once the kernel is hot, the same lowered module is
+/// compiled with optimizations on a background thread, and `jitCode` swaps the
+/// resulting engine in as soon as it is ready.
+struct JitTierState {
+  /// @brief Launches of the current kernel code since it was compiled.
+  std::size_t invocations = 0;
+
+  /// @brief True once the current kernel code needs no further tiering.
+  bool finished = true;
+
+  /// @brief Hash of the kernel module at builder generation
+  /// `hashedGeneration`, see `KernelOpBuilder`.
+  std::optional<std::size_t> hashedGeneration;
+  std::size_t moduleHash = 0;
+
+  /// @brief The LLVM dialect module the unoptimized engine was created from.
+  OwningOpRef<ModuleOp> loweredModule;
+
+  /// @brief Extra libraries the unoptimized engine was created with.
+  std::vector<std::string> extraLibPaths;
+
+  /// @brief The optimized engine, null if its compilation failed.
+  std::future<std::unique_ptr<ExecutionEngine>> optimized;
+
+  /// @brief Engines replaced by an optimized one. They own the `argsCreator`
+  /// registered by their `kernelRegFunc` and may still be executing on another
+  /// thread, even after the kernel code changed, so they live as long as the
+  /// builder does. There is at most one per compiled kernel code.
+  std::vector<std::unique_ptr<ExecutionEngine>> retired;
+
+  /// @brief Drop any pending optimized engine, blocking until its background
+  /// compilation has completed.
+  void discardOptimized() {
+    if (optimized.valid())
+      optimized.get();
+  }
+
+  /// @brief Start over for newly compiled (unoptimized) kernel code.
+  void reset(OwningOpRef<ModuleOp> module, std::vector<std::string> libs) {
+    discardOptimized();
+    invocations = 0;
+    finished = !module;
+    loweredModule = std::move(module);
+    extraLibPaths = std::move(libs);
+  }
+
+  ~JitTierState() { discardOptimized(); }
+};
+
+JitTierState *createJitTierState() { return new JitTierState; }
+void deleteJitTierState(JitTierState *tier) { delete tier; }
+
+/// @brief The `ImplicitLocOpBuilder` of a `kernel_builder`. It counts the
+/// operations and blocks it inserts, i.e., the changes to the kernel, so that
+/// `jitCode` does not have to hash the kernel module again on every launch.
+/// Functions that clone other kernels into the module always insert the call
+/// through this builder as well.
+class KernelOpBuilder : public ImplicitLocOpBuilder,
+                        private OpBuilder::Listener {
+public:
+  KernelOpBuilder(Location loc, MLIRContext *context)
+      : ImplicitLocOpBuilder(loc, context) {
+    setListener(this);
+  }
+
+  /// @brief Return the number of changes made through this builder.
+  std::size_t getGeneration() const { return generation; }
+
+private:
+  void notifyOperationInserted(Operation *) override { ++generation; }
+  void notifyBlockCreated(Block *) override { ++generation; }
+
+  std::size_t generation = 0;
+};
+
 ImplicitLocOpBuilder *
 initializeBuilder(MLIRContext *context,
                   std::vector<KernelBuilderType> &inputTypes,
@@ -114,7 +218,7 @@ initializeBuilder(MLIRContext *context,
   cudaq::info("Creating the MLIR ImplicitOpBuilder.");
 
   auto location = FileLineColLoc::get(context, "<builder>", 1, 1);
-  auto *opBuilder = new ImplicitLocOpBuilder(location, context);
+  auto *opBuilder = new KernelOpBuilder(location, context);
 
   auto moduleOp = opBuilder->create<ModuleOp>();
   opBuilder->setInsertionPointToEnd(moduleOp.getBody());
@@ -152,7 +256,9 @@ initializeBuilder(MLIRContext *context,
   opBuilder->setInsertionPoint(terminator);
   return opBuilder;
 }
-void deleteBuilder(ImplicitLocOpBuilder *builder) { delete builder; }
+void deleteBuilder(ImplicitLocOpBuilder *builder) {
+  delete static_cast<KernelOpBuilder *>(builder);
+}
 
 bool isArgStdVec(std::vector<QuakeValue> &args, std::size_t idx) {
   return args[idx].isStdVec();
@@ -748,10 +854,114 @@ void tagEntryPoint(ImplicitLocOpBuilder &builder, ModuleOp &module,
   });
 }
 
+/// @brief Translate the lowered kernel module to LLVM IR for the JIT.
+static std::unique_ptr<llvm::Module>
+buildLLVMModule(Operation *module, llvm::LLVMContext &llvmContext) {
+  llvmContext.setOpaquePointers(false);
+  auto llvmModule = translateModuleToLLVMIR(module, llvmContext);
+  if (!llvmModule) {
+    llvm::errs() << "Failed to emit LLVM IR\n";
+    return nullptr;
+  }
+  ExecutionEngine::setupTargetTriple(llvmModule.get());
+  return llvmModule;
+}
+
+/// @brief Create an optimized `ExecutionEngine` from the LLVM bitcode of a
+/// lowered kernel module. This runs on a background thread, the bitcode is
+/// emitted up front so that the shared `MLIRContext` is not touched here.
+/// Return null on failure, the caller then keeps the unoptimized engine.
+static std::unique_ptr<ExecutionEngine>
+createOptimizedEngine(Operation *module, std::string bitcode,
+                      std::vector<std::string> extraLibPaths) {
+  ExecutionEngineOptions opts;
+  opts.transformer = makeOptimizingTransformer(
+      /*optLevel=*/2, /*sizeLevel=*/0, /*targetMachine=*/nullptr);
+  opts.jitCodeGenOptLevel = llvm::CodeGenOpt::Default;
+  SmallVector<StringRef, 4> sharedLibs(extraLibPaths.begin(),
+                                       extraLibPaths.end());
+  opts.sharedLibPaths = sharedLibs;
+  opts.llvmModuleBuilder =
+      [&bitcode](Operation *, llvm::LLVMContext &llvmContext)
+      -> std::unique_ptr<llvm::Module> {
+    llvmContext.setOpaquePointers(false);
+    auto llvmModule = llvm::parseBitcodeFile(
+        llvm::MemoryBufferRef(bitcode, "kernel_builder"), llvmContext);
+    if (!llvmModule) {
+      llvm::consumeError(llvmModule.takeError());
+      return nullptr;
+    }
+    return std::move(*llvmModule);
+  };
+
+  auto jitOrError = ExecutionEngine::create(module, opts);
+  if (!jitOrError) {
+    llvm::consumeError(jitOrError.takeError());
+    return nullptr;
+  }
+  return std::move(*jitOrError);
+}
+
+/// @brief Count a launch of the unchanged kernel code compiled into `jit`.
+/// Start compiling the optimized engine once the kernel is hot, and return it
+/// in place of `jit` once it is ready. The replaced engine is retired into the
+/// tier state.
+static ExecutionEngine *
+promoteJitTier(JitTierState *tier, ExecutionEngine *jit,
+               std::unordered_map<ExecutionEngine *, std::size_t> &jitHash) {
+  if (!tier || tier->finished)
+    return jit;
+
+  if (!tier->optimized.valid()) {
+    if (++tier->invocations < getJitTierThreshold())
+      return jit;
+
+    std::string bitcode;
+    {
+      llvm::LLVMContext llvmContext;
+      auto llvmModule = buildLLVMModule(*tier->loweredModule, llvmContext);
+      if (!llvmModule) {
+        tier->finished = true;
+        return jit;
+      }
+      llvm::raw_string_ostream os(bitcode);
+      llvm::WriteBitcodeToFile(*llvmModule, os);
+    }
+    cudaq::info("kernel_builder compiling an optimized engine after {} "
+                "launches.",
+                tier->invocations);
+    tier->optimized =
+        std::async(std::launch::async, createOptimizedEngine,
+                   tier->loweredModule->getOperation(), std::move(bitcode),
+                   tier->extraLibPaths);
+    return jit;
+  }
+
+  if (tier->optimized.wait_for(std::chrono::seconds(0)) !=
+      std::future_status::ready)
+    return jit;
+
+  tier->finished = true;
+  auto optimized = tier->optimized.get();
+  if (!optimized) {
+    cudaq::info("kernel_builder failed to create the optimized engine, "
+                "keeping the unoptimized one.");
+    return jit;
+  }
+
+  cudaq::info("- Optimized JIT Engine swapped in.");
+  auto *optimizedJit = optimized.release();
+  jitHash.insert({optimizedJit, jitHash[jit]});
+  jitHash.erase(jit);
+  tier->retired.emplace_back(jit);
+  return optimizedJit;
+}
+
 std::tuple<bool, ExecutionEngine *>
 jitCode(ImplicitLocOpBuilder &builder, ExecutionEngine *jit,
         std::unordered_map<ExecutionEngine *, std::size_t> &jitHash,
-        std::string kernelName, std::vector<std::string> extraLibPaths) {
+        std::string kernelName, std::vector<std::string> extraLibPaths,
+        JitTierState *tier) {
 
   // Start of by getting the current ModuleOp
   auto *block = builder.getBlock();
@@ -759,12 +969,25 @@ jitCode(ImplicitLocOpBuilder &builder, ExecutionEngine *jit,
   auto *function = block->getParentOp();
   auto currentModule = function->getParentOfType<ModuleOp>();
 
-  // Create a unique hash from that ModuleOp
-  auto hash = llvm::hash_code{0};
-  currentModule.walk([&hash](Operation *op) {
-    hash = llvm::hash_combine(hash, OperationEquivalence::computeHash(op));
-  });
-  auto moduleHash = static_cast<size_t>(hash);
+  // Create a unique hash from that ModuleOp, unless the builder did not
+  // change it since it was last hashed.
+  auto generation = static_cast<KernelOpBuilder &>(builder).getGeneration();
+  std::size_t moduleHash = 0;
+  if (tier && tier->hashedGeneration == generation) {
+    moduleHash = tier->moduleHash;
+  } else {
+    auto hash = llvm::hash_code{0};
+    currentModule.walk([&hash](Operation *op) {
+      hash = llvm::hash_combine(hash, OperationEquivalence::computeHash(op));
+    });
+    moduleHash = static_cast<size_t>(hash);
+    if (tier) {
+      tier->hashedGeneration = generation;
+      tier->moduleHash = moduleHash;
+    }
+  }
+  bool fuseGates = canFuseSingleQubitGates();
+  moduleHash = llvm::hash_combine(moduleHash, fuseGates);
 
   if (jit) {
     // Have we added more instructions
@@ -772,7 +995,7 @@ jitCode(ImplicitLocOpBuilder &builder, ExecutionEngine *jit,
     // If so, we need to delete this JIT engine
     // and create a new one.
     if (moduleHash == jitHash[jit])
-      return std::make_tuple(false, jit);
+      return std::make_tuple(false, promoteJitTier(tier, jit, jitHash));
     else {
       // need to redo the jit, remove the old one
       jitHash.erase(jit);
@@ -781,7 +1004,8 @@ jitCode(ImplicitLocOpBuilder &builder, ExecutionEngine *jit,
 
   cudaq::info("kernel_builder running jitCode.");
 
-  auto module = currentModule.clone();
+  OwningOpRef<ModuleOp> ownedModule(currentModule.clone());
+  auto module = *ownedModule;
   auto ctx = module.getContext();
   SmallVector<mlir::NamedAttribute> names;
   names.emplace_back(mlir::StringAttr::get(ctx, kernelName),
@@ -804,6 +1028,8 @@ jitCode(ImplicitLocOpBuilder &builder, ExecutionEngine *jit,
   pm.addPass(cudaq::opt::createLoopNormalize());
   pm.addPass(cudaq::opt::createLoopUnroll());
   pm.addPass(createCanonicalizerPass());
+  if (fuseGates)
+    optPM.addPass(cudaq::opt::createFuseSingleQubitGates());
   optPM.addPass(cudaq::opt::createQuakeAddDeallocs());
   optPM.addPass(cudaq::opt::createQuakeAddMetadata());
   pm.addPass(createCanonicalizerPass());
@@ -849,18 +1075,7 @@ jitCode(ImplicitLocOpBuilder &builder, ExecutionEngine *jit,
     sharedLibs.push_back(lib);
   }
   opts.sharedLibPaths = sharedLibs;
-  opts.llvmModuleBuilder =
-      [](Operation *module,
-         llvm::LLVMContext &llvmContext) -> std::unique_ptr<llvm::Module> {
-    llvmContext.setOpaquePointers(false);
-    auto llvmModule = translateModuleToLLVMIR(module, llvmContext);
-    if (!llvmModule) {
-      llvm::errs() << "Failed to emit LLVM IR\n";
-      return nullptr;
-    }
-    ExecutionEngine::setupTargetTriple(llvmModule.get());
-    return llvmModule;
-  };
+  opts.llvmModuleBuilder = buildLLVMModule;
 
   cudaq::info(" - Creating the MLIR ExecutionEngine");
   auto jitOrError = ExecutionEngine::create(module, opts);
@@ -897,6 +1112,14 @@ jitCode(ImplicitLocOpBuilder &builder, ExecutionEngine *jit,
 
   // Map this JIT Engine to its unique hash integer.
   jitHash.insert({jit, moduleHash});
+
+  // Keep the lowered module around in case this kernel gets hot and is
+  // recompiled with optimizations.
+  if (tier) {
+    if (!getJitTierThreshold())
+      ownedModule = nullptr;
+    tier->reset(std::move(ownedModule), std::move(extraLibPaths));
+  }
   return std::make_tuple(true, jit);
 }
 
@@ -149,6 +149,18 @@ void deleteBuilder(mlir::ImplicitLocOpBuilder *builder);
 /// @brief Delete function for the JIT pointer, also given to the `unique_ptr`
 void deleteJitEngine(mlir::ExecutionEngine *jit);
 
+/// @brief Opaque tiered JIT state of a kernel, i.e. its invocation count and
+/// the optimized `ExecutionEngine` being compiled in the background.
+struct JitTierState;
+
+/// @brief Create the tiered JIT state, return the raw pointer which we'll wrap
+/// in an `unique_ptr`.
+JitTierState *createJitTierState();
+
+/// @brief Delete function for the tiered JIT state, also given to the
+/// `unique_ptr`. Waits for any pending background compilation.
+void deleteJitTierState(JitTierState *tier);
+
 /// @brief Allocate a single `qubit`
 QuakeValue qalloc(mlir::ImplicitLocOpBuilder &builder);
 
@@ -217,11 +229,13 @@ std::string name(std::string_view kernelName);
 void applyPasses(mlir::PassManager &);
 
 /// @brief Create the `ExecutionEngine` and return a raw pointer, which we will
-/// wrap in a `unique_ptr`
+/// wrap in a `unique_ptr`. The first compilation is unoptimized. Once the
+/// kernel is hot, the returned engine may be an optimized replacement of the
+/// given one, which is then retired into the `JitTierState` (not changed).
 std::tuple<bool, mlir::ExecutionEngine *>
 jitCode(mlir::ImplicitLocOpBuilder &, mlir::ExecutionEngine *,
         std::unordered_map<mlir::ExecutionEngine *, std::size_t> &, std::string,
-        std::vector<std::string>);
+        std::vector<std::string>, JitTierState * = nullptr);
 
 /// @brief Invoke the function with the given kernel name.
 void invokeCode(mlir::ImplicitLocOpBuilder &builder, mlir::ExecutionEngine *jit,
@@ -368,6 +382,11 @@ private:
   std::unordered_map<mlir::ExecutionEngine *, std::size_t>
       jitEngineToModuleHash;
 
+  /// @brief Tiered JIT state, tracks invocations of `jitEngine` and owns the
+  /// optimized engine compiled once this kernel is hot.
+  std::unique_ptr<details::JitTierState, void (*)(details::JitTierState *)>
+      jitTier;
+
   /// @brief Name of the CUDA Quantum kernel Quake function
   std::string kernelName = "__nvqpp__mlirgen____nvqppBuilderKernel";
 
@@ -393,7 +412,8 @@ public:
   kernel_builder(std::vector<details::KernelBuilderType> &types)
       : context(details::initializeContext(), details::deleteContext),
         opBuilder(nullptr, [](mlir::ImplicitLocOpBuilder *) {}),
-        jitEngine(nullptr, [](mlir::ExecutionEngine *) {}) {
+        jitEngine(nullptr, [](mlir::ExecutionEngine *) {}),
+        jitTier(details::createJitTierState(), details::deleteJitTierState) {
     auto *ptr =
         details::initializeBuilder(context.get(), types, arguments, kernelName);
     opBuilder = std::unique_ptr<mlir::ImplicitLocOpBuilder,
@@ -794,11 +814,17 @@ public:
   void jitCode(std::vector<std::string> extraLibPaths = {}) override {
     auto [wasChanged, ptr] =
         details::jitCode(*opBuilder, jitEngine.get(), jitEngineToModuleHash,
-                         kernelName, extraLibPaths);
+                         kernelName, extraLibPaths, jitTier.get());
     // If we had a jitEngine, but the code changed, delete the one we had.
     if (jitEngine && wasChanged)
       details::deleteJitEngine(jitEngine.release());
 
+    // The kernel is hot and an optimized engine replaced the one we had. The
+    // old engine is now owned by the tier state, since another thread may
+    // still be executing it.
+    if (jitEngine && ptr != jitEngine.get())
+      jitEngine.release();
+
     // Store for the next time if we haven't already
     if (!jitEngine)
       jitEngine = std::unique_ptr<mlir::ExecutionEngine,
@@ -263,8 +263,10 @@ void cudaq::registry::cudaqRegisterKernelName(const char *kernelName) {
 void cudaq::registry::cudaqRegisterArgsCreator(const char *name,
                                                char *rawFunctor) {
   std::unique_lock<std::shared_mutex> lock(globalRegistryMutex);
-  argsCreators.insert(
-      {std::string(name), reinterpret_cast<KernelArgsCreator>(rawFunctor)});
+  // Kernels that are JIT compiled again register the creator of their new
+  // engine, the previous engine may have been evicted from a JIT cache.
+  argsCreators.insert_or_assign(
+      std::string(name), reinterpret_cast<KernelArgsCreator>(rawFunctor));
 }
 
 void cudaq::registry::cudaqRegisterLambdaName(const char *name,
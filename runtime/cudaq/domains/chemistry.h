@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "chemistry/fermion_mapping.h"
 #include "chemistry/hwe.h"
 #include "chemistry/molecule.h"
 #include "chemistry/uccsd.h"
@@ -0,0 +1,325 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+#include "fermion_mapping.h"
+
+#ifdef CUDAQ_HAS_OPENMP
+#include <omp.h>
+#endif
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <unordered_map>
+
+namespace cudaq {
+namespace {
+
+/// @brief A Pauli string packed into 64-bit words. The first `numWords` words
+/// hold the X bits, the next `numWords` words the Z bits, X = Z = 1 encodes Y.
+using PackedPauli = std::vector<std::uint64_t>;
+
+struct PackedPauliHash {
+  std::size_t operator()(const PackedPauli &p) const noexcept {
+    std::size_t seed = p.size();
+    for (auto w : p)
+      seed ^= std::hash<std::uint64_t>{}(w) + 0x9e3779b97f4a7c15ULL +
+              (seed << 6) + (seed >> 2);
+    return seed;
+  }
+};
+
+/// @brief The packed term table, mapping Pauli strings to their coefficient.
+using TermTable =
+    std::unordered_map<PackedPauli, std::complex<double>, PackedPauliHash>;
+
+/// @brief A fermionic ladder operator mapped to qubits is the sum of two Pauli
+/// strings: `a_j = 1/2 (c_j + i d_j)` and `a^+_j = 1/2 (c_j - i d_j)`.
+struct MappedMode {
+  PackedPauli c;
+  PackedPauli d;
+};
+
+/// @brief Helper that multiplies packed Pauli strings and tracks the phase.
+class PauliAlgebra {
+  std::size_t numWords;
+
+public:
+  PauliAlgebra(std::size_t numQubits) : numWords((numQubits + 63) / 64) {}
+
+  PackedPauli identity() const { return PackedPauli(2 * numWords, 0); }
+
+  /// @brief Reset `p` to the identity, reusing its storage.
+  void reset(PackedPauli &p) const { p.assign(2 * numWords, 0); }
+
+  void set(PackedPauli &p, std::size_t qubit, char pauli) const {
+    auto word = qubit / 64;
+    auto mask = std::uint64_t(1) << (qubit % 64);
+    if (pauli == 'X' || pauli == 'Y')
+      p[word] ^= mask;
+    if (pauli == 'Z' || pauli == 'Y')
+      p[numWords + word] ^= mask;
+  }
+
+  /// @brief Set `out = lhs * rhs`, return the phase as a power of `i`.
+  int multiply(const PackedPauli &lhs, const PackedPauli &rhs,
+               PackedPauli &out) const {
+    // With P(x, z) = i^(x.z) X^x Z^z, the product is
+    // i^(x1.z1 + x2.z2 + 2 z1.x2 - x3.z3) P(x1 ^ x2, z1 ^ z2).
+    int phase = 0;
+    for (std::size_t w = 0; w < numWords; w++) {
+      auto x1 = lhs[w], z1 = lhs[numWords + w];
+      auto x2 = rhs[w], z2 = rhs[numWords + w];
+      auto x3 = x1 ^ x2, z3 = z1 ^ z2;
+      phase += std::popcount(x1 & z1) + std::popcount(x2 & z2) +
+               2 * std::popcount(z1 & x2) - std::popcount(x3 & z3);
+      out[w] = x3;
+      out[numWords + w] = z3;
+    }
+    return ((phase % 4) + 4) % 4;
+  }
+
+  /// @brief Convert to the binary symplectic form used by `spin_op`.
+  spin_op::spin_op_term toTerm(const PackedPauli &p,
+                               std::size_t numQubits) const {
+    spin_op::spin_op_term term(2 * numQubits);
+    for (std::size_t q = 0; q < numQubits; q++) {
+      auto mask = std::uint64_t(1) << (q % 64);
+      term[q] = p[q / 64] & mask;
+      term[q + numQubits] = p[numWords + q / 64] & mask;
+    }
+    return term;
+  }
+};
+
+/// @brief The Bravyi-Kitaev update set of mode `j`, i.e. the qubits that
+/// store a partial sum including the occupation of `j` (Fenwick tree).
+std::vector<std::size_t> updateSet(std::size_t j, std::size_t n) {
+  std::vector<std::size_t> indices;
+  for (auto idx = j + 1; idx <= n; idx += idx & (~idx + 1))
+    indices.push_back(idx - 1);
+  return indices;
+}
+
+/// @brief The qubits whose parity is the occupation of mode `j`.
+std::vector<std::size_t> occupationSet(std::size_t j) {
+  std::vector<std::size_t> indices{j};
+  auto idx = j + 1;
+  auto parent = idx & (idx - 1);
+  for (idx -= 1; idx != parent; idx &= idx - 1)
+    indices.push_back(idx - 1);
+  return indices;
+}
+
+/// @brief The qubits whose parity is the parity of the modes `0, ..., j - 1`.
+std::vector<std::size_t> paritySet(std::size_t j) {
+  std::vector<std::size_t> indices;
+  for (auto idx = j; idx > 0; idx &= idx - 1)
+    indices.push_back(idx - 1);
+  return indices;
+}
+
+std::vector<MappedMode> mapModes(const PauliAlgebra &algebra, std::size_t n,
+                                 fermion_mapping mapping) {
+  std::vector<MappedMode> modes(n);
+  for (std::size_t j = 0; j < n; j++) {
+    auto &[c, d] = modes[j];
+    c = algebra.identity();
+    d = algebra.identity();
+    if (mapping == fermion_mapping::jordan_wigner) {
+      for (std::size_t k = 0; k < j; k++) {
+        algebra.set(c, k, 'Z');
+        algebra.set(d, k, 'Z');
+      }
+      algebra.set(c, j, 'X');
+      algebra.set(d, j, 'Y');
+      continue;
+    }
+
+    // Bravyi-Kitaev: c_j = X_U(j) Z_P(j), d_j = Y_j X_U(j)\j Z_(P(j)^O(j))\j
+    for (auto k : updateSet(j, n)) {
+      algebra.set(c, k, 'X');
+      if (k != j)
+        algebra.set(d, k, 'X');
+    }
+    std::vector<bool> dParity(n);
+    for (auto k : paritySet(j)) {
+      algebra.set(c, k, 'Z');
+      dParity[k] = !dParity[k];
+    }
+    for (auto k : occupationSet(j))
+      dParity[k] = !dParity[k];
+    for (std::size_t k = 0; k < n; k++)
+      if (dParity[k] && k != j)
+        algebra.set(d, k, 'Z');
+    algebra.set(d, j, 'Y');
+  }
+  return modes;
+}
+
+/// @brief Accumulate `coeff * (O + O^+)` into `table`, where `O` is the product
+/// of the given ladder operators (`(mode, isCreation)` pairs). If `O` is
+/// Hermitian itself, pass `hermitian = true` to accumulate `coeff * O`.
+template <std::size_t N>
+void accumulate(const PauliAlgebra &algebra,
+                const std::vector<MappedMode> &modes,
+                const std::array<std::pair<std::size_t, bool>, N> &ladder,
+                double coeff, bool hermitian, TermTable &table,
+                std::array<PackedPauli, 2> &scratch) {
+  static constexpr std::array<std::complex<double>, 4> phases{
+      std::complex<double>{1., 0.}, {0., 1.}, {-1., 0.}, {0., -1.}};
+  // The term coefficient: 2^-N for the ladder operators, doubled for the
+  // Hermitian conjugate, which contributes the complex conjugate coefficient
+  // to every Pauli string.
+  auto scale = coeff / double(1u << N) * (hermitian ? 1. : 2.);
+  for (std::size_t choice = 0; choice < (1u << N); choice++) {
+    std::complex<double> c = scale;
+    auto *current = &scratch[0], *next = &scratch[1];
+    algebra.reset(*current);
+    algebra.reset(*next);
+    for (std::size_t k = 0; k < N; k++) {
+      auto [mode, isCreation] = ladder[k];
+      bool pickD = (choice >> k) & 1;
+      if (pickD)
+        c *= std::complex<double>(0., isCreation ? -1. : 1.);
+      auto phase = algebra.multiply(
+          *current, pickD ? modes[mode].d : modes[mode].c, *next);
+      c *= phases[phase];
+      std::swap(current, next);
+    }
+    auto &entry = table[*current];
+    entry += hermitian ? c : std::complex<double>(c.real(), 0.);
+  }
+}
+
+void merge(TermTable &into, TermTable &&from) {
+  for (auto &[term, coeff] : from)
+    into[term] += coeff;
+}
+} // namespace
+
+spin_op get_qubit_hamiltonian(const one_body_integrals &oneBody,
+                              const two_body_integals &twoBody,
+                              double constant, fermion_mapping mapping,
+                              double tolerance) {
+  if (oneBody.shape.size() != 2 || oneBody.shape[0] != oneBody.shape[1])
+    throw std::invalid_argument("one_body_integrals must be a square matrix.");
+  auto numOrbitals = oneBody.shape[0];
+  if (twoBody.shape.size() != 4 ||
+      std::any_of(twoBody.shape.begin(), twoBody.shape.end(),
+                  [&](std::size_t dim) { return dim != numOrbitals; }))
+    throw std::invalid_argument("two_body_integals shape does not match the "
+                                "one_body_integrals shape.");
+
+  auto numQubits = 2 * numOrbitals;
+  PauliAlgebra algebra(numQubits);
+  auto modes = mapModes(algebra, numQubits, mapping);
+
+  TermTable table;
+  table[algebra.identity()] += constant;
+
+  // One-body terms sum_pq h_pq a^+_p a_q, pairing (p, q) with its Hermitian
+  // conjugate (q, p).
+  {
+    std::array<PackedPauli, 2> scratch;
+    for (std::size_t p = 0; p < numOrbitals; p++)
+      for (std::size_t q = p; q < numOrbitals; q++) {
+        auto h = oneBody(p, q).real();
+        if (std::fabs(h) < tolerance)
+          continue;
+        for (std::size_t spin = 0; spin < 2; spin++)
+          accumulate<2>(algebra, modes,
+                        {{{2 * p + spin, true}, {2 * q + spin, false}}}, h,
+                        p == q, table, scratch);
+      }
+  }
+
+  // Two-body terms 1/2 sum_pqrs (ps|qr) a^+_p a^+_q a_r a_s, summed over the
+  // spins of the (p, s) and (q, r) pairs.
+  // Visit each unique chemist's notation integral (ij|kl), i >= j, k >= l,
+  // ij >= kl, once, and expand it to all index tuples it stands for. Of every
+  // operator and its Hermitian conjugate, only one is expanded into Pauli
+  // strings.
+  std::vector<std::pair<std::size_t, std::size_t>> pairs;
+  for (std::size_t i = 0; i < numOrbitals; i++)
+    for (std::size_t j = 0; j <= i; j++)
+      pairs.emplace_back(i, j);
+
+  std::int64_t numPairs = pairs.size();
+#ifdef CUDAQ_HAS_OPENMP
+#pragma omp parallel
+#endif
+  {
+    TermTable local;
+    std::array<PackedPauli, 2> scratch;
+#ifdef CUDAQ_HAS_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (std::int64_t ij = 0; ij < numPairs; ij++) {
+      auto [i, j] = pairs[ij];
+      for (std::int64_t kl = 0; kl <= ij; kl++) {
+        auto [k, l] = pairs[kl];
+        // (ij|kl) is twoBody(p = i, q = k, r = l, s = j).
+        auto integral = twoBody(i, k, l, j).real();
+        if (std::fabs(integral) < tolerance)
+          continue;
+
+        // All (p, q, r, s) with (ps|qr) == (ij|kl) by symmetry.
+        std::array<std::array<std::size_t, 4>, 8> tuples{{{i, k, l, j},
+                                                          {j, k, l, i},
+                                                          {i, l, k, j},
+                                                          {j, l, k, i},
+                                                          {k, i, j, l},
+                                                          {l, i, j, k},
+                                                          {k, j, i, l},
+                                                          {l, j, i, k}}};
+        std::sort(tuples.begin(), tuples.end());
+        auto last = std::unique(tuples.begin(), tuples.end());
+        for (auto iter = tuples.begin(); iter != last; ++iter) {
+          auto [p, q, r, s] = *iter;
+          // The Hermitian conjugate of a^+_p a^+_q a_r a_s is
+          // a^+_s a^+_r a_q a_p, expand only the smaller of the two.
+          std::array<std::size_t, 4> conjugate{s, r, q, p};
+          if (conjugate < *iter)
+            continue;
+          bool hermitian = conjugate == *iter;
+          for (std::size_t sigma = 0; sigma < 2; sigma++)
+            for (std::size_t tau = 0; tau < 2; tau++) {
+              auto ps = 2 * p + sigma, qt = 2 * q + tau, rt = 2 * r + tau,
+                   ss = 2 * s + sigma;
+              if (ps == qt || rt == ss)
+                continue;
+              std::array<std::pair<std::size_t, bool>, 4> ladder{
+                  {{ps, true}, {qt, true}, {rt, false}, {ss, false}}};
+              accumulate<4>(algebra, modes, ladder, 0.5 * integral, hermitian,
+                            local, scratch);
+            }
+        }
+      }
+    }
+#ifdef CUDAQ_HAS_OPENMP
+#pragma omp critical
+#endif
+    merge(table, std::move(local));
+  }
+
+  std::unordered_map<spin_op::spin_op_term, std::complex<double>> terms;
+  for (auto &[packed, coeff] : table)
+    if (std::abs(coeff) >= tolerance)
+      terms.emplace(algebra.toTerm(packed, numQubits), coeff);
+
+  if (terms.empty())
+    return spin_op(numQubits) * 0.0;
+  return spin_op(terms);
+}
+
+spin_op get_qubit_hamiltonian(const molecular_hamiltonian &molecule,
+                              fermion_mapping mapping, double tolerance) {
+  return get_qubit_hamiltonian(molecule.one_body, molecule.two_body,
+                               molecule.nuclear_repulsion, mapping, tolerance);
+}
+} // namespace cudaq
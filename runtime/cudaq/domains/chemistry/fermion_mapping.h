@@ -0,0 +1,41 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "cudaq/domains/chemistry/molecule.h"
+
+namespace cudaq {
+
+/// @brief The supported encodings of fermionic modes into qubits.
+enum class fermion_mapping { jordan_wigner, bravyi_kitaev };
+
+/// @brief Map the second quantized molecular Hamiltonian
+/// `H = constant + sum_pq h_pq a^+_p a_q + 1/2 sum_pqrs h_pqrs a^+_p a^+_q a_r
+/// a_s` to a `cudaq::spin_op` under the given fermion-to-qubit encoding.
+/// The integrals are given over spatial orbitals and follow the OpenFermion
+/// conventions, i.e. `twoBody(p, q, r, s)` is the chemist's notation integral
+/// `(ps|qr)`. Spin orbitals are interleaved, with `2p` the alpha and `2p + 1`
+/// the beta spin orbital of spatial orbital `p`. The integrals are assumed to
+/// be real and to exhibit the 8-fold permutational symmetry, only their real
+/// part is used. Terms with a coefficient magnitude below `tolerance` are
+/// dropped.
+spin_op
+get_qubit_hamiltonian(const one_body_integrals &oneBody,
+                      const two_body_integals &twoBody, double constant = 0.0,
+                      fermion_mapping mapping = fermion_mapping::jordan_wigner,
+                      double tolerance = 1e-12);
+
+/// @brief Map the second quantized Hamiltonian of the given molecule, i.e. its
+/// integrals and nuclear repulsion, to a `cudaq::spin_op` under the given
+/// fermion-to-qubit encoding.
+spin_op
+get_qubit_hamiltonian(const molecular_hamiltonian &molecule,
+                      fermion_mapping mapping = fermion_mapping::jordan_wigner,
+                      double tolerance = 1e-12);
+} // namespace cudaq
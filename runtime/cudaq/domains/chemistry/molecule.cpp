@@ -37,6 +37,11 @@ std::complex<double> &one_body_integrals::operator()(std::size_t p,
                    shape)(p, q);
 }
 
+std::complex<double> one_body_integrals::operator()(std::size_t p,
+                                                    std::size_t q) const {
+  return data.get()[p * shape[1] + q];
+}
+
 void one_body_integrals::dump() {
   std::cerr << xt::adapt(data.get(), shape[0] * shape[1], xt::no_ownership(),
                          shape)
@@ -58,6 +63,13 @@ std::complex<double> &two_body_integals::operator()(std::size_t p,
                    xt::no_ownership(), shape)(p, q, r, s);
 }
 
+std::complex<double> two_body_integals::operator()(std::size_t p,
+                                                   std::size_t q,
+                                                   std::size_t r,
+                                                   std::size_t s) const {
+  return data.get()[((p * shape[1] + q) * shape[2] + r) * shape[3] + s];
+}
+
 void two_body_integals::dump() {
   std::cerr << xt::adapt(data.get(), shape[0] * shape[1] * shape[2] * shape[3],
                          xt::no_ownership(), shape)
@@ -68,7 +80,7 @@ molecular_hamiltonian create_molecule(const molecular_geometry &geometry,
                                       const std::string &basis,
                                       int multiplicity, int charge,
                                       std::string driver) {
-  auto packageDriver = registry::get<MoleculePackageDriver>("pyscf");
+  auto packageDriver = registry::get<MoleculePackageDriver>(driver);
   if (!packageDriver)
     throw std::runtime_error("Invalid molecule package driver (" + driver +
                              ").");
@@ -79,7 +91,7 @@ molecular_hamiltonian
 create_molecule(const molecular_geometry &geometry, const std::string &basis,
                 int multiplicity, int charge, std::size_t n_active_electrons,
                 std::size_t n_active_orbitals, std::string driver) {
-  auto packageDriver = registry::get<MoleculePackageDriver>("pyscf");
+  auto packageDriver = registry::get<MoleculePackageDriver>(driver);
   if (!packageDriver)
     throw std::runtime_error("Invalid molecule package driver (" + driver +
                              ").");
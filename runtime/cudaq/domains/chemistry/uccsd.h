@@ -112,6 +112,74 @@ auto uccsd_num_parameters(std::size_t numElectrons, std::size_t numQubits) {
          doublesAlpha.size() + doublesBeta.size();
 }
 
+/// @brief The circuit constructions available for the UCCSD excitations.
+enum class uccsd_circuit {
+  /// @brief Exponentiate each Pauli string of each excitation with its own
+  /// basis change, CNOT ladder and `rz` rotation.
+  pauli_ladder,
+  /// @brief Apply each excitation as a single Givens rotation between its
+  /// occupied and virtual configurations (fermionic-excitation-based circuit).
+  /// CNOTs map the two configurations onto states that differ on a single
+  /// qubit, which is rotated by a controlled `ry`. The Jordan-Wigner parity of
+  /// the qubits in between the excitation indices is applied with `cz` gates.
+  fermionic_excitation
+};
+
+/// @brief The gate counts of a UCCSD ansatz circuit.
+struct uccsd_gate_counts {
+  /// @brief The number of emitted CNOT and CZ gates.
+  std::size_t cnots = 0;
+  /// @brief The number of emitted controlled `ry` rotations.
+  std::size_t controlled_rotations = 0;
+  /// @brief The number of CNOT gates once every `ry` with `k` controls is
+  /// decomposed into `2^k` CNOTs and uncontrolled rotations.
+  std::size_t decomposed_cnots = 0;
+  /// @brief The number of emitted single-qubit gates.
+  std::size_t single_qubit_gates = 0;
+};
+
+/// @brief Return the gate counts of the UCCSD ansatz for the given number of
+/// electrons and qubits, built with the given circuit construction.
+inline uccsd_gate_counts
+get_uccsd_gate_counts(std::size_t numElectrons, std::size_t numQubits,
+                      uccsd_circuit circuit = uccsd_circuit::pauli_ladder) {
+  auto [singlesAlpha, singlesBeta, doublesMixed, doublesAlpha, doublesBeta] =
+      get_uccsd_excitations(numElectrons, numQubits);
+  uccsd_gate_counts counts;
+  auto addSingle = [&](const std::vector<std::size_t> &excitation) {
+    auto [p, q] = std::minmax(excitation[0], excitation[1]);
+    if (circuit == uccsd_circuit::pauli_ladder) {
+      counts.cnots += 4 * (q - p);
+      counts.single_qubit_gates += 10;
+      return;
+    }
+    counts.cnots += 2 + 2 * (q - p - 1);
+    counts.controlled_rotations += 1;
+    counts.decomposed_cnots += 2;
+  };
+  auto addDouble = [&](const std::vector<std::size_t> &excitation) {
+    auto [i, j] = std::minmax(excitation[0], excitation[1]);
+    auto [a, b] = std::minmax(excitation[2], excitation[3]);
+    if (circuit == uccsd_circuit::pauli_ladder) {
+      counts.cnots += 8 * (j - i) + 16 * (b - a) + 16;
+      counts.single_qubit_gates += 44;
+      return;
+    }
+    counts.cnots += 6 + 2 * (j - i - 1) + 2 * (b - a - 1);
+    counts.controlled_rotations += 1;
+    counts.decomposed_cnots += 8;
+    counts.single_qubit_gates += 4;
+  };
+  for (auto *list : {&singlesAlpha, &singlesBeta})
+    for (auto &excitation : *list)
+      addSingle(excitation);
+  for (auto *list : {&doublesMixed, &doublesAlpha, &doublesBeta})
+    for (auto &excitation : *list)
+      addDouble(excitation);
+  counts.decomposed_cnots += counts.cnots;
+  return counts;
+}
+
 __qpu__ void singleExcitation(cudaq::qview<> qubits, std::size_t pOcc,
                               std::size_t qVirt, double theta) {
   // Y_p X_q
@@ -590,44 +658,128 @@ __qpu__ void uccsd(cudaq::qview<> qubits, const std::vector<double> &thetas,
                      thetas[thetaCounter++]);
 }
 
+/// @brief Apply the single excitation `pOcc -> qVirt` as a Givens rotation,
+/// see `uccsd_circuit::fermionic_excitation`. Equivalent to `singleExcitation`
+/// with 2 CNOTs and one controlled `ry` instead of `4 * |qVirt - pOcc|` CNOTs.
+template <typename Kernel>
+void singleFermionicExcitation(Kernel &kernel, QuakeValue &qubits,
+                               std::size_t pOcc, std::size_t qVirt,
+                               QuakeValue &theta) {
+  auto [p, q] = std::minmax(pOcc, qVirt);
+  double multiplier = pOcc < qVirt ? 1. : -1.;
+
+  // Map |1_p 0_q> to |1_p 1_q>, it then differs from |0_p 1_q> only on p.
+  kernel.template x<cudaq::ctrl>(qubits[p], qubits[q]);
+  for (std::size_t k = p + 1; k < q; k++)
+    kernel.template z<cudaq::ctrl>(qubits[k], qubits[p]);
+
+  kernel.template ry<cudaq::ctrl>(multiplier * theta, qubits[q], qubits[p]);
+
+  for (std::size_t k = p + 1; k < q; k++)
+    kernel.template z<cudaq::ctrl>(qubits[k], qubits[p]);
+  kernel.template x<cudaq::ctrl>(qubits[p], qubits[q]);
+}
+
+/// @brief Apply the double excitation `pOcc, qOcc -> rVirt, sVirt` as a Givens
+/// rotation, see `uccsd_circuit::fermionic_excitation`. Equivalent to
+/// `doubleExcitation` with 6 CNOTs and one triply controlled `ry`.
+template <typename Kernel>
+void doubleFermionicExcitation(Kernel &kernel, QuakeValue &qubits,
+                               std::size_t pOcc, std::size_t qOcc,
+                               std::size_t rVirt, std::size_t sVirt,
+                               QuakeValue &theta) {
+  auto [iOcc, jOcc] = std::minmax(pOcc, qOcc);
+  auto [aVirt, bVirt] = std::minmax(rVirt, sVirt);
+  double multiplier = (pOcc < qOcc) == (rVirt < sVirt) ? -1. : 1.;
+
+  // Map |1_i 1_j 0_a 0_b> to |1_i 0_j 1_a 0_b> and |0_i 0_j 1_a 1_b> to
+  // |0_i 0_j 1_a 0_b>, which differ only on i.
+  kernel.template x<cudaq::ctrl>(qubits[aVirt], qubits[bVirt]);
+  kernel.template x<cudaq::ctrl>(qubits[iOcc], qubits[jOcc]);
+  kernel.template x<cudaq::ctrl>(qubits[iOcc], qubits[aVirt]);
+  kernel.x(qubits[jOcc]);
+  kernel.x(qubits[bVirt]);
+  for (std::size_t k = iOcc + 1; k < jOcc; k++)
+    kernel.template z<cudaq::ctrl>(qubits[k], qubits[iOcc]);
+  for (std::size_t k = aVirt + 1; k < bVirt; k++)
+    kernel.template z<cudaq::ctrl>(qubits[k], qubits[iOcc]);
+
+  std::vector<QuakeValue> controls{qubits[jOcc], qubits[aVirt],
+                                   qubits[bVirt]};
+  auto angle = multiplier * theta;
+  auto target = qubits[iOcc];
+  kernel.template ry<cudaq::ctrl>(angle, controls, target);
+
+  for (std::size_t k = aVirt + 1; k < bVirt; k++)
+    kernel.template z<cudaq::ctrl>(qubits[k], qubits[iOcc]);
+  for (std::size_t k = iOcc + 1; k < jOcc; k++)
+    kernel.template z<cudaq::ctrl>(qubits[k], qubits[iOcc]);
+  kernel.x(qubits[bVirt]);
+  kernel.x(qubits[jOcc]);
+  kernel.template x<cudaq::ctrl>(qubits[iOcc], qubits[aVirt]);
+  kernel.template x<cudaq::ctrl>(qubits[iOcc], qubits[jOcc]);
+  kernel.template x<cudaq::ctrl>(qubits[aVirt], qubits[bVirt]);
+}
+
 template <typename Kernel>
 void uccsd(Kernel &kernel, QuakeValue &qubits, QuakeValue &thetas,
-           std::size_t numElectrons, std::size_t numQubits) {
+           std::size_t numElectrons, std::size_t numQubits,
+           uccsd_circuit circuit) {
 
   auto [singlesAlpha, singlesBeta, doublesMixed, doublesAlpha, doublesBeta] =
       get_uccsd_excitations(numElectrons, numQubits);
 
+  auto applySingle = [&](const std::vector<std::size_t> &excitation,
+                         QuakeValue &theta) {
+    if (circuit == uccsd_circuit::fermionic_excitation)
+      singleFermionicExcitation(kernel, qubits, excitation[0], excitation[1],
+                                theta);
+    else
+      singleExcitation(kernel, qubits, excitation[0], excitation[1], theta);
+  };
+  auto applyDouble = [&](const std::vector<std::size_t> &excitation,
+                         QuakeValue &theta) {
+    if (circuit == uccsd_circuit::fermionic_excitation)
+      doubleFermionicExcitation(kernel, qubits, excitation[0], excitation[1],
+                                excitation[2], excitation[3], theta);
+    else
+      doubleExcitation(kernel, qubits, excitation[0], excitation[1],
+                       excitation[2], excitation[3], theta);
+  };
+
   std::size_t thetaCounter = 0;
   for (auto i : cudaq::range(singlesAlpha.size())) {
     // FIXME fix const correctness on quake value
     auto theta = thetas[thetaCounter++];
-    singleExcitation(kernel, qubits, singlesAlpha[i][0], singlesAlpha[i][1],
-                     theta);
+    applySingle(singlesAlpha[i], theta);
   }
 
   for (auto i : cudaq::range(singlesBeta.size())) {
     auto theta = thetas[thetaCounter++];
-    singleExcitation(kernel, qubits, singlesBeta[i][0], singlesBeta[i][1],
-                     theta);
+    applySingle(singlesBeta[i], theta);
   }
 
   for (auto i : cudaq::range(doublesMixed.size())) {
     auto theta = thetas[thetaCounter++];
-    doubleExcitation(kernel, qubits, doublesMixed[i][0], doublesMixed[i][1],
-                     doublesMixed[i][2], doublesMixed[i][3], theta);
+    applyDouble(doublesMixed[i], theta);
   }
 
   for (auto i : cudaq::range(doublesAlpha.size())) {
     auto theta = thetas[thetaCounter++];
-    doubleExcitation(kernel, qubits, doublesAlpha[i][0], doublesAlpha[i][1],
-                     doublesAlpha[i][2], doublesAlpha[i][3], theta);
+    applyDouble(doublesAlpha[i], theta);
   }
 
   for (auto i : cudaq::range(doublesBeta.size())) {
     auto theta = thetas[thetaCounter++];
-    doubleExcitation(kernel, qubits, doublesBeta[i][0], doublesBeta[i][1],
-                     doublesBeta[i][2], doublesBeta[i][3], theta);
+    applyDouble(doublesBeta[i], theta);
   }
 }
 
+template <typename Kernel>
+void uccsd(Kernel &kernel, QuakeValue &qubits, QuakeValue &thetas,
+           std::size_t numElectrons, std::size_t numQubits) {
+  uccsd(kernel, qubits, thetas, numElectrons, numQubits,
+        uccsd_circuit::pauli_ladder);
+}
+
 } // namespace cudaq
@@ -9,12 +9,17 @@
 #pragma once
 
 #include "common/MeasureCounts.h"
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
+#include <memory>
 #include <queue>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace cudaq {
 
@@ -24,12 +29,37 @@ namespace cudaq {
 /// instance being provided and set.
 using QuantumTask = std::function<void()>;
 
+/// A StealableQuantumTask is not bound to a specific QPU. It may be executed by
+/// any queue of a work-stealing group and is passed the id of the QPU whose
+/// queue executes it.
+using StealableQuantumTask = std::function<void(std::size_t)>;
+
 /// The QuantumExecutionQueue provides a queue running on a
 /// separate thread from the main CUDA Quantum host thread that clients
 /// can submit execution tasks to, and these tasks will be executed
 /// (asynchronously from the calling thread) in the order they are submitted.
+///
+/// Queues can be joined into a work-stealing group. Stealable tasks are
+/// preferably run by the queue they were submitted to, but a queue that runs
+/// out of work steals the most recently submitted stealable task of the most
+/// loaded queue in its group.
 class QuantumExecutionQueue {
 public:
+  /// Counters describing the activity of a queue.
+  struct Statistics {
+    /// The number of tasks currently waiting in the queue.
+    std::size_t depth = 0;
+    /// The number of tasks executed by this queue's thread.
+    std::size_t executed = 0;
+    /// The number of executed tasks that were stolen from another queue.
+    std::size_t stolen = 0;
+    /// The total and maximum time executed tasks spent waiting in a queue.
+    std::chrono::nanoseconds totalWaitTime{0};
+    std::chrono::nanoseconds maxWaitTime{0};
+    /// The total time spent executing tasks.
+    std::chrono::nanoseconds totalRunTime{0};
+  };
+
   /// The Constructor
   QuantumExecutionQueue();
   /// The Destructor
@@ -38,18 +68,65 @@ public:
   /// Enqueue a Sampling task.
   void enqueue(QuantumTask &task);
 
+  /// Enqueue a task that may be stolen by the other queues of this queue's
+  /// work-stealing group.
+  void enqueueStealable(StealableQuantumTask &task);
+
+  /// Set the id of the QPU this queue executes for, which is passed to the
+  /// stealable tasks it executes.
+  void setQpuId(std::size_t id) { qpuId = id; }
+
+  /// Set a function that this queue's thread runs before each stealable task
+  /// it executes, stolen or not, e.g. to select the device of its QPU.
+  void setStealableTaskSetup(std::function<void()> setup);
+
+  /// Return the id of this queue, unique for the lifetime of the process.
+  std::size_t getId() const { return id; }
+
+  /// Join the given queues into one work-stealing group, removing them from
+  /// any group they previously belonged to.
+  static void formStealingGroup(const std::vector<QuantumExecutionQueue *> &);
+
+  /// Return the number of tasks currently waiting in this queue.
+  std::size_t depth() const;
+
+  /// Return the activity counters of this queue.
+  Statistics getStatistics() const;
+
   /// Get id of the thread this queue executes on.
   std::thread::id getExecutionThreadId() const;
 
 protected:
+  using Clock = std::chrono::steady_clock;
+
+  /// A queued task together with its submission time.
+  struct QueuedTask {
+    StealableQuantumTask task;
+    Clock::time_point enqueued;
+  };
+
+  /// The set of queues stealing work from each other, defined in the
+  /// implementation.
+  struct StealingGroup;
+
+  /// The unique id of this queue.
+  const std::size_t id;
+
   /// The mutex, used for locking when adding to the queue
-  std::mutex lock;
+  mutable std::mutex lock;
 
   /// The thread this queue executes on
   std::thread thread;
 
   /// The execution queue
-  std::queue<QuantumTask> queue;
+  std::queue<QueuedTask> queue;
+
+  /// The tasks of this queue that other queues may steal, executed in
+  /// submission order by this queue and stolen from the back.
+  std::deque<QueuedTask> stealable;
+
+  /// The work-stealing group of this queue, if any.
+  std::shared_ptr<StealingGroup> group;
 
   /// The condition variable used for notifying listeners
   std::condition_variable cv;
@@ -57,6 +134,25 @@ protected:
   /// Should we quit this thread?
   bool quit = false;
 
+  /// The id of the QPU this queue executes for.
+  std::atomic<std::size_t> qpuId = 0;
+
+  /// Activity counters, guarded by `lock`.
+  Statistics stats;
+
+  /// Run before each stealable task this queue executes, guarded by `lock`.
+  std::function<void()> stealableTaskSetup;
+
+  /// Leave the current work-stealing group, if any.
+  void leaveStealingGroup();
+
+  /// Try to steal a task from another queue of the group. Must be called
+  /// without holding `lock`.
+  bool trySteal(QueuedTask &stolen);
+
+  /// Wake up this queue's thread, e.g. when work to steal became available.
+  void notify();
+
   /// Main execution thread, loops until destruction,
   /// continuously pops tasks off the queue and executes them
   void handler(void);
@@ -7,14 +7,30 @@
  ******************************************************************************/
 
 #include "cudaq/platform/QuantumExecutionQueue.h"
+#include <algorithm>
+#include <shared_mutex>
 
 namespace cudaq {
 
-QuantumExecutionQueue::QuantumExecutionQueue() : lock() {
+/// The queues of a work-stealing group. The group mutex is always acquired
+/// before the mutex of any of its member queues.
+struct QuantumExecutionQueue::StealingGroup {
+  std::shared_mutex mutex;
+  std::vector<QuantumExecutionQueue *> members;
+  /// The number of stealable tasks waiting in any of the member queues.
+  std::atomic<std::size_t> pending = 0;
+};
+
+static std::atomic<std::size_t> nextQueueId = 0;
+
+QuantumExecutionQueue::QuantumExecutionQueue() : id(nextQueueId++), lock() {
   thread = std::thread(&QuantumExecutionQueue::handler, this);
 }
 
 QuantumExecutionQueue::~QuantumExecutionQueue() {
+  // Leave the group first so that no peer steals from or notifies this queue
+  // while it is being destroyed.
+  leaveStealingGroup();
   std::unique_lock<std::mutex> l(lock);
   quit = true;
   cv.notify_all();
@@ -26,11 +42,132 @@ QuantumExecutionQueue::~QuantumExecutionQueue() {
 
 void QuantumExecutionQueue::enqueue(QuantumTask &t) {
   std::unique_lock<std::mutex> l(lock);
-  queue.push(t);
+  queue.push({[t](std::size_t) { t(); }, Clock::now()});
   cv.notify_one();
   return;
 }
 
+void QuantumExecutionQueue::enqueueStealable(StealableQuantumTask &t) {
+  std::unique_lock<std::mutex> l(lock);
+  stealable.push_back({t, Clock::now()});
+  auto currentGroup = group;
+  if (currentGroup)
+    currentGroup->pending++;
+  cv.notify_one();
+  l.unlock();
+
+  if (!currentGroup)
+    return;
+
+  // Wake up the idle peers, one of them may steal this task.
+  std::shared_lock<std::shared_mutex> groupLock(currentGroup->mutex);
+  for (auto *member : currentGroup->members)
+    if (member != this)
+      member->notify();
+}
+
+void QuantumExecutionQueue::setStealableTaskSetup(
+    std::function<void()> setup) {
+  std::lock_guard<std::mutex> l(lock);
+  stealableTaskSetup = std::move(setup);
+}
+
+void QuantumExecutionQueue::notify() {
+  // Acquire the lock so that a waiting handler cannot miss the notification
+  // between evaluating its wait predicate and going to sleep.
+  { std::lock_guard<std::mutex> l(lock); }
+  cv.notify_one();
+}
+
+void QuantumExecutionQueue::formStealingGroup(
+    const std::vector<QuantumExecutionQueue *> &queues) {
+  for (auto *q : queues)
+    q->leaveStealingGroup();
+
+  auto newGroup = std::make_shared<StealingGroup>();
+  {
+    std::unique_lock<std::shared_mutex> groupLock(newGroup->mutex);
+    for (auto *q : queues) {
+      std::lock_guard<std::mutex> l(q->lock);
+      q->group = newGroup;
+      newGroup->members.push_back(q);
+      newGroup->pending += q->stealable.size();
+    }
+  }
+
+  // Queues with an empty backlog may now steal existing work.
+  for (auto *q : queues)
+    q->notify();
+}
+
+void QuantumExecutionQueue::leaveStealingGroup() {
+  std::shared_ptr<StealingGroup> currentGroup;
+  {
+    std::lock_guard<std::mutex> l(lock);
+    currentGroup = group;
+  }
+  if (!currentGroup)
+    return;
+
+  std::unique_lock<std::shared_mutex> groupLock(currentGroup->mutex);
+  std::lock_guard<std::mutex> l(lock);
+  auto &members = currentGroup->members;
+  members.erase(std::remove(members.begin(), members.end(), this),
+                members.end());
+  currentGroup->pending -= stealable.size();
+  group.reset();
+}
+
+bool QuantumExecutionQueue::trySteal(QueuedTask &stolen) {
+  std::shared_ptr<StealingGroup> currentGroup;
+  {
+    std::lock_guard<std::mutex> l(lock);
+    currentGroup = group;
+  }
+  if (!currentGroup || currentGroup->pending == 0)
+    return false;
+
+  std::shared_lock<std::shared_mutex> groupLock(currentGroup->mutex);
+
+  // Find the peer with the largest stealable backlog.
+  QuantumExecutionQueue *victim = nullptr;
+  std::size_t largest = 0;
+  for (auto *member : currentGroup->members) {
+    if (member == this)
+      continue;
+    std::lock_guard<std::mutex> l(member->lock);
+    if (member->stealable.size() > largest) {
+      largest = member->stealable.size();
+      victim = member;
+    }
+  }
+  if (!victim)
+    return false;
+
+  // Take the most recently submitted task, the victim keeps working through
+  // its backlog from the front.
+  std::lock_guard<std::mutex> l(victim->lock);
+  if (victim->stealable.empty())
+    return false;
+  stolen = std::move(victim->stealable.back());
+  victim->stealable.pop_back();
+  currentGroup->pending--;
+  return true;
+}
+
+std::size_t QuantumExecutionQueue::depth() const {
+  std::lock_guard<std::mutex> l(lock);
+  return queue.size() + stealable.size();
+}
+
+QuantumExecutionQueue::Statistics
+QuantumExecutionQueue::getStatistics() const {
+  std::lock_guard<std::mutex> l(lock);
+  auto result = stats;
+  result.depth = queue.size() + stealable.size();
+  return result;
+}
+
 std::thread::id QuantumExecutionQueue::getExecutionThreadId() const {
   return thread.get_id();
 }
@@ -39,21 +176,65 @@ void QuantumExecutionQueue::handler(void) {
   std::unique_lock<std::mutex> l(lock);
 
   do {
-    // Wait until we have data or a quit signal
-    cv.wait(l, [this] { return (queue.size() || quit); });
+    // Wait until we have data, work to steal, or a quit signal
+    cv.wait(l, [this] {
+      return quit || !queue.empty() || !stealable.empty() ||
+             (group && group->pending > 0);
+    });
 
     // after wait, we own the lock
-    if (!quit && queue.size()) {
+    if (quit)
+      break;
 
-      auto op = std::move(queue.front());
+    QueuedTask op;
+    bool wasStolen = false;
+    bool isStealable = true;
+    if (!queue.empty()) {
+      op = std::move(queue.front());
       queue.pop();
-
-      // unlock now that we're done messing with the queue
+      isStealable = false;
+    } else if (!stealable.empty()) {
+      op = std::move(stealable.front());
+      stealable.pop_front();
+      if (group)
+        group->pending--;
+    } else {
+      // Nothing of our own to do, try to take work from a peer.
       l.unlock();
-
-      op();
+      wasStolen = trySteal(op);
       l.lock();
+      if (!wasStolen) {
+        // The pending work was picked up by someone else, back off briefly
+        // rather than spinning on the group counter.
+        cv.wait_for(l, std::chrono::microseconds(50));
+        continue;
+      }
     }
+
+    // Stealable tasks bypass the QPU's enqueue, set up the QPU here instead.
+    auto setup = isStealable ? stealableTaskSetup : std::function<void()>();
+
+    // unlock now that we're done messing with the queue
+    l.unlock();
+
+    auto start = Clock::now();
+    if (setup)
+      setup();
+    op.task(qpuId);
+    auto end = Clock::now();
+
+    l.lock();
+    auto waited = start - op.enqueued;
+    stats.executed++;
+    if (wasStolen)
+      stats.stolen++;
+    stats.totalWaitTime +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(waited);
+    stats.maxWaitTime =
+        std::max(stats.maxWaitTime,
+                 std::chrono::duration_cast<std::chrono::nanoseconds>(waited));
+    stats.totalRunTime +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
   } while (!quit);
 }
 
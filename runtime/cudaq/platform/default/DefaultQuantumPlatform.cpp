@@ -41,22 +41,29 @@ public:
   void setExecutionContext(cudaq::ExecutionContext *context) override {
     cudaq::ScopedTrace trace("DefaultPlatform::setExecutionContext",
                              context->name);
-    executionContext = context;
+    threadExecutionContext = context;
     if (noiseModel)
-      executionContext->noiseModel = noiseModel;
+      threadExecutionContext->noiseModel = noiseModel;
 
-    cudaq::getExecutionManager()->setExecutionContext(executionContext);
+    cudaq::getExecutionManager()->setExecutionContext(threadExecutionContext);
   }
 
   /// Overrides resetExecutionContext to forward to
   /// the ExecutionManager. Also handles observe post-processing
   void resetExecutionContext() override {
     cudaq::ScopedTrace trace("DefaultPlatform::resetExecutionContext",
-                             executionContext->name);
-    handleObservation(executionContext);
+                             threadExecutionContext->name);
+    handleObservation(threadExecutionContext);
     cudaq::getExecutionManager()->resetExecutionContext();
-    executionContext = nullptr;
+    threadExecutionContext = nullptr;
   }
+
+private:
+  /// The execution context of the calling thread. Execution managers and
+  /// simulators are thread-local, hence threads can execute kernels on this
+  /// QPU concurrently, each in its own context.
+  inline static thread_local cudaq::ExecutionContext *threadExecutionContext =
+      nullptr;
 };
 
 constexpr char platformQPU[] = "PLATFORM_QPU";
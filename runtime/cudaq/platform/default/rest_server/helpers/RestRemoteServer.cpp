@@ -7,11 +7,13 @@
  ******************************************************************************/
 
 #include "common/JIT.h"
+#include "common/JITCache.h"
 #include "common/JsonConvert.h"
 #include "common/Logger.h"
 #include "common/PluginUtils.h"
 #include "common/RemoteKernelExecutor.h"
 #include "common/RuntimeMLIR.h"
+#include "common/WireFormat.h"
 #include "cudaq.h"
 #include "cudaq/Optimizer/Builder/Runtime.h"
 #include "cudaq/Optimizer/CodeGen/Passes.h"
@@ -23,6 +25,7 @@
 #include "nvqir/CircuitSimulator.h"
 #include "server_impl/RestServer.h"
 #include "llvm/ADT/ScopeExit.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IRReader/IRReader.h"
 #include "llvm/Support/Base64.h"
@@ -30,6 +33,7 @@
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/PrettyStackTrace.h"
+#include "llvm/Support/SHA256.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/ToolOutputFile.h"
@@ -47,9 +51,14 @@
 #include "mlir/Target/LLVMIR/Export.h"
 #include "mlir/Tools/mlir-translate/Translation.h"
 #include "mlir/Transforms/Passes.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <streambuf>
+#include <thread>
 
 extern "C" {
 void __nvqir__setCircuitSimulator(nvqir::CircuitSimulator *);
@@ -63,6 +72,59 @@ struct SimulatorHandle {
   void *libHandle;
 };
 
+// Fixed-size pool of threads executing tasks in submission order.
+class WorkerPool {
+  std::vector<std::thread> m_workers;
+  std::deque<std::function<void()>> m_tasks;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_stopping = false;
+
+public:
+  WorkerPool(std::size_t numWorkers) {
+    for (std::size_t i = 0; i < numWorkers; ++i)
+      m_workers.emplace_back([this]() {
+        for (;;) {
+          std::function<void()> task;
+          {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [&]() { return m_stopping || !m_tasks.empty(); });
+            if (m_tasks.empty())
+              return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+          }
+          task();
+        }
+      });
+  }
+
+  ~WorkerPool() {
+    {
+      std::scoped_lock<std::mutex> lock(m_mutex);
+      m_stopping = true;
+    }
+    m_cv.notify_all();
+    for (auto &worker : m_workers)
+      worker.join();
+  }
+
+  // Submit a task, its result or exception is delivered via the future.
+  template <typename Callable>
+  std::future<std::invoke_result_t<Callable>> submit(Callable &&callable) {
+    using ResultType = std::invoke_result_t<Callable>;
+    auto task = std::make_shared<std::packaged_task<ResultType()>>(
+        std::forward<Callable>(callable));
+    auto future = task->get_future();
+    {
+      std::scoped_lock<std::mutex> lock(m_mutex);
+      m_tasks.emplace_back([task]() { (*task)(); });
+    }
+    m_cv.notify_one();
+    return future;
+  }
+};
+
 // Implementation of llvm::cantFail which throws a C++ exception rather than
 // emits a signal/asserts.
 template <typename T>
@@ -86,8 +148,25 @@ class RemoteRestRuntimeServer : public cudaq::RemoteRuntimeServer {
     std::vector<std::string> passes;
   };
   std::unordered_map<std::size_t, CodeTransformInfo> m_codeTransform;
+  std::mutex m_codeTransformMutex;
+  std::atomic<std::size_t> m_requestCounter = 0;
   // Currently-loaded NVQIR simulator.
   SimulatorHandle m_simHandle;
+  // Worker-pool mode: requests are compiled and executed concurrently by
+  // separate pools of threads. Each execution worker has its own simulator
+  // instance, since simulators and execution managers are thread-local.
+  std::unique_ptr<WorkerPool> m_compilePool;
+  std::unique_ptr<WorkerPool> m_executionPool;
+  std::mutex m_simLoadMutex;
+  // Number of requests being handled and the limit beyond which requests are
+  // rejected with 503 Service Unavailable, i.e., executing and queued ones.
+  std::atomic<std::size_t> m_pendingRequests = 0;
+  std::size_t m_maxPendingRequests = 0;
+  // JIT engines of recently requested MLIR kernels, keyed by the hash of their
+  // code and passes. Clients typically resend the same kernel many times,
+  // e.g., in variational loops.
+  cudaq::LRUCache<std::string, std::shared_ptr<ExecutionEngine>> m_jitCache{
+      cudaq::getJITCacheSize()};
   // Default backend for initialization.
   // Note: we always need to preload a default backend on the server runtime
   // since cudaq runtime relies on that.
@@ -97,13 +176,11 @@ protected:
   // Server to exit after each job request.
   // Note: this doesn't apply to ping ("/") endpoint.
   bool exitAfterJob = false;
-  // Time-point data
-  std::optional<std::chrono::time_point<std::chrono::high_resolution_clock>>
-      requestStart;
-  std::optional<std::chrono::time_point<std::chrono::high_resolution_clock>>
-      simulationStart;
-  std::optional<std::chrono::time_point<std::chrono::high_resolution_clock>>
-      simulationEnd;
+  // Time-point data of the request handled by the calling thread.
+  using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+  static inline thread_local std::optional<TimePoint> requestStart;
+  static inline thread_local std::optional<TimePoint> simulationStart;
+  static inline thread_local std::optional<TimePoint> simulationEnd;
 
   // Method to filter incoming request.
   // The request is only handled iff this returns true.
@@ -134,7 +211,32 @@ public:
     if (!portValid)
       throw std::runtime_error(
           "Invalid TCP/IP port requested. Valid range: [1024, 65535].");
-    m_server = std::make_unique<cudaq::RestServer>(m_port);
+    const auto getSizeConfig = [&](const std::string &key,
+                                   std::size_t defaultValue) {
+      const auto iter = configs.find(key);
+      return iter == configs.end() ? defaultValue : std::stoull(iter->second);
+    };
+    m_hasMpi = cudaq::mpi::is_initialized();
+    const std::size_t numWorkers = getSizeConfig("workers", 1);
+    if (numWorkers > 1 && (m_hasMpi || exitAfterJob)) {
+      // MPI ranks follow the requests of rank 0 in order, and one-shot
+      // servers only handle a single request.
+      cudaq::info("Ignoring the worker pool configuration, requests are "
+                  "handled sequentially by this server.");
+    } else if (numWorkers > 1) {
+      const std::size_t numCompileWorkers =
+          getSizeConfig("compile-workers", numWorkers);
+      const std::size_t queueSize = getSizeConfig("queue-size", 4 * numWorkers);
+      m_compilePool = std::make_unique<WorkerPool>(numCompileWorkers);
+      m_executionPool = std::make_unique<WorkerPool>(numWorkers);
+      m_maxPendingRequests = numWorkers + queueSize;
+      cudaq::info("Handling requests with {} execution and {} compilation "
+                  "workers, queueing up to {} requests.",
+                  numWorkers, numCompileWorkers, queueSize);
+    }
+    // Every pending request holds an HTTP thread while it is being handled.
+    m_server = std::make_unique<cudaq::RestServer>(
+        m_port, "cudaq", m_executionPool ? m_maxPendingRequests + 1 : 1);
     m_server->addRoute(
         cudaq::RestServer::Method::GET, "/",
         [](const std::string &reqBody,
@@ -150,6 +252,17 @@ public:
         [&](const std::string &reqBody,
             const std::unordered_multimap<std::string, std::string> &headers) {
           requestStart = std::chrono::high_resolution_clock::now();
+          // Apply backpressure when the request queue is full.
+          if (m_executionPool &&
+              ++m_pendingRequests > m_maxPendingRequests) {
+            --m_pendingRequests;
+            throw cudaq::RestServer::ServiceUnavailable(
+                "Server is busy, please retry later.");
+          }
+          auto releasePendingRequest = llvm::make_scope_exit([&] {
+            if (m_executionPool)
+              --m_pendingRequests;
+          });
           auto shutdownAfterHandlingRequest = llvm::make_scope_exit([&] {
             if (this->exitAfterJob)
               m_server->stop();
@@ -224,7 +337,6 @@ public:
           return resultJs;
         });
     m_mlirContext = cudaq::initializeMLIR();
-    m_hasMpi = cudaq::mpi::is_initialized();
   }
   // Start the server.
   virtual void start() override {
@@ -258,8 +370,18 @@ public:
                              void *kernelArgs, std::uint64_t argsSize,
                              std::size_t seed) override {
 
-    // If we're changing the backend, load the new simulator library from file.
-    if (m_simHandle.name != backendSimName) {
+    if (m_executionPool) {
+      // Each execution worker loads its own simulator instance. Libraries are
+      // never unloaded since other workers may still be using them.
+      thread_local std::string workerSimName;
+      if (workerSimName != backendSimName) {
+        std::scoped_lock<std::mutex> lock(m_simLoadMutex);
+        loadNvqirSimLib(backendSimName);
+        workerSimName = backendSimName;
+      }
+    } else if (m_simHandle.name != backendSimName) {
+      // If we're changing the backend, load the new simulator library from
+      // file.
       if (m_simHandle.libHandle)
         dlclose(m_simHandle.libHandle);
 
@@ -269,7 +391,10 @@ public:
     if (seed != 0)
       cudaq::set_random_seed(seed);
     auto &platform = cudaq::get_platform();
-    auto &requestInfo = m_codeTransform[reqId];
+    const auto requestInfo = [&]() {
+      std::scoped_lock<std::mutex> lock(m_codeTransformMutex);
+      return m_codeTransform[reqId];
+    }();
     if (requestInfo.format == cudaq::CodeFormat::LLVM) {
       if (io_context.name == "sample") {
         // In library mode (LLVM), check to see if we have mid-circuit measures
@@ -439,19 +564,53 @@ protected:
     return uniqueJit;
   }
 
-  void
-  invokeMlirKernel(std::unique_ptr<MLIRContext> &contextPtr,
-                   std::string_view irString,
-                   const std::vector<std::string> &passes,
-                   const std::string &entryPointFn, std::size_t numTimes = 1,
-                   std::function<void(std::size_t)> postExecCallback = {}) {
+  // Compile the kernel of a request ahead of its execution.
+  void compileRequest(cudaq::CodeFormat format, std::string_view ir,
+                      const std::string &kernelName,
+                      const std::vector<std::string> &passes) {
+    if (format == cudaq::CodeFormat::LLVM)
+      cudaq::compileWrappedKernel(ir, kernelName);
+    else
+      getOrCreateMlirEngine(m_mlirContext, ir, passes);
+  }
+
+  // Return the JIT engine of the given MLIR code, reusing the engine of a
+  // previous request with the same code and passes if there is one.
+  std::shared_ptr<ExecutionEngine>
+  getOrCreateMlirEngine(std::unique_ptr<MLIRContext> &contextPtr,
+                        std::string_view irString,
+                        const std::vector<std::string> &passes) {
+    llvm::SHA256 hasher;
+    hasher.update(llvm::StringRef(irString.data(), irString.size()));
+    for (const auto &pass : passes) {
+      hasher.update(llvm::StringRef("\0", 1));
+      hasher.update(pass);
+    }
+    const std::string key = llvm::toHex(hasher.final(), /*LowerCase=*/true);
+
+    if (auto engine = m_jitCache.lookup(key)) {
+      cudaq::info("Reusing the JIT engine of kernel {}.", key);
+      return *engine;
+    }
+
+    // The cache is not locked while compiling, so that workers can compile
+    // different kernels concurrently.
     llvm::SourceMgr sourceMgr;
     sourceMgr.AddNewSourceBuffer(llvm::MemoryBuffer::getMemBufferCopy(irString),
                                  llvm::SMLoc());
     auto module = parseSourceFile<ModuleOp>(sourceMgr, contextPtr.get());
     if (!module)
       throw std::runtime_error("Failed to parse the input MLIR code");
-    auto engine = jitMlirCode(*module, passes);
+    return m_jitCache.insert(key, jitMlirCode(*module, passes));
+  }
+
+  void
+  invokeMlirKernel(std::unique_ptr<MLIRContext> &contextPtr,
+                   std::string_view irString,
+                   const std::vector<std::string> &passes,
+                   const std::string &entryPointFn, std::size_t numTimes = 1,
+                   std::function<void(std::size_t)> postExecCallback = {}) {
+    auto engine = getOrCreateMlirEngine(contextPtr, irString, passes);
     const std::string entryPointFunc =
         std::string(cudaq::runtime::cudaqGenPrefixName) + entryPointFn;
     auto fnPtr =
@@ -532,10 +691,20 @@ protected:
     });
 
     try {
-      // IMPORTANT: This assumes the REST server handles incoming requests
-      // sequentially.
-      static std::size_t g_requestCounter = 0;
-      auto requestJson = json::parse(reqBody);
+      auto requestJson = cudaq::wire::isBinaryMessage(reqBody)
+                             ? cudaq::wire::decode(reqBody)
+                             : json::parse(reqBody);
+      // Binary messages carry the IR and the arguments as raw bytes rather
+      // than as a Base64 string and an array of numbers.
+      std::optional<std::vector<char>> rawCodeIr;
+      if (requestJson["code"].is_binary()) {
+        const auto &code = requestJson["code"].get_binary();
+        rawCodeIr.emplace(code.begin(), code.end());
+        requestJson["code"] = "";
+      }
+      if (requestJson["args"].is_binary())
+        requestJson["args"] =
+            std::vector<uint8_t>(requestJson["args"].get_binary());
       cudaq::RestRequest request(requestJson);
 
       std::ostringstream os;
@@ -569,22 +738,48 @@ protected:
         return resultJson;
       }
 
-      const auto reqId = g_requestCounter++;
-      m_codeTransform[reqId] =
-          CodeTransformInfo(request.format, request.passes);
+      const auto reqId = m_requestCounter++;
+      {
+        std::scoped_lock<std::mutex> lock(m_codeTransformMutex);
+        m_codeTransform[reqId] =
+            CodeTransformInfo(request.format, request.passes);
+      }
+      auto eraseCodeTransform = llvm::make_scope_exit([&] {
+        std::scoped_lock<std::mutex> lock(m_codeTransformMutex);
+        m_codeTransform.erase(reqId);
+      });
       std::vector<char> decodedCodeIr;
-      auto errorCode = llvm::decodeBase64(request.code, decodedCodeIr);
-      if (errorCode) {
+      if (rawCodeIr) {
+        decodedCodeIr = std::move(*rawCodeIr);
+      } else if (auto errorCode =
+                     llvm::decodeBase64(request.code, decodedCodeIr)) {
         LLVMConsumeError(llvm::wrap(std::move(errorCode)));
         throw std::runtime_error("Failed to decode input IR");
       }
       std::string_view codeStr(decodedCodeIr.data(), decodedCodeIr.size());
-      handleRequest(reqId, request.executionContext, request.simulator, codeStr,
-                    request.entryPoint, request.args.data(),
-                    request.args.size(), request.seed);
+      if (m_executionPool) {
+        // Compile on the compilation workers, so that execution workers only
+        // run simulations, hitting the JIT caches.
+        m_compilePool
+            ->submit([&]() {
+              compileRequest(request.format, codeStr, request.entryPoint,
+                             request.passes);
+            })
+            .get();
+        m_executionPool
+            ->submit([&]() {
+              handleRequest(reqId, request.executionContext, request.simulator,
+                            codeStr, request.entryPoint, request.args.data(),
+                            request.args.size(), request.seed);
+            })
+            .get();
+      } else {
+        handleRequest(reqId, request.executionContext, request.simulator,
+                      codeStr, request.entryPoint, request.args.data(),
+                      request.args.size(), request.seed);
+      }
       json resultJson;
       resultJson["executionContext"] = request.executionContext;
-      m_codeTransform.erase(reqId);
       return resultJson;
     } catch (std::exception &e) {
       json resultJson;
@@ -7,6 +7,7 @@
  ******************************************************************************/
 
 #include "RestServer.h"
+#include "common/WireFormat.h"
 
 #ifdef __clang__
 #pragma clang diagnostic push
@@ -34,7 +35,8 @@ struct cudaq::RestServer::impl {
   crow::SimpleApp app;
 };
 
-cudaq::RestServer::RestServer(int port, const std::string &name) {
+cudaq::RestServer::RestServer(int port, const std::string &name,
+                              std::size_t numThreads) {
   m_impl = std::make_unique<impl>();
   m_impl->app.port(port);
   m_impl->app.server_name(name);
@@ -44,15 +46,18 @@ cudaq::RestServer::RestServer(int port, const std::string &name) {
   // susceptible to corruption if the app is shut down right after handling a
   // request.
   m_impl->app.stream_threshold(0);
-  // Note: don't enable multi-threading (`m_impl->app.multithreaded()`) since
-  // we're handling requests sequentially.
+  // Note: only enable multi-threading if requested, route handlers must then
+  // be able to handle requests concurrently.
+  if (numThreads > 1)
+    m_impl->app.concurrency(static_cast<std::uint16_t>(numThreads));
 }
 void cudaq::RestServer::start() { m_impl->app.run(); }
 void cudaq::RestServer::stop() { m_impl->app.stop(); }
 cudaq::RestServer::~RestServer() = default;
 
 // Helper to invoke route handler: exceptions will be returned as 500 Internal
-// Server Error.
+// Server Error. Results are sent in the binary wire format to clients that
+// accept it, JSON otherwise.
 static inline crow::response
 invokeRouteHandler(const cudaq::RestServer::RouteHandler &handler,
                    const crow::request &req) {
@@ -61,7 +66,17 @@ invokeRouteHandler(const cudaq::RestServer::RouteHandler &handler,
     for (const auto &[k, v] : req.headers)
       headers.emplace(k, v);
 
-    return handler(req.body, headers).dump();
+    const auto result = handler(req.body, headers);
+    if (cudaq::wire::acceptsBinary(req.get_header_value("Accept"))) {
+      crow::response response(200, cudaq::wire::encode(result));
+      response.set_header("Content-Type", cudaq::wire::CONTENT_TYPE);
+      return response;
+    }
+    return result.dump();
+  } catch (cudaq::RestServer::ServiceUnavailable &e) {
+    crow::response response(503, e.what());
+    response.set_header("Retry-After", std::to_string(e.retryAfterSeconds));
+    return response;
   } catch (std::exception &e) {
     const std::string errorMsg =
         std::string("Unhandled exception encountered: ") + e.what();
@@ -10,6 +10,7 @@
 
 #include "nlohmann/json.hpp"
 #include <map>
+#include <stdexcept>
 #include <string>
 
 namespace cudaq {
@@ -27,8 +28,18 @@ public:
       const std::string &,
       const std::unordered_multimap<std::string, std::string> &)>;
   enum class Method { GET, POST };
-  // Create a REST server serving at a specific port.
-  RestServer(int port, const std::string &name = "cudaq");
+  // Exception that route handlers throw to reject a request with 503 Service
+  // Unavailable, e.g., when the server is overloaded. Clients are asked to
+  // retry after the given number of seconds.
+  struct ServiceUnavailable : public std::runtime_error {
+    int retryAfterSeconds;
+    ServiceUnavailable(const std::string &msg, int retryAfter = 1)
+        : std::runtime_error(msg), retryAfterSeconds(retryAfter) {}
+  };
+  // Create a REST server serving at a specific port. Requests are handled by
+  // `numThreads` threads, i.e., sequentially by default.
+  RestServer(int port, const std::string &name = "cudaq",
+             std::size_t numThreads = 1);
   // Add a route (endpoint) handler.
   void addRoute(Method routeMethod, const char *route, RouteHandler handler);
   // Start the server.
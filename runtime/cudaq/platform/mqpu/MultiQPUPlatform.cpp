@@ -144,7 +144,45 @@ public:
             fmt::format("Unable to retrieve {} QPU implementation. Please "
                         "check your installation.",
                         qpuSubType));
-      if (qpuSubType == "NvcfSimulatorQPU") {
+      if (qpuSubType == "CPUEmulatedQPU") {
+        // The number of QPUs is taken from the target option, the
+        // CUDAQ_MQPU_NQPUS environment variable, or defaults to one QPU per
+        // available CPU.
+        auto numQpusStr = getOpt(description, "nqpus");
+        if (numQpusStr.empty())
+          if (const char *envVal = std::getenv("CUDAQ_MQPU_NQPUS"))
+            numQpusStr = envVal;
+        int numQpus = cudaq::getAvailableCpuCount();
+        if (!numQpusStr.empty()) {
+          try {
+            numQpus = std::stoi(numQpusStr);
+          } catch (...) {
+            throw std::runtime_error(
+                "Invalid number of QPUs, must be an integer.");
+          }
+        }
+        if (numQpus < 1)
+          throw std::invalid_argument("Number of QPUs must be greater than 0.");
+
+        // Give each QPU its own slice of the CPUs.
+        const auto cpuSets = cudaq::partitionAvailableCpus(numQpus);
+        platformQPUs.clear();
+        for (int qpuId = 0; qpuId < numQpus; ++qpuId) {
+          auto qpu = cudaq::registry::get<cudaq::QPU>("CPUEmulatedQPU");
+          qpu->setId(qpuId);
+          if (!cpuSets[qpuId].empty()) {
+            std::string cpus;
+            for (auto cpu : cpuSets[qpuId])
+              cpus += (cpus.empty() ? "" : ",") + std::to_string(cpu);
+            qpu->setTargetBackend("cpus;" + cpus);
+          }
+          threadToQpuId[std::hash<std::thread::id>{}(
+              qpu->getExecutionThreadId())] = qpuId;
+          platformQPUs.emplace_back(std::move(qpu));
+        }
+        platformNumQPUs = platformQPUs.size();
+        platformCurrentQPU = 0;
+      } else if (qpuSubType == "NvcfSimulatorQPU") {
         platformQPUs.clear();
         auto simName = getOpt(description, "backend");
         if (simName.empty())
@@ -0,0 +1,117 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "common/ExecutionContext.h"
+#include "common/Logger.h"
+#include "common/NoiseModel.h"
+#include "cudaq/platform/qpu.h"
+#include "cudaq/platform/quantum_platform.h"
+#include "cudaq/qis/qubit_qis.h"
+#include "cudaq/spin_op.h"
+#include <mutex>
+#include <pthread.h>
+#include <sched.h>
+#ifdef CUDAQ_HAS_OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+/// @brief This QPU implementation enqueues kernel execution tasks on a
+/// dedicated thread, which is pinned to a set of CPU cores and limited to an
+/// OpenMP thread count matching that set. Each execution thread creates its own
+/// simulator instance, so that several CPUEmulatedQPUs can simulate kernels
+/// concurrently without oversubscribing the host.
+class CPUEmulatedQPU : public cudaq::QPU {
+protected:
+  std::map<std::size_t, cudaq::ExecutionContext *> contexts;
+  std::mutex contextsMutex;
+
+  /// @brief Pin the calling thread to the given CPUs and limit its OpenMP
+  /// parallel regions to as many threads.
+  static void pinCurrentThread(const std::vector<int> &cpus) {
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (auto cpu : cpus)
+      CPU_SET(cpu, &cpuSet);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) != 0)
+      cudaq::info("Unable to set the CPU affinity of the QPU thread.");
+#endif
+#ifdef CUDAQ_HAS_OPENMP
+    omp_set_num_threads(static_cast<int>(cpus.size()));
+#endif
+  }
+
+public:
+  CPUEmulatedQPU() : QPU(){};
+  CPUEmulatedQPU(std::size_t id) : QPU(id) {}
+
+  /// @brief Configure the CPUs this QPU executes on, given as
+  /// `cpus;<id>,<id>,...`. The execution thread is pinned before it runs any
+  /// other task.
+  void setTargetBackend(const std::string &backend) override {
+    auto parts = cudaq::split(backend, ';');
+    if (parts.size() != 2 || parts[0] != "cpus")
+      throw std::runtime_error("Invalid CPUEmulatedQPU configuration: " +
+                               backend);
+    std::vector<int> cpus;
+    for (auto &cpu : cudaq::split(parts[1], ','))
+      cpus.push_back(std::stoi(cpu));
+    if (cpus.empty())
+      return;
+
+    cudaq::info("CPU QPU {} executes on {} CPU(s) starting at CPU {}.", qpu_id,
+                cpus.size(), cpus.front());
+    cudaq::QuantumTask pinTask = [cpus]() { pinCurrentThread(cpus); };
+    execution_queue->enqueue(pinTask);
+  }
+
+  void enqueue(cudaq::QuantumTask &task) override {
+    cudaq::info("Enqueue Task on CPU QPU {}", qpu_id);
+    execution_queue->enqueue(task);
+  }
+
+  void launchKernel(const std::string &name, void (*kernelFunc)(void *),
+                    void *args, std::uint64_t, std::uint64_t) override {
+    cudaq::info("QPU::launchKernel CPU QPU {}", qpu_id);
+    kernelFunc(args);
+  }
+
+  /// Overrides setExecutionContext to forward it to the ExecutionManager
+  void setExecutionContext(cudaq::ExecutionContext *context) override {
+    cudaq::info("MultiQPUPlatform::setExecutionContext CPU QPU {}", qpu_id);
+    auto tid = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    {
+      std::scoped_lock lock(contextsMutex);
+      contexts[tid] = context;
+    }
+    if (noiseModel)
+      context->noiseModel = noiseModel;
+
+    cudaq::getExecutionManager()->setExecutionContext(context);
+  }
+
+  /// Overrides resetExecutionContext to forward to
+  /// the ExecutionManager. Also handles observe post-processing
+  void resetExecutionContext() override {
+    cudaq::info("MultiQPUPlatform::resetExecutionContext CPU QPU {}", qpu_id);
+    auto tid = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    cudaq::ExecutionContext *ctx = nullptr;
+    {
+      std::scoped_lock lock(contextsMutex);
+      ctx = contexts[tid];
+      contexts.erase(tid);
+    }
+    handleObservation(ctx);
+    cudaq::getExecutionManager()->resetExecutionContext();
+  }
+};
+} // namespace
+
+CUDAQ_REGISTER_TYPE(cudaq::QPU, CPUEmulatedQPU, CPUEmulatedQPU)
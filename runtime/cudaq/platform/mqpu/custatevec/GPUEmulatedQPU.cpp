@@ -37,6 +37,8 @@ public:
     execution_queue->enqueue(task);
   }
 
+  void prepareStealableTask() override { cudaSetDevice(qpu_id); }
+
   void launchKernel(const std::string &name, void (*kernelFunc)(void *),
                     void *args, std::uint64_t, std::uint64_t) override {
     cudaq::info("QPU::launchKernel GPU {}", qpu_id);
@@ -11,10 +11,12 @@
 #include "common/RestClient.h"
 #include "cudaq/utils/cudaq_utils.h"
 #include "llvm/Support/Program.h"
+#include <algorithm>
 #include <arpa/inet.h>
 #include <execinfo.h>
 #include <filesystem>
 #include <random>
+#include <sched.h>
 #include <signal.h>
 #include <sys/socket.h>
 #include <thread>
@@ -166,3 +168,48 @@ int cudaq::getCudaGetDeviceCount() {
   return 0;
 #endif
 }
+
+static std::vector<int> getAvailableCpus() {
+  std::vector<int> cpus;
+#ifdef __linux__
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0)
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+      if (CPU_ISSET(cpu, &cpuSet))
+        cpus.push_back(cpu);
+#endif
+  return cpus;
+}
+
+std::size_t cudaq::getAvailableCpuCount() {
+  const auto cpus = getAvailableCpus();
+  if (!cpus.empty())
+    return cpus.size();
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+std::vector<std::vector<int>>
+cudaq::partitionAvailableCpus(std::size_t numPartitions) {
+  std::vector<std::vector<int>> partitions(numPartitions);
+  const auto cpus = getAvailableCpus();
+  if (cpus.empty() || numPartitions == 0)
+    return partitions;
+
+  if (cpus.size() <= numPartitions) {
+    for (std::size_t i = 0; i < numPartitions; ++i)
+      partitions[i].push_back(cpus[i % cpus.size()]);
+    return partitions;
+  }
+
+  // The first `remainder` partitions get one extra CPU.
+  const std::size_t base = cpus.size() / numPartitions;
+  const std::size_t remainder = cpus.size() % numPartitions;
+  auto next = cpus.begin();
+  for (std::size_t i = 0; i < numPartitions; ++i) {
+    const std::size_t count = base + (i < remainder ? 1 : 0);
+    partitions[i].assign(next, next + count);
+    next += count;
+  }
+  return partitions;
+}
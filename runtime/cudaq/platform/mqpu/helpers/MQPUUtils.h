@@ -9,6 +9,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 namespace cudaq {
 // Helper struct to start a REST server (`cudaq-qpud`) instance on a random
@@ -32,4 +33,13 @@ private:
 // If CUDA is present, returns the actual number of GPU devices. Otherwise,
 // returns 0.
 int getCudaGetDeviceCount();
+
+// Helper to split the CPUs this process is allowed to run on into
+// `numPartitions` contiguous sets of near equal size. If there are fewer CPUs
+// than partitions, each partition gets a single CPU, assigned round-robin.
+// Returns empty sets if the CPU affinity cannot be queried on this platform.
+std::vector<std::vector<int>> partitionAvailableCpus(std::size_t numPartitions);
+
+// Helper to retrieve the number of CPUs this process is allowed to run on.
+std::size_t getAvailableCpuCount();
 } // namespace cudaq
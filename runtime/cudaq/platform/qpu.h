@@ -94,13 +94,19 @@ public:
   /// queue
   QPU(std::size_t _qpuId)
       : qpu_id(_qpuId),
-        execution_queue(std::make_unique<QuantumExecutionQueue>()) {}
+        execution_queue(std::make_unique<QuantumExecutionQueue>()) {
+    execution_queue->setQpuId(_qpuId);
+  }
   /// Move constructor
   QPU(QPU &&) = default;
   /// The destructor
   virtual ~QPU() = default;
   /// Set the current QPU Id
-  void setId(std::size_t _qpuId) { qpu_id = _qpuId; }
+  void setId(std::size_t _qpuId) {
+    qpu_id = _qpuId;
+    if (execution_queue)
+      execution_queue->setQpuId(_qpuId);
+  }
 
   /// Get id of the thread this QPU's queue executes on.
   // If no execution_queue has been constructed, returns a 'null' id (does not
@@ -110,6 +116,9 @@ public:
                            : std::thread::id();
   }
 
+  /// Get the execution queue of this QPU, may be null.
+  QuantumExecutionQueue *getExecutionQueue() { return execution_queue.get(); }
+
   virtual void setNoiseModel(const noise_model *model) { noiseModel = model; }
 
   /// Return the number of qubits
@@ -136,6 +145,17 @@ public:
   virtual void
   enqueue(QuantumTask &task) = 0; //{ execution_queue->enqueue(task); }
 
+  /// Enqueue a task that any QPU of the work-stealing group of this QPU's
+  /// execution queue may run.
+  virtual void enqueueStealable(StealableQuantumTask &task) {
+    execution_queue->enqueueStealable(task);
+  }
+
+  /// Prepare the execution thread of this QPU to run a stealable task, e.g.
+  /// select its device. Stealable tasks do not go through `enqueue`, so any
+  /// setup done there must be repeated here. By default do nothing.
+  virtual void prepareStealableTask() {}
+
   /// Set the execution context, meant for subtype specification
   virtual void setExecutionContext(ExecutionContext *context) = 0;
   /// Reset the execution context, meant for subtype specification
@@ -16,6 +16,7 @@
 #include "nvqpp_config.h"
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <stdio.h>
 #include <string>
@@ -76,6 +77,52 @@ void quantum_platform::enqueueAsyncTask(const std::size_t qpu_id,
   platformQPUs[qpu_id]->enqueue(f);
 }
 
+void quantum_platform::enqueueStealableTask(StealableQuantumTask &f) {
+  std::vector<QuantumExecutionQueue *> queues;
+  std::vector<std::size_t> queueIds;
+  for (auto &qpu : platformQPUs) {
+    queues.push_back(qpu->getExecutionQueue());
+    queueIds.push_back(queues.back()->getId());
+  }
+
+  {
+    // (Re-)form the stealing group if the set of QPUs has changed, e.g.
+    // after the target has been reset. Queue ids are compared rather than
+    // addresses, which may be reused by the queues of new QPUs.
+    std::lock_guard<std::mutex> lock(stealingGroupMutex);
+    if (queueIds != stealingGroupQueueIds) {
+      for (auto &qpu : platformQPUs)
+        qpu->getExecutionQueue()->setStealableTaskSetup(
+            [qpu = qpu.get()]() { qpu->prepareStealableTask(); });
+      QuantumExecutionQueue::formStealingGroup(queues);
+      stealingGroupQueueIds = queueIds;
+    }
+  }
+
+  std::size_t target = 0;
+  std::size_t minDepth = std::numeric_limits<std::size_t>::max();
+  for (std::size_t i = 0; i < queues.size(); i++) {
+    auto depth = queues[i]->depth();
+    if (depth < minDepth) {
+      minDepth = depth;
+      target = i;
+    }
+  }
+
+  cudaq::info("Enqueue stealable task on QPU {} (queue depth {})", target,
+              minDepth);
+  platformQPUs[target]->enqueueStealable(f);
+}
+
+QuantumExecutionQueue::Statistics
+quantum_platform::get_queue_statistics(const std::size_t qpu_id) {
+  if (qpu_id >= platformQPUs.size())
+    throw std::invalid_argument("Invalid QPU id " + std::to_string(qpu_id) +
+                                " for queue statistics.");
+  auto *queue = platformQPUs[qpu_id]->getExecutionQueue();
+  return queue ? queue->getStatistics() : QuantumExecutionQueue::Statistics{};
+}
+
 void quantum_platform::set_current_qpu(const std::size_t device_id) {
   if (device_id >= platformNumQPUs) {
     throw std::invalid_argument(
@@ -89,11 +136,16 @@ void quantum_platform::set_current_qpu(const std::size_t device_id) {
 
 std::size_t quantum_platform::get_current_qpu() { return platformCurrentQPU; }
 
+// The execution context of the calling thread, so that threads executing
+// kernels concurrently, e.g. the workers of a remote simulation server, do not
+// observe each other's context.
+static thread_local cudaq::ExecutionContext *threadExecutionContext = nullptr;
+
 // Specify the execution context for this platform.
 // This delegates to the targeted QPU
 void quantum_platform::set_exec_ctx(cudaq::ExecutionContext *ctx,
                                     std::size_t qid) {
-  executionContext = ctx;
+  threadExecutionContext = ctx;
   auto &platformQPU = platformQPUs[qid];
   platformQPU->setExecutionContext(ctx);
 }
@@ -102,7 +154,11 @@ void quantum_platform::set_exec_ctx(cudaq::ExecutionContext *ctx,
 void quantum_platform::reset_exec_ctx(std::size_t qid) {
   auto &platformQPU = platformQPUs[qid];
   platformQPU->resetExecutionContext();
-  executionContext = nullptr;
+  threadExecutionContext = nullptr;
+}
+
+ExecutionContext *quantum_platform::get_exec_ctx() const {
+  return threadExecutionContext;
 }
 
 std::optional<QubitConnectivity> quantum_platform::connectivity() {
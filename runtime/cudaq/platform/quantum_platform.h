@@ -11,12 +11,14 @@
 #include "common/ExecutionContext.h"
 #include "common/NoiseModel.h"
 #include "common/ObserveResult.h"
+#include "cudaq/platform/QuantumExecutionQueue.h"
 #include "cudaq/utils/cudaq_utils.h"
 #include <cstring>
 #include <cxxabi.h>
 #include <functional>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -82,8 +84,8 @@ public:
   /// Specify the execution context for this platform.
   void set_exec_ctx(cudaq::ExecutionContext *ctx, std::size_t qpu_id = 0);
 
-  /// Return the current execution context
-  ExecutionContext *get_exec_ctx() const { return executionContext; }
+  /// Return the execution context of the calling thread.
+  ExecutionContext *get_exec_ctx() const;
 
   /// Reset the execution context for this platform.
   void reset_exec_ctx(std::size_t qpu_id = 0);
@@ -127,6 +129,15 @@ public:
   /// @brief Enqueue a general task that runs on the specified QPU
   void enqueueAsyncTask(const std::size_t qpu_id, std::function<void()> &f);
 
+  /// @brief Enqueue a task that is not bound to a specific QPU. The task is
+  /// submitted to the least loaded QPU and may be stolen by any idle QPU of
+  /// the platform. It is passed the id of the QPU that executes it.
+  void enqueueStealableTask(StealableQuantumTask &f);
+
+  /// @brief Return the queue depth and latency counters of the specified QPU.
+  QuantumExecutionQueue::Statistics
+  get_queue_statistics(const std::size_t qpu_id = 0);
+
   // This method is the hook for the kernel rewrites to invoke
   // quantum kernels.
   void launchKernel(std::string kernelName, void (*kernelFunc)(void *),
@@ -168,10 +179,13 @@ protected:
   /// that it is running in a multi-QPU context.
   std::unordered_map<std::size_t, std::size_t> threadToQpuId;
 
+  /// @brief The ids of the QPU execution queues currently forming the
+  /// work-stealing group, guarded by `stealingGroupMutex`.
+  std::vector<std::size_t> stealingGroupQueueIds;
+  std::mutex stealingGroupMutex;
+
   /// Optional number of shots.
   std::optional<int> platformNumShots;
-
-  ExecutionContext *executionContext = nullptr;
 };
 
 /// Entry point for the auto-generated kernel execution path. TODO: Needs to be
@@ -143,6 +143,11 @@ protected:
               [&]() {
                 simulator()->applyExpPauli(parameters[0], localC, localT, op);
               })
+        .Case("evolve_diagonal",
+              [&]() {
+                simulator()->applyDiagonalEvolution(parameters[0], localC,
+                                                    localT, op);
+              })
         .Default([&]() {
           throw std::runtime_error("[DefaultExecutionManager] invalid gate "
                                    "application requested " +
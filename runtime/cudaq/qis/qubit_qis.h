@@ -380,6 +380,37 @@ void exp_pauli(QuantumRegister &ctrls, double theta, const char *pauliWord,
                                false, spin_op::from_word(pauliWord));
 }
 
+/// @brief Apply `exp(-i gamma H)` for a Hamiltonian `H` made up of `I` and `Z`
+/// terms only, e.g. a QAOA cost layer, to the given qubit register. Qubit `k`
+/// of `H` acts on the `k`-th qubit of the register. Simulators may apply this
+/// as a single diagonal phase instead of one `exp_pauli` per term.
+///
+/// Note: this is only available in library mode. The MLIR bridge and the
+/// Python kernel lowering do not support `evolve_diagonal`.
+#if CUDAQ_USE_STD20
+template <typename QubitRange>
+  requires(std::ranges::range<QubitRange>)
+#else
+template <
+    typename QubitRange,
+    typename = std::enable_if_t<!std::is_same_v<
+        std::remove_reference_t<std::remove_cv_t<QubitRange>>, cudaq::qubit>>>
+#endif
+void evolve_diagonal(double gamma, QubitRange &&qubits,
+                     const spin_op &hamiltonian) {
+  if (!hamiltonian.is_diagonal())
+    throw std::runtime_error("Invalid evolve_diagonal call, the spin_op must "
+                             "only contain I and Z terms.");
+  std::vector<QuditInfo> quditInfos;
+  std::transform(qubits.begin(), qubits.end(), std::back_inserter(quditInfos),
+                 [](auto &q) { return cudaq::qubitToQuditInfo(q); });
+  if (quditInfos.size() < hamiltonian.num_qubits())
+    throw std::runtime_error("Invalid evolve_diagonal call, the spin_op acts "
+                             "on more qubits than provided.");
+  getExecutionManager()->apply("evolve_diagonal", {gamma}, {}, quditInfos,
+                               false, hamiltonian);
+}
+
 /// @brief Measure an individual qubit, return 0,1 as `bool`
 inline measure_result mz(qubit &q) {
   return getExecutionManager()->measure({q.n_levels(), q.id()});
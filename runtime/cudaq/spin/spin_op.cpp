@@ -94,6 +94,109 @@ mult(std::vector<bool> row, std::vector<bool> other_row,
   coeff *= phase_coeff * otherCoeff;
   return std::make_pair(coeff, tmp);
 }
+
+/// @brief Estimate the relative cost of measuring the given term. Identity
+/// terms are free, every other term pays a fixed per-circuit overhead plus one
+/// basis change per non-identity Pauli.
+std::size_t estimateTermCost(const spin_op::spin_op_term &term) {
+  auto numQubits = term.size() / 2;
+  std::size_t weight = 0;
+  for (std::size_t i = 0; i < numQubits; i++)
+    if (term[i] || term[i + numQubits])
+      weight++;
+  return weight == 0 ? 0 : 1 + weight;
+}
+
+bool isQubitWiseCompatible(const spin_op::spin_op_term &lhs,
+                           const spin_op::spin_op_term &rhs) {
+  auto numQubits = lhs.size() / 2;
+  for (std::size_t i = 0; i < numQubits; i++) {
+    bool lhsActs = lhs[i] || lhs[i + numQubits];
+    bool rhsActs = rhs[i] || rhs[i + numQubits];
+    if (lhsActs && rhsActs &&
+        (lhs[i] != rhs[i] || lhs[i + numQubits] != rhs[i + numQubits]))
+      return false;
+  }
+  return true;
+}
+
+/// @brief Partition the given terms into `numChunks` chunks of similar
+/// estimated cost. Returns the term indices assigned to each chunk.
+std::vector<std::vector<std::size_t>>
+balanceTermCosts(const std::vector<spin_op::spin_op_term> &terms,
+                 std::size_t numChunks) {
+  // Visit terms in a deterministic order, most expensive first, so that every
+  // process (e.g. every MPI rank) computes the same distribution.
+  std::vector<std::size_t> costs(terms.size());
+  std::vector<std::size_t> order(terms.size());
+  for (std::size_t i = 0; i < terms.size(); i++) {
+    costs[i] = estimateTermCost(terms[i]);
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+    if (costs[a] != costs[b])
+      return costs[a] > costs[b];
+    return terms[a] < terms[b];
+  });
+
+  // Greedily group terms that share a measurement basis. Each group tracks
+  // the union of its terms' supports as its basis.
+  struct TermGroup {
+    spin_op::spin_op_term basis;
+    std::vector<std::size_t> members;
+    std::size_t cost = 0;
+  };
+  std::vector<TermGroup> groups;
+  std::size_t totalCost = 0, maxTermCost = 0;
+  for (auto idx : order) {
+    const auto &term = terms[idx];
+    auto iter = std::find_if(groups.begin(), groups.end(), [&](auto &group) {
+      return isQubitWiseCompatible(group.basis, term);
+    });
+    if (iter == groups.end()) {
+      groups.emplace_back();
+      iter = std::prev(groups.end());
+      iter->basis = spin_op::spin_op_term(term.size());
+    }
+    for (std::size_t i = 0; i < term.size(); i++)
+      if (term[i])
+        iter->basis[i] = true;
+    iter->members.push_back(idx);
+    iter->cost += costs[idx];
+    totalCost += costs[idx];
+    maxTermCost = std::max(maxTermCost, costs[idx]);
+  }
+
+  // Groups larger than a chunk's fair share are split, otherwise a single
+  // large group would leave the chunk that receives it as the straggler.
+  auto target = std::max((totalCost + numChunks - 1) / numChunks, maxTermCost);
+  std::vector<std::pair<std::size_t, std::vector<std::size_t>>> pieces;
+  for (auto &group : groups) {
+    pieces.emplace_back(0, std::vector<std::size_t>{});
+    for (auto idx : group.members) {
+      if (pieces.back().first > 0 &&
+          pieces.back().first + costs[idx] > target)
+        pieces.emplace_back(0, std::vector<std::size_t>{});
+      pieces.back().first += costs[idx];
+      pieces.back().second.push_back(idx);
+    }
+  }
+
+  // Longest-processing-time-first assignment of the pieces to the chunks.
+  std::stable_sort(pieces.begin(), pieces.end(),
+                   [](auto &a, auto &b) { return a.first > b.first; });
+  std::vector<std::vector<std::size_t>> chunks(numChunks);
+  std::vector<std::size_t> loads(numChunks, 0);
+  for (auto &[cost, members] : pieces) {
+    auto minIdx = std::distance(loads.begin(),
+                                std::min_element(loads.begin(), loads.end()));
+    loads[minIdx] += cost;
+    chunks[minIdx].insert(chunks[minIdx].end(), members.begin(),
+                          members.end());
+  }
+
+  return chunks;
+}
 } // namespace details
 
 spin_op::spin_op() {
@@ -202,6 +305,39 @@ complex_matrix spin_op::to_matrix() const {
   return A;
 }
 
+std::vector<double> spin_op::to_diagonal() const {
+  if (!is_diagonal())
+    throw std::invalid_argument(
+        "spin_op::to_diagonal requires a spin_op with only I and Z terms.");
+
+  // Scatter each coefficient to the index of its Z mask (qubit 0 is the most
+  // significant bit, as in to_matrix), then a Walsh-Hadamard transform gives
+  // diagonal[i] = sum_m coeff_m (-1)^|i & m| in O(n 2^n).
+  auto n = num_qubits();
+  auto dim = 1UL << n;
+  std::vector<double> diagonal(dim, 0.0);
+  for (auto &[term, coeff] : terms) {
+    std::size_t zMask = 0;
+    for (std::size_t i = 0; i < n; i++)
+      if (term[i + n])
+        zMask |= 1UL << (n - 1 - i);
+    diagonal[zMask] += coeff.real();
+  }
+
+  for (std::size_t half = 1; half < dim; half <<= 1) {
+#ifdef CUDAQ_HAS_OPENMP
+#pragma omp parallel for
+#endif
+    for (std::size_t k = 0; k < dim / 2; k++) {
+      auto i = ((k & ~(half - 1)) << 1) | (k & (half - 1));
+      auto a = diagonal[i], b = diagonal[i + half];
+      diagonal[i] = a + b;
+      diagonal[i + half] = a - b;
+    }
+  }
+  return diagonal;
+}
+
 spin_op::csr_spmatrix spin_op::to_sparse_matrix() const {
   auto n = num_qubits();
   auto dim = 1UL << n;
@@ -436,6 +572,15 @@ bool spin_op::is_identity() const {
   return true;
 }
 
+bool spin_op::is_diagonal() const {
+  for (auto &[row, c] : terms)
+    for (std::size_t i = 0; i < row.size() / 2; i++)
+      if (row[i])
+        return false;
+
+  return true;
+}
+
 bool spin_op::operator==(const spin_op &v) const noexcept {
   // Could be that the term is identity with all zeros
   bool isId1 = true, isId2 = true;
@@ -485,7 +630,25 @@ std::size_t spin_op::num_qubits() const {
 
 std::size_t spin_op::num_terms() const { return terms.size(); }
 
-std::vector<spin_op> spin_op::distribute_terms(std::size_t numChunks) const {
+std::vector<spin_op>
+spin_op::distribute_terms(std::size_t numChunks,
+                          term_distribution strategy) const {
+  if (numChunks == 0)
+    throw std::invalid_argument(
+        "Cannot distribute spin_op terms into 0 chunks.");
+
+  if (strategy == term_distribution::cost_balanced) {
+    auto [bsf, coeffs] = get_raw_data();
+    std::vector<spin_op> spins;
+    for (auto &chunk : details::balanceTermCosts(bsf, numChunks)) {
+      std::unordered_map<spin_op_term, std::complex<double>> sliced;
+      for (auto idx : chunk)
+        sliced.emplace(bsf[idx], coeffs[idx]);
+      spins.emplace_back(sliced);
+    }
+    return spins;
+  }
+
   // Calculate how many terms we can equally divide amongst the chunks
   auto nTermsPerChunk = num_terms() / numChunks;
 
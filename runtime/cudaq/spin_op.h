@@ -85,6 +85,17 @@ class spin_op;
 /// @brief Utility enum representing Paulis.
 enum class pauli { I, X, Y, Z };
 
+/// @brief Strategies for partitioning the terms of a spin_op into chunks, see
+/// `spin_op::distribute_terms`.
+enum class term_distribution {
+  /// @brief Chunks with an equal number of terms, in term storage order.
+  equal_count,
+  /// @brief Chunks with a roughly equal estimated measurement cost. Terms that
+  /// share a measurement basis (qubit-wise commuting terms) are kept in the
+  /// same chunk where possible. The result is deterministic across processes.
+  cost_balanced
+};
+
 namespace spin {
 
 /// @brief Return a spin_op == to I on the `idx` qubit
@@ -328,6 +339,10 @@ public:
   /// @brief Is this spin_op == to the identity
   bool is_identity() const;
 
+  /// @brief Is this spin_op diagonal in the computational basis, i.e. are all
+  /// of its terms made up of `I` and `Z` only.
+  bool is_diagonal() const;
+
   /// @brief Dump a string representation of this spin_op to standard out.
   void dump() const;
 
@@ -339,8 +354,13 @@ public:
   std::vector<double> getDataRepresentation();
 
   /// @brief Return a vector of spin_op representing a distribution of the
-  /// terms in this spin_op into equally sized chunks.
-  std::vector<spin_op> distribute_terms(std::size_t numChunks) const;
+  /// terms in this spin_op into `numChunks` chunks. By default, chunks are
+  /// equally sized. With `term_distribution::cost_balanced`, chunks have a
+  /// similar estimated measurement cost instead. Chunks may be empty if there
+  /// are fewer terms than chunks.
+  std::vector<spin_op> distribute_terms(
+      std::size_t numChunks,
+      term_distribution strategy = term_distribution::equal_count) const;
 
   /// @brief Apply the give functor on each term of this spin_op. This method
   /// can enable general reductions via lambda capture variables.
@@ -355,6 +375,11 @@ public:
   /// spin_op.
   complex_matrix to_matrix() const;
 
+  /// @brief Return the `2^n` diagonal elements of this diagonal `spin_op`, in
+  /// the same basis ordering as `to_matrix()`. Only the real part of the
+  /// coefficients is used. Throws if the `spin_op` contains `X` or `Y` terms.
+  std::vector<double> to_diagonal() const;
+
   /// @brief Typedef for a vector of non-zero sparse matrix elements.
   using csr_spmatrix =
       std::tuple<std::vector<std::complex<double>>, std::vector<std::size_t>,
@@ -377,6 +402,14 @@ spin_op operator-(double coeff, spin_op op);
 /// @brief Subtract a spin_op and a double
 spin_op operator-(spin_op op, double coeff);
 
+namespace details {
+/// @brief Return true if the two terms, in binary symplectic form, can be
+/// measured in the same basis, i.e. on every qubit they either act with the
+/// same Pauli or one of them acts with the identity.
+bool isQubitWiseCompatible(const spin_op::spin_op_term &lhs,
+                           const spin_op::spin_op_term &rhs);
+} // namespace details
+
 class spin_op_reader {
 public:
   virtual ~spin_op_reader() = default;
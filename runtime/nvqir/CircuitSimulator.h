@@ -14,8 +14,14 @@
 #include "common/MeasureCounts.h"
 #include "common/NoiseModel.h"
 
+#include <bit>
+#include <cmath>
+#include <complex>
 #include <cstdarg>
 #include <cstddef>
+#include <memory>
+#include <numeric>
+#include <optional>
 #include <queue>
 #include <sstream>
 #include <string>
@@ -62,8 +68,11 @@ public:
     // do nothing
   }
 
-  /// @brief Apply exp(-i theta PauliTensorProd) to the underlying state.
-  /// This must be provided by subclasses.
+  /// @brief Apply exp(i theta PauliTensorProd) to the underlying state.
+  /// The default implementation decomposes the rotation into basis changes,
+  /// a CNOT ladder and a single (controlled) `rz`. Subclasses with direct
+  /// access to their state should override this with a native
+  /// implementation, see `CircuitSimulatorBase::applyExpPauliToStateVector`.
   virtual void applyExpPauli(double theta,
                              const std::vector<std::size_t> &controls,
                              const std::vector<std::size_t> &qubitIds,
@@ -124,6 +133,27 @@ public:
     }
   }
 
+  /// @brief Apply exp(-i gamma H) for a Hamiltonian `H` made up of `I` and `Z`
+  /// terms only, e.g. a QAOA cost layer. The default implementation applies
+  /// one `exp_pauli` per (commuting) term. Subclasses with direct access to
+  /// their state should override this with a single diagonal phase
+  /// multiplication, see `CircuitSimulatorBase::getStateDiagonal`.
+  virtual void applyDiagonalEvolution(double gamma,
+                                      const std::vector<std::size_t> &controls,
+                                      const std::vector<std::size_t> &qubitIds,
+                                      const cudaq::spin_op &op) {
+    if (!op.is_diagonal())
+      throw std::invalid_argument(
+          "Diagonal evolution requires a spin_op with only I and Z terms.");
+    op.for_each_term([&](cudaq::spin_op &term) {
+      // The identity term is a global phase.
+      if (term.is_identity() && controls.empty())
+        return;
+      applyExpPauli(-gamma * term.get_coefficient().real(), controls, qubitIds,
+                    term);
+    });
+  }
+
   /// @brief Compute the expected value of the given spin op
   /// with respect to the current state, <psi | H | psi>.
   virtual cudaq::ExecutionResult observe(const cudaq::spin_op &term) = 0;
@@ -329,6 +359,22 @@ protected:
   /// @brief Keep track of the current number of qubits in batch mode
   std::size_t batchModeCurrentNumQubits = 0;
 
+  /// @brief The most recently computed state diagonal of a diagonal spin_op,
+  /// see `getStateDiagonal`. It is dropped whenever the state is resized or
+  /// deallocated.
+  struct DiagonalCacheEntry {
+    cudaq::spin_op op;
+    std::vector<std::size_t> qubitIds;
+    std::size_t stateDimension;
+    std::shared_ptr<const std::vector<double>> diagonal;
+  };
+  std::optional<DiagonalCacheEntry> diagonalCache;
+
+  /// @brief The largest state dimension whose diagonal is kept in
+  /// `diagonalCache`, i.e. 128 MiB of energies. Larger diagonals are
+  /// recomputed on every use rather than held alongside the state.
+  static constexpr std::size_t maxCachedDiagonalDimension = 1UL << 24;
+
   /// @brief Environment variable name that allows a programmer to
   /// specify how expectation values should be computed. This
   /// defaults to true.
@@ -378,6 +424,7 @@ protected:
     deallocateStateImpl();
     nQubitsAllocated = 0;
     stateDimension = 0;
+    diagonalCache.reset();
   }
 
   /// @brief Perform the actual mechanics of measuring a qubit,
@@ -630,6 +677,165 @@ protected:
   /// data representation.
   virtual void applyGate(const GateApplicationTask &task) = 0;
 
+  /// @brief Return true if composite operations like `exp_pauli` can be
+  /// applied directly to the state rather than decomposed into gates. This is
+  /// not the case when the gates are traced for resource counting or are
+  /// subject to a noise model.
+  bool canUpdateStateDirectly() const {
+    return !executionContext || (executionContext->name != "tracer" &&
+                                 !executionContext->noiseModel);
+  }
+
+  /// @brief Return the diagonal of the `I`/`Z`-only `op` acting on `qubitIds`
+  /// as `stateDimension` energies in the state vector index ordering, i.e.
+  /// qubit `q` is bit `q` of the index. The last diagonal is cached, up to
+  /// `maxCachedDiagonalDimension`, so that repeated cost layers and the final
+  /// `<H>` share a single computation.
+  std::shared_ptr<const std::vector<double>>
+  getStateDiagonal(const cudaq::spin_op &op,
+                   const std::vector<std::size_t> &qubitIds) {
+    if (diagonalCache && diagonalCache->stateDimension == stateDimension &&
+        diagonalCache->qubitIds == qubitIds && diagonalCache->op == op)
+      return diagonalCache->diagonal;
+
+    // Release the previous diagonal before computing the next one.
+    diagonalCache.reset();
+
+    cudaq::info("Computing the state diagonal of {} term(s) on {} qubit(s).",
+                op.num_terms(), qubitIds.size());
+    std::vector<double> diagonal = op.to_diagonal();
+    // The spin_op diagonal has qubit k at bit n - 1 - k, permute it onto the
+    // qubits of the state unless they already coincide.
+    const std::size_t n = op.num_qubits();
+    bool isStateOrdered = (1UL << n) == stateDimension;
+    for (std::size_t k = 0; k < n && isStateOrdered; ++k)
+      isStateOrdered = qubitIds[k] == n - 1 - k;
+    if (!isStateOrdered) {
+      std::vector<double> permuted(stateDimension);
+#ifdef CUDAQ_HAS_OPENMP
+#pragma omp parallel for
+#endif
+      for (std::size_t idx = 0; idx < stateDimension; ++idx) {
+        std::size_t local = 0;
+        for (std::size_t k = 0; k < n; ++k)
+          local |= ((idx >> qubitIds[k]) & 1UL) << (n - 1 - k);
+        permuted[idx] = diagonal[local];
+      }
+      diagonal = std::move(permuted);
+    }
+
+    auto result =
+        std::make_shared<const std::vector<double>>(std::move(diagonal));
+    if (stateDimension <= maxCachedDiagonalDimension)
+      diagonalCache = DiagonalCacheEntry{op, qubitIds, stateDimension, result};
+    return result;
+  }
+
+  /// @brief Multiply each amplitude of the given state vector by
+  /// `exp(-i gamma diagonal[idx])`, restricted to the subspace where all
+  /// `controls` are in the |1> state.
+  static void
+  applyDiagonalPhaseToStateVector(std::complex<ScalarType> *stateVector,
+                                  std::size_t dim, double gamma,
+                                  const std::vector<std::size_t> &controls,
+                                  const std::vector<double> &diagonal) {
+    std::size_t controlMask = 0;
+    for (auto c : controls)
+      controlMask |= (1ULL << c);
+#ifdef CUDAQ_HAS_OPENMP
+#pragma omp parallel for
+#endif
+    for (std::size_t idx = 0; idx < dim; ++idx)
+      if ((idx & controlMask) == controlMask)
+        stateVector[idx] *= std::complex<ScalarType>(
+            std::cos(gamma * diagonal[idx]), -std::sin(gamma * diagonal[idx]));
+  }
+
+  /// @brief Compute `sum_idx |psi_idx|^2 diagonal[idx]` for the given state
+  /// vector. Partial sums are over fixed blocks and accumulated in order, so
+  /// the result does not depend on the number of threads.
+  static double
+  getDiagonalExpectation(const std::complex<ScalarType> *stateVector,
+                         std::size_t dim, const std::vector<double> &diagonal) {
+    constexpr std::size_t blockSize = 1UL << 12;
+    const std::size_t numBlocks = (dim + blockSize - 1) / blockSize;
+    std::vector<double> partialSums(numBlocks, 0.0);
+#ifdef CUDAQ_HAS_OPENMP
+#pragma omp parallel for
+#endif
+    for (std::size_t block = 0; block < numBlocks; ++block) {
+      const std::size_t end = std::min(dim, (block + 1) * blockSize);
+      double sum = 0.0;
+      for (std::size_t idx = block * blockSize; idx < end; ++idx)
+        sum += std::norm(stateVector[idx]) * diagonal[idx];
+      partialSums[block] = sum;
+    }
+    return std::accumulate(partialSums.begin(), partialSums.end(), 0.0);
+  }
+
+  /// @brief Apply `exp(i theta P)` for the Pauli string `op` acting on
+  /// `qubitIds`, i.e. `cos(theta) psi + i sin(theta) P psi`, to the given state
+  /// vector in a single pass. The rotation is only applied to the subspace
+  /// where all `controls` are in the |1> state. Qubit `q` must correspond to
+  /// bit `q` of the state vector index.
+  static void
+  applyExpPauliToStateVector(std::complex<ScalarType> *stateVector,
+                             std::size_t dim, double theta,
+                             const std::vector<std::size_t> &controls,
+                             const std::vector<std::size_t> &qubitIds,
+                             const cudaq::spin_op &op) {
+    std::size_t xMask = 0, zMask = 0, controlMask = 0;
+    for (auto c : controls)
+      controlMask |= (1ULL << c);
+    op.for_each_pauli([&](cudaq::pauli type, std::size_t qubitIdx) {
+      const std::size_t bit = 1ULL << qubitIds[qubitIdx];
+      if (type == cudaq::pauli::X || type == cudaq::pauli::Y)
+        xMask |= bit;
+      if (type == cudaq::pauli::Z || type == cudaq::pauli::Y)
+        zMask |= bit;
+    });
+
+    // With Y = iXZ, P|k> = i^nY (-1)^|k & zMask| |k ^ xMask>. Fold the i^nY
+    // phase into the i sin(theta) coefficient.
+    constexpr std::complex<ScalarType> iPowers[] = {
+        {1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+    const std::complex<ScalarType> cosTheta(std::cos(theta), 0);
+    const std::complex<ScalarType> iSinTheta =
+        static_cast<ScalarType>(std::sin(theta)) *
+        iPowers[(std::popcount(xMask & zMask) + 1) % 4];
+    const auto parity = [zMask](std::size_t idx) -> ScalarType {
+      return std::popcount(idx & zMask) % 2 ? -1 : 1;
+    };
+
+    if (xMask == 0) {
+      // Diagonal Pauli string, every amplitude just picks up a phase.
+#ifdef CUDAQ_HAS_OPENMP
+#pragma omp parallel for
+#endif
+      for (std::size_t idx = 0; idx < dim; ++idx)
+        if ((idx & controlMask) == controlMask)
+          stateVector[idx] *= cosTheta + parity(idx) * iSinTheta;
+      return;
+    }
+
+    // Amplitudes idx and idx ^ xMask are coupled. Enumerate each pair once by
+    // inserting a zero at the highest bit of xMask.
+    const std::size_t lowMask = (1ULL << (std::bit_width(xMask) - 1)) - 1;
+#ifdef CUDAQ_HAS_OPENMP
+#pragma omp parallel for
+#endif
+    for (std::size_t k = 0; k < dim / 2; ++k) {
+      const std::size_t idx = ((k & ~lowMask) << 1) | (k & lowMask);
+      if ((idx & controlMask) != controlMask)
+        continue;
+      const std::size_t partner = idx ^ xMask;
+      const auto a = stateVector[idx];
+      const auto b = stateVector[partner];
+      stateVector[idx] = cosTheta * a + parity(partner) * iSinTheta * b;
+      stateVector[partner] = cosTheta * b + parity(idx) * iSinTheta * a;
+    }
+  }
+
   /// @brief Provide a base-class method that can be invoked
   /// after every gate application and will apply any noise
   /// channels after the gate invocation based on a user-provided noise
@@ -717,6 +923,7 @@ public:
     previousStateDimension = stateDimension;
     nQubitsAllocated++;
     stateDimension = calculateStateDim(nQubitsAllocated);
+    diagonalCache.reset();
 
     // Tell the subtype to grow the state representation
     addQubitToState();
@@ -754,6 +961,7 @@ public:
     previousStateDimension = stateDimension;
     nQubitsAllocated += count;
     stateDimension = calculateStateDim(nQubitsAllocated);
+    diagonalCache.reset();
 
     // Tell the subtype to allocate more qubits
     addQubitsToState(count);
@@ -115,8 +115,8 @@ getGateByName(GateName name, const std::vector<Scalar> angles = {}) {
     auto phi = angles[1];
     auto lambda = angles[2];
     return {{std::cos(theta / 2), 0.},
-            std::exp(nvqir::im<Scalar> * phi) * std::sin(theta / 2),
             -std::exp(nvqir::im<Scalar> * lambda) * std::sin(theta / 2),
+            std::exp(nvqir::im<Scalar> * phi) * std::sin(theta / 2),
             std::exp(nvqir::im<Scalar> * (phi + lambda)) * std::cos(theta / 2)};
   }
   case (GateName::PhasedRx): {
@@ -326,6 +326,25 @@ void __quantum__qis__phased_rx(double theta, double phi, Qubit *q) {
   nvqir::getCircuitSimulatorInternal()->applyCustomOperation(matrix, {}, {qI});
 }
 
+void __quantum__qis__u3(double theta, double phi, double lambda, Qubit *q) {
+  auto qI = qubitToSizeT(q);
+  cudaq::ScopedTrace trace("NVQIR::u3", theta, phi, lambda, qI);
+  nvqir::getCircuitSimulatorInternal()->u3(theta, phi, lambda, qI);
+}
+
+void __quantum__qis__u3__body(double theta, double phi, double lambda,
+                              Qubit *q) {
+  __quantum__qis__u3(theta, phi, lambda, q);
+}
+
+void __quantum__qis__u3__ctl(double theta, double phi, double lambda,
+                             Array *ctrls, Qubit *q) {
+  auto ctrlIdxs = arrayToVectorSizeT(ctrls);
+  auto qI = qubitToSizeT(q);
+  cudaq::ScopedTrace trace("NVQIR::u3", theta, phi, lambda, ctrlIdxs, qI);
+  nvqir::getCircuitSimulatorInternal()->u3(theta, phi, lambda, ctrlIdxs, qI);
+}
+
 void __quantum__qis__cnot(Qubit *q, Qubit *r) {
   auto qI = qubitToSizeT(q);
   auto rI = qubitToSizeT(r);
@@ -516,8 +516,6 @@ public:
         measuredBits32.size(), randomValues_.data(), shots,
         CUSTATEVEC_SAMPLER_OUTPUT_ASCENDING_ORDER));
 
-    std::vector<std::string> sequentialData;
-
     cudaq::ExecutionResult counts;
 
     // We've sampled, convert the results to our ExecutionResult counts
@@ -526,7 +524,6 @@ public:
                            .to_string()
                            .erase(0, 64 - measuredBits.size());
       std::reverse(bitstring.begin(), bitstring.end());
-      sequentialData.push_back(bitstring);
       counts.appendResult(bitstring, 1);
     }
 
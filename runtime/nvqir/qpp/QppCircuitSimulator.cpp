@@ -134,6 +134,46 @@ protected:
     state = qpp::applyCTRL(state, matrix, controls, targets);
   }
 
+  /// @brief Apply `exp_pauli` as a single pass over the state vector instead
+  /// of its gate decomposition. Density matrices use the decomposition.
+  void applyExpPauli(double theta, const std::vector<std::size_t> &controls,
+                     const std::vector<std::size_t> &qubitIds,
+                     const cudaq::spin_op &op) override {
+    if constexpr (std::is_same_v<StateType, qpp::ket>) {
+      if (!op.is_identity() && canUpdateStateDirectly()) {
+        flushAnySamplingTasks();
+        flushGateQueue();
+        cudaq::info(" [qpp] exp_pauli({}, {})", theta, op.to_string(false));
+        applyExpPauliToStateVector(state.data(), stateDimension, theta,
+                                   controls, qubitIds, op);
+        return;
+      }
+    }
+    CircuitSimulatorBase::applyExpPauli(theta, controls, qubitIds, op);
+  }
+
+  /// @brief Apply a diagonal evolution, e.g. a QAOA cost layer, as a single
+  /// phase multiplication with the cached state diagonal of `op`.
+  void applyDiagonalEvolution(double gamma,
+                              const std::vector<std::size_t> &controls,
+                              const std::vector<std::size_t> &qubitIds,
+                              const cudaq::spin_op &op) override {
+    if constexpr (std::is_same_v<StateType, qpp::ket>) {
+      if (op.is_diagonal() && canUpdateStateDirectly()) {
+        flushAnySamplingTasks();
+        flushGateQueue();
+        cudaq::info(" [qpp] diagonal evolution({}, {} terms)", gamma,
+                    op.num_terms());
+        applyDiagonalPhaseToStateVector(state.data(), stateDimension, gamma,
+                                        controls,
+                                        *getStateDiagonal(op, qubitIds));
+        return;
+      }
+    }
+    CircuitSimulatorBase::applyDiagonalEvolution(gamma, controls, qubitIds,
+                                                 op);
+  }
+
   /// @brief Set the current state back to the |0> state.
   void setToZeroState() override {
     state = qpp::ket::Zero(stateDimension);
@@ -185,6 +225,18 @@ public:
 
     flushGateQueue();
 
+    // A diagonal Hamiltonian reduces against its (cached) diagonal instead of
+    // forming the dense matrix.
+    if constexpr (std::is_same_v<StateType, qpp::ket>) {
+      if (op.is_diagonal() && op.num_qubits() <= nQubitsAllocated) {
+        std::vector<std::size_t> qubitIds(op.num_qubits());
+        std::iota(qubitIds.begin(), qubitIds.end(), 0);
+        return cudaq::ExecutionResult(
+            {}, getDiagonalExpectation(state.data(), stateDimension,
+                                       *getStateDiagonal(op, qubitIds)));
+      }
+    }
+
     // The op is on the following target bits.
     std::vector<std::size_t> targets;
     op.for_each_term([&](cudaq::spin_op &term) {
@@ -30,6 +30,23 @@ constexpr const char *DEFAULT_SERVER_IMPL = "rest";
 static llvm::cl::opt<std::string> serverSubType(
     "type", llvm::cl::desc("HTTP server subtype handling incoming requests."),
     llvm::cl::init(DEFAULT_SERVER_IMPL));
+static llvm::cl::opt<unsigned> numWorkers(
+    "workers",
+    llvm::cl::desc("Number of requests to execute concurrently, each with its "
+                   "own simulator instance. By default, requests are handled "
+                   "sequentially."),
+    llvm::cl::init(1));
+static llvm::cl::opt<unsigned> numCompileWorkers(
+    "compile-workers",
+    llvm::cl::desc("Number of requests to compile concurrently when running "
+                   "with multiple workers. Defaults to the number of workers."),
+    llvm::cl::init(0));
+static llvm::cl::opt<unsigned> queueSize(
+    "queue-size",
+    llvm::cl::desc("Number of requests to queue when all workers are busy, "
+                   "further requests are rejected with 503 Service "
+                   "Unavailable. Defaults to 4 requests per worker."),
+    llvm::cl::init(0));
 static llvm::cl::opt<bool> printRestPayloadVersion(
     "schema-version",
     llvm::cl::desc(
@@ -74,7 +91,13 @@ int main(int argc, char **argv) {
     return 0;
   }
 
-  restServer->init({{"port", std::to_string(port)}});
+  std::unordered_map<std::string, std::string> configs{
+      {"port", std::to_string(port)}, {"workers", std::to_string(numWorkers)}};
+  if (numCompileWorkers > 0)
+    configs.emplace("compile-workers", std::to_string(numCompileWorkers));
+  if (queueSize > 0)
+    configs.emplace("queue-size", std::to_string(queueSize));
+  restServer->init(configs);
   restServer->start();
   if (cudaq::mpi::available())
     cudaq::mpi::finalize();
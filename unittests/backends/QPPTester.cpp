@@ -619,6 +619,21 @@ CUDAQ_TEST(QPPTester, checkParameterizedGates) {
     EXPECT_EQ_KETS(want_state, got_state);
     EXPECT_EQ(want_bitstring, got_bitstring);
     EXPECT_EQ(1, qppBackend.mz(q0));
+
+    // Distinct angles tell the U gate from its transpose:
+    // `U(pi/2,pi/2,pi)|0> = (|0> + i|1>) / sqrt(2)` and
+    // `U(pi/2,pi/2,pi)|1> = (|0> - i|1>) / sqrt(2)`.
+    for (int bit : {0, 1}) {
+      qppBackend.deallocate(q0);
+      q0 = qppBackend.allocateQubit();
+      if (bit)
+        qppBackend.x(q0);
+      qppBackend.u3(M_PI_2, M_PI_2, M_PI, q0);
+      got_state = qppBackend.getStateVector();
+      const std::complex<double> i(0., bit ? -1. : 1.);
+      EXPECT_NEAR(std::abs(got_state(0) - M_SQRT1_2), 0., 1e-6);
+      EXPECT_NEAR(std::abs(got_state(1) - i * M_SQRT1_2), 0., 1e-6);
+    }
   }
 
   // Checking U1 gate.
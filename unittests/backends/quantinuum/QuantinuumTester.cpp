@@ -12,6 +12,7 @@
 #include <fstream>
 #include <gtest/gtest.h>
 #include <regex>
+#include <set>
 
 std::string mockPort = "62440";
 std::string backendStringTemplate =
@@ -165,6 +166,35 @@ CUDAQ_TEST(QuantinuumTester, checkObserveSync) {
   EXPECT_TRUE(isValidExpVal(result.expectation()));
 }
 
+CUDAQ_TEST(QuantinuumTester, checkObserveManyJobsInOrder) {
+  std::string home = std::getenv("HOME");
+  std::string fileName = home + "/FakeCppQuantinuum.config";
+  auto backendString =
+      fmt::format(fmt::runtime(backendStringTemplate), mockPort, fileName);
+
+  auto &platform = cudaq::get_platform();
+  platform.setTargetBackend(backendString);
+
+  // Every term is a stabilizer of the GHZ state, so each has a deterministic
+  // expectation value. The last four terms do not share a measurement basis
+  // and are submitted as concurrent jobs. The weighted sum is only recovered
+  // if every job id is matched with the term it was created for.
+  auto kernel = cudaq::make_kernel();
+  auto qubit = kernel.qalloc(3);
+  kernel.h(qubit[0]);
+  kernel.x<cudaq::ctrl>(qubit[0], qubit[1]);
+  kernel.x<cudaq::ctrl>(qubit[1], qubit[2]);
+
+  using namespace cudaq::spin;
+  cudaq::spin_op h = z(0) * z(1) + 2. * x(0) * x(1) * x(2) +
+                     4. * x(0) * y(1) * y(2) + 8. * y(0) * x(1) * y(2) +
+                     16. * y(0) * y(1) * x(2);
+  auto result = cudaq::observe(100, kernel, h);
+  EXPECT_NEAR(result.expectation(), 1. + 2. - 4. - 8. - 16., 1e-9);
+  EXPECT_NEAR(result.expectation(x(0) * x(1) * x(2)), 1., 1e-9);
+  EXPECT_NEAR(result.expectation(y(0) * y(1) * x(2)), -1., 1e-9);
+}
+
 CUDAQ_TEST(QuantinuumTester, checkObserveSyncEmulate) {
   std::string home = std::getenv("HOME");
   std::string fileName = home + "/FakeCppQuantinuum.config";
@@ -219,6 +249,45 @@ CUDAQ_TEST(QuantinuumTester, checkObserveAsync) {
   EXPECT_TRUE(isValidExpVal(result.expectation()));
 }
 
+CUDAQ_TEST(QuantinuumTester, checkObserveAsyncJobCallbacks) {
+  std::string home = std::getenv("HOME");
+  std::string fileName = home + "/FakeCppQuantinuum.config";
+  auto backendString =
+      fmt::format(fmt::runtime(backendStringTemplate), mockPort, fileName);
+
+  auto &platform = cudaq::get_platform();
+  platform.setTargetBackend(backendString);
+
+  auto [kernel, theta] = cudaq::make_kernel<double>();
+  auto qubit = kernel.qalloc(2);
+  kernel.x(qubit[0]);
+  kernel.ry(theta, qubit[1]);
+  kernel.x<cudaq::ctrl>(qubit[1], qubit[0]);
+
+  using namespace cudaq::spin;
+  cudaq::spin_op h = 5.907 - 2.1433 * x(0) * x(1) - 2.1433 * y(0) * y(1) +
+                     .21829 * z(0) - 6.125 * z(1);
+  auto future = cudaq::observe_async(kernel, h, .59);
+
+  // Every job measures one group of compatible terms and is reported as soon
+  // as it completes. Here, the Z terms share a job.
+  std::size_t completedJobs = 0;
+  std::set<std::string> completedTerms;
+  future.on_job_completed(
+      [&](const cudaq::details::future::Job &job,
+          const cudaq::sample_result &counts) {
+        completedJobs++;
+        for (auto &term : cudaq::split(job.second, ','))
+          completedTerms.insert(term);
+        EXPECT_GT(counts.size(), 0);
+      });
+
+  auto result = future.get();
+  EXPECT_EQ(completedJobs, 3);
+  EXPECT_EQ(completedTerms.size(), 4);
+  EXPECT_TRUE(isValidExpVal(result.expectation()));
+}
+
 CUDAQ_TEST(QuantinuumTester, checkObserveAsyncEmulate) {
   std::string home = std::getenv("HOME");
   std::string fileName = home + "/FakeCppQuantinuum.config";
@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CUDAQTestUtils.h"
+#include "common/CompilationCache.h"
+#include <fstream>
+
+using namespace cudaq;
+
+static CompilationCache::Entry makeEntry(std::string code) {
+  std::string name = "kernel";
+  nlohmann::json outputNames = {{"0", {"r00000", {0, "q0"}}}};
+  std::vector<std::size_t> reorderIdx = {1, 0};
+  CompilationCache::Entry entry;
+  entry.codes.emplace_back(name, code, outputNames, reorderIdx);
+  entry.modules.push_back("module {}");
+  return entry;
+}
+
+CUDAQ_TEST(CompilationCacheTester, checkStoreAndLookup) {
+  auto dir = std::filesystem::temp_directory_path() / "cudaq_cache_lookup";
+  std::filesystem::remove_all(dir);
+  CompilationCache cache(dir, 1024 * 1024);
+
+  EXPECT_FALSE(cache.lookup("key").has_value());
+  cache.store("key", makeEntry("code"));
+
+  // A new cache on the same directory, e.g. in another process, finds it.
+  CompilationCache other(dir, 1024 * 1024);
+  auto entry = other.lookup("key");
+  ASSERT_TRUE(entry.has_value());
+  ASSERT_EQ(entry->codes.size(), 1);
+  EXPECT_EQ(entry->codes[0].name, "kernel");
+  EXPECT_EQ(entry->codes[0].code, "code");
+  EXPECT_EQ(entry->codes[0].output_names, makeEntry("").codes[0].output_names);
+  EXPECT_EQ(entry->codes[0].mapping_reorder_idx,
+            (std::vector<std::size_t>{1, 0}));
+  EXPECT_EQ(entry->modules, std::vector<std::string>{"module {}"});
+  EXPECT_EQ(cache.getMisses(), 1);
+  EXPECT_EQ(other.getHits(), 1);
+  std::filesystem::remove_all(dir);
+}
+
+CUDAQ_TEST(CompilationCacheTester, checkEviction) {
+  auto dir = std::filesystem::temp_directory_path() / "cudaq_cache_evict";
+  std::filesystem::remove_all(dir);
+  auto entrySize = [&]() {
+    CompilationCache cache(dir, 1024 * 1024);
+    cache.store("probe", makeEntry("code"));
+    auto size = std::filesystem::file_size(dir / "probe.json");
+    std::filesystem::remove(dir / "probe.json");
+    return size;
+  }();
+
+  // Room for three entries, the least recently used ones are evicted. The
+  // modification times are set explicitly, so that the order does not depend
+  // on the file system's time resolution.
+  CompilationCache cache(dir, 3 * entrySize);
+  auto now = std::filesystem::file_time_type::clock::now();
+  for (std::size_t i = 0; i < 3; i++) {
+    auto key = std::to_string(i);
+    cache.store(key, makeEntry("code"));
+    std::filesystem::last_write_time(dir / (key + ".json"),
+                                     now - std::chrono::hours(3 - i));
+  }
+  // The lookup marks entry 0 as the most recently used one.
+  EXPECT_TRUE(cache.lookup("0").has_value());
+  cache.store("3", makeEntry("code"));
+
+  EXPECT_TRUE(cache.lookup("0").has_value());
+  EXPECT_FALSE(cache.lookup("1").has_value());
+  EXPECT_TRUE(cache.lookup("2").has_value());
+  EXPECT_TRUE(cache.lookup("3").has_value());
+  std::filesystem::remove_all(dir);
+}
+
+CUDAQ_TEST(CompilationCacheTester, checkMalformedEntriesMiss) {
+  auto dir = std::filesystem::temp_directory_path() / "cudaq_cache_malformed";
+  std::filesystem::remove_all(dir);
+  CompilationCache cache(dir, 1024 * 1024);
+  auto write = [&](const std::string &key, const std::string &contents) {
+    std::ofstream out(dir / (key + ".json"));
+    out << contents;
+  };
+
+  write("truncated", R"({"version": 1, "codes": [)");
+  write("old", R"({"version": 0, "codes": [], "modules": []})");
+  write("missing", R"({"version": 1, "codes": []})");
+  write("mistyped", R"({"version": 1, "codes": [{"name": 1, "code": "c",
+      "output_names": {}, "mapping_reorder_idx": []}], "modules": []})");
+  write("version", R"({"version": "1", "codes": [], "modules": []})");
+  for (auto *key : {"truncated", "old", "missing", "mistyped", "version"})
+    EXPECT_FALSE(cache.lookup(key).has_value()) << key;
+  EXPECT_EQ(cache.getMisses(), 5);
+  EXPECT_EQ(cache.getHits(), 0);
+
+  // The entry is overwritten by the next store.
+  cache.store("mistyped", makeEntry("code"));
+  EXPECT_TRUE(cache.lookup("mistyped").has_value());
+  std::filesystem::remove_all(dir);
+}
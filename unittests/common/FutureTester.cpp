@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CUDAQTestUtils.h"
+#include "common/Future.h"
+
+using namespace cudaq;
+
+CUDAQ_TEST(FutureTester, checkIsGroupedTermsName) {
+  EXPECT_TRUE(details::isGroupedTermsName("ZZI,IZZ"));
+  EXPECT_FALSE(details::isGroupedTermsName("ZZI"));
+  EXPECT_FALSE(details::isGroupedTermsName("kernel"));
+}
+
+CUDAQ_TEST(FutureTester, checkSplitOverlappingTerms) {
+  // Both terms measure qubit 1, the circuit measures qubits 0, 1 and 2.
+  ExecutionResult r{CountsDictionary{{"000", 30}, {"011", 20}, {"111", 50}}};
+  sample_result counts(r);
+  auto results = details::splitGroupedTermResults("ZZI,IZZ", counts);
+  ASSERT_EQ(2, results.size());
+
+  EXPECT_EQ("ZZI", results[0].registerName);
+  EXPECT_EQ(3, results[0].counts.size());
+  EXPECT_EQ(30, results[0].counts["00"]);
+  EXPECT_EQ(20, results[0].counts["01"]);
+  EXPECT_EQ(50, results[0].counts["11"]);
+
+  EXPECT_EQ("IZZ", results[1].registerName);
+  EXPECT_EQ(2, results[1].counts.size());
+  EXPECT_EQ(30, results[1].counts["00"]);
+  EXPECT_EQ(70, results[1].counts["11"]);
+}
+
+CUDAQ_TEST(FutureTester, checkSplitDisjointTerms) {
+  // The terms measure qubits 0 and 2, which are the two bits of the results.
+  ExecutionResult r{CountsDictionary{{"01", 25}, {"10", 75}}};
+  r.sequentialData = SequentialData({"01", "10", "10"});
+  sample_result counts(r);
+  auto results = details::splitGroupedTermResults("ZIII,IIXI", counts);
+  ASSERT_EQ(2, results.size());
+
+  EXPECT_EQ("ZIII", results[0].registerName);
+  EXPECT_EQ(25, results[0].counts["0"]);
+  EXPECT_EQ(75, results[0].counts["1"]);
+  EXPECT_EQ((std::vector<std::string>{"0", "1", "1"}),
+            results[0].sequentialData.str());
+
+  EXPECT_EQ("IIXI", results[1].registerName);
+  EXPECT_EQ(75, results[1].counts["0"]);
+  EXPECT_EQ(25, results[1].counts["1"]);
+  EXPECT_EQ((std::vector<std::string>{"1", "0", "0"}),
+            results[1].sequentialData.str());
+
+  // The expectation value of each term follows from its own counts.
+  sample_result zResult(results[0]);
+  EXPECT_NEAR(-0.5, zResult.expectation("ZIII"), 1e-12);
+}
+
+CUDAQ_TEST(FutureTester, checkSplitRejectsMismatchedResults) {
+  ExecutionResult r{CountsDictionary{{"0", 100}}};
+  sample_result counts(r);
+  EXPECT_THROW(details::splitGroupedTermResults("ZZ,IZ", counts),
+               std::runtime_error);
+  EXPECT_THROW(details::splitGroupedTermResults("Z,ZZ", counts),
+               std::runtime_error);
+}
@@ -0,0 +1,117 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "common/JIT.h"
+#include "common/JITCache.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <atomic>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace cudaq;
+
+TEST(JITCacheTester, checkLRUEviction) {
+  LRUCache<std::string, int> cache(2);
+  cache.insert("a", 1);
+  cache.insert("b", 2);
+  // Using a makes b the least recently used entry.
+  EXPECT_EQ(cache.lookup("a"), 1);
+  cache.insert("c", 3);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.lookup("a"), 1);
+  EXPECT_FALSE(cache.lookup("b").has_value());
+  EXPECT_EQ(cache.lookup("c"), 3);
+
+  // An entry that is already cached is kept.
+  EXPECT_EQ(cache.insert("c", 4), 3);
+  EXPECT_EQ(cache.lookup("c"), 3);
+}
+
+TEST(JITCacheTester, checkDisabled) {
+  LRUCache<std::string, int> cache(0);
+  EXPECT_EQ(cache.insert("a", 1), 1);
+  EXPECT_FALSE(cache.lookup("a").has_value());
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(JITCacheTester, checkConcurrentLookup) {
+  // The threads use more kernels than the cache holds, so that lookups,
+  // insertions and evictions interleave.
+  constexpr int numThreads = 8;
+  constexpr int numKernels = 16;
+  LRUCache<int, std::shared_ptr<int>> cache(numKernels / 2);
+  std::atomic<int> mismatches = 0;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < numThreads; t++)
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < 1000; i++) {
+        const int key = (t + i) % numKernels;
+        auto value = cache.lookup(key);
+        auto kernel =
+            value ? *value : cache.insert(key, std::make_shared<int>(key));
+        if (!kernel || *kernel != key)
+          mismatches++;
+      }
+    });
+  for (auto &thread : threads)
+    thread.join();
+  EXPECT_EQ(mismatches, 0);
+  EXPECT_EQ(cache.size(), numKernels / 2);
+
+  // Threads compiling the same kernel concurrently all get the cached one.
+  std::vector<std::shared_ptr<int>> kernels(numThreads);
+  threads.clear();
+  for (int t = 0; t < numThreads; t++)
+    threads.emplace_back([&, t]() {
+      kernels[t] = cache.insert(numKernels, std::make_shared<int>(t));
+    });
+  for (auto &thread : threads)
+    thread.join();
+  for (auto &kernel : kernels)
+    EXPECT_EQ(kernel, kernels.front());
+}
+
+TEST(JITCacheTester, checkCacheSizeFromEnvironment) {
+  unsetenv("CUDAQ_JIT_CACHE_SIZE");
+  EXPECT_EQ(getJITCacheSize(), defaultJITCacheSize);
+  setenv("CUDAQ_JIT_CACHE_SIZE", "5", true);
+  EXPECT_EQ(getJITCacheSize(), 5);
+  unsetenv("CUDAQ_JIT_CACHE_SIZE");
+}
+
+TEST(JITCacheTester, checkObjectCacheFromEnvironment) {
+  unsetenv("CUDAQ_JIT_OBJECT_CACHE_DIR");
+  EXPECT_FALSE(PersistentObjectCache::createFromEnvironment());
+
+  auto dir = std::filesystem::temp_directory_path() / "cudaq_jit_objects";
+  std::filesystem::remove_all(dir);
+  setenv("CUDAQ_JIT_OBJECT_CACHE_DIR", dir.c_str(), true);
+  llvm::LLVMContext context;
+  llvm::Module module("kernel_hash", context);
+  llvm::Module other("other_hash", context);
+  {
+    auto cache = PersistentObjectCache::createFromEnvironment();
+    ASSERT_TRUE(cache);
+    EXPECT_FALSE(cache->getObject(&module));
+    cache->notifyObjectCompiled(
+        &module, llvm::MemoryBufferRef("object code", "kernel_hash"));
+  }
+  EXPECT_TRUE(std::filesystem::exists(dir / "kernel_hash.o"));
+
+  // Another process, e.g. a restarted server, loads the compiled object.
+  auto cache = PersistentObjectCache::createFromEnvironment();
+  auto object = cache->getObject(&module);
+  ASSERT_TRUE(object);
+  EXPECT_EQ(object->getBuffer(), "object code");
+  EXPECT_FALSE(cache->getObject(&other));
+  unsetenv("CUDAQ_JIT_OBJECT_CACHE_DIR");
+  std::filesystem::remove_all(dir);
+}
@@ -8,6 +8,9 @@
 
 #include "CUDAQTestUtils.h"
 #include "common/MeasureCounts.h"
+#include <algorithm>
+#include <numeric>
+#include <sstream>
 
 using namespace cudaq;
 
@@ -64,3 +67,121 @@ CUDAQ_TEST(MeasureCountsTester, checkMeasureCountsSerialize) {
 
   EXPECT_TRUE(mm == mc);
 }
+
+CUDAQ_TEST(MeasureCountsTester, checkSequentialData) {
+  // Wider than a word, to exercise the multi-word packing.
+  std::string wide(70, '0');
+  wide[0] = wide[64] = wide[69] = '1';
+  ExecutionResult r;
+  r.appendResult("0" + wide.substr(1), 2);
+  r.appendResult(wide, 1);
+  std::vector<std::string> expected = {"0" + wide.substr(1),
+                                       "0" + wide.substr(1), wide};
+  EXPECT_EQ(expected, r.getSequentialData());
+  EXPECT_EQ(wide, r.sequentialData[2]);
+
+  std::vector<std::size_t> index(70);
+  std::iota(index.rbegin(), index.rend(), 0);
+  cudaq::sample_result mc(r);
+  mc.reorder(index);
+  auto reversed = wide;
+  std::reverse(reversed.begin(), reversed.end());
+  EXPECT_EQ(reversed, mc.sequential_data()[2]);
+
+  // Bit strings of different lengths or of qudit levels are kept as is.
+  SequentialData data(std::vector<std::string>{"01", "10"});
+  data.append("2", 2);
+  data.append(SequentialData(std::vector<std::string>{"110"}));
+  std::vector<std::string> mixed = {"01", "10", "2", "2", "110"};
+  EXPECT_EQ(mixed, data.str());
+  EXPECT_EQ(5, data.size());
+}
+
+CUDAQ_TEST(MeasureCountsTester, checkPackedMarginalAndReorder) {
+  // Compare against gathering the bits of the strings, for registers of one
+  // and of several words.
+  for (std::size_t numBits : {5, 64, 70, 130}) {
+    CountsDictionary counts;
+    ExecutionResult r;
+    for (std::size_t k = 0; k < 20; k++) {
+      std::string bits(numBits, '0');
+      for (std::size_t i = 0; i < numBits; i++)
+        bits[i] = ((i * 7 + k * 13) % 5 < 2) ? '1' : '0';
+      r.appendResult(bits, k + 1);
+    }
+    auto gather = [](const std::string &bits,
+                     const std::vector<std::size_t> &index) {
+      std::string result;
+      for (auto i : index)
+        result += bits[i];
+      return result;
+    };
+
+    std::vector<std::size_t> marginal = {numBits - 1, 0, 3, numBits / 2};
+    auto sorted = marginal;
+    std::sort(sorted.begin(), sorted.end());
+    CountsDictionary expected;
+    for (auto &[bits, count] : r.counts)
+      expected[gather(bits, sorted)] += count;
+    cudaq::sample_result mc(r);
+    auto result = mc.get_marginal(marginal);
+    EXPECT_EQ(expected, result.to_map());
+    auto shots = mc.sequential_data();
+    auto marginalShots = result.sequential_data();
+    ASSERT_EQ(shots.size(), marginalShots.size());
+    for (std::size_t i = 0; i < shots.size(); i++)
+      EXPECT_EQ(gather(shots[i], sorted), marginalShots[i]);
+
+    std::vector<std::size_t> index(numBits);
+    std::iota(index.begin(), index.end(), 0);
+    std::rotate(index.begin(), index.begin() + 3, index.end());
+    expected.clear();
+    for (auto &[bits, count] : r.counts)
+      expected[gather(bits, index)] += count;
+    mc.reorder(index);
+    EXPECT_EQ(expected, mc.to_map());
+    EXPECT_EQ(gather(shots[0], index), mc.sequential_data()[0]);
+  }
+}
+
+CUDAQ_TEST(MeasureCountsTester, checkBinarySerialize) {
+  // A register wider than 64 bits, with per-shot data and an expectation.
+  std::string wide(100, '0');
+  wide[0] = wide[63] = wide[64] = wide[99] = '1';
+  ExecutionResult r("c0");
+  r.appendResult(wide, 3);
+  r.appendResult(std::string(100, '1'), 5);
+  r.expectationValue = -0.25;
+  ExecutionResult global{CountsDictionary{{"0", 400}, {"1", 600}}};
+  ExecutionResult qudits{CountsDictionary{{"02", 7}, {"1", 1}}, "qudits"};
+
+  cudaq::sample_result mc(global);
+  mc.append(r);
+  mc.append(qudits);
+  std::stringstream stream;
+  mc.serialize(stream);
+  cudaq::sample_result mm;
+  mm.deserialize(stream);
+  EXPECT_TRUE(mm == mc);
+  EXPECT_EQ(r.getSequentialData(), mm.sequential_data("c0"));
+  EXPECT_NEAR(-0.25, mm.expectation("c0"), 1e-12);
+  EXPECT_EQ(mc.to_map("qudits"), mm.to_map("qudits"));
+  EXPECT_NEAR(0.4, mm.probability("0"), 1e-9);
+
+  // The per-shot data is optional.
+  std::stringstream counts;
+  r.serialize(counts, /*withSequentialData=*/false);
+  EXPECT_LT(counts.str().size(), stream.str().size());
+  ExecutionResult rr;
+  rr.deserialize(counts);
+  EXPECT_TRUE(rr == r);
+  EXPECT_TRUE(rr.sequentialData.empty());
+
+  // Truncated data and unknown versions are rejected.
+  auto truncated = stream.str().substr(0, stream.str().size() / 2);
+  std::stringstream truncatedStream(truncated);
+  cudaq::sample_result bad;
+  EXPECT_ANY_THROW(bad.deserialize(truncatedStream));
+  std::stringstream version(std::string("\x02\x00", 2));
+  EXPECT_ANY_THROW(rr.deserialize(version));
+}
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CUDAQTestUtils.h"
+#include "cudaq/platform/QuantumExecutionQueue.h"
+#include <optional>
+#include <set>
+
+using namespace cudaq;
+
+CUDAQ_TEST(QuantumExecutionQueueTester, checkWorkStealing) {
+  constexpr std::size_t numQueues = 4;
+  constexpr std::size_t numTasks = 32;
+  std::vector<std::unique_ptr<QuantumExecutionQueue>> queues;
+  std::vector<QuantumExecutionQueue *> group;
+  for (std::size_t i = 0; i < numQueues; i++) {
+    queues.emplace_back(std::make_unique<QuantumExecutionQueue>());
+    queues.back()->setQpuId(i);
+    group.push_back(queues.back().get());
+  }
+  QuantumExecutionQueue::formStealingGroup(group);
+
+  // Submit everything to the first queue, the others have to steal.
+  std::mutex m;
+  std::set<std::size_t> executors;
+  std::vector<std::promise<void>> promises(numTasks);
+  for (std::size_t i = 0; i < numTasks; i++) {
+    StealableQuantumTask task = [&, i](std::size_t qpuId) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      {
+        std::lock_guard<std::mutex> l(m);
+        executors.insert(qpuId);
+      }
+      promises[i].set_value();
+    };
+    queues[0]->enqueueStealable(task);
+  }
+  for (auto &p : promises)
+    p.get_future().wait();
+
+  EXPECT_GT(executors.size(), 1);
+  // Queue 0 never steals, everything others ran was stolen.
+  EXPECT_EQ(0, queues[0]->getStatistics().stolen);
+  for (std::size_t i = 1; i < numQueues; i++) {
+    auto stats = queues[i]->getStatistics();
+    EXPECT_EQ(stats.executed, stats.stolen);
+  }
+}
+
+CUDAQ_TEST(QuantumExecutionQueueTester, checkStatistics) {
+  QuantumExecutionQueue queue;
+  queue.setQpuId(3);
+
+  // Block the queue so that subsequent tasks are counted in its depth.
+  std::promise<void> started, release;
+  auto released = release.get_future().share();
+  QuantumTask blocker = [&started, released]() {
+    started.set_value();
+    released.wait();
+  };
+  queue.enqueue(blocker);
+  started.get_future().wait();
+
+  std::promise<std::size_t> idPromise;
+  auto id = idPromise.get_future();
+  StealableQuantumTask task = [&](std::size_t qpuId) {
+    idPromise.set_value(qpuId);
+  };
+  queue.enqueueStealable(task);
+  EXPECT_EQ(1, queue.depth());
+
+  release.set_value();
+  EXPECT_EQ(3, id.get());
+
+  // Statistics are recorded once the task returns.
+  while (queue.getStatistics().executed < 2)
+    std::this_thread::yield();
+  auto stats = queue.getStatistics();
+  EXPECT_EQ(0, stats.depth);
+  EXPECT_EQ(0, stats.stolen);
+  EXPECT_GE(stats.totalWaitTime.count(), stats.maxWaitTime.count());
+  EXPECT_GT(stats.maxWaitTime.count(), 0);
+}
+
+CUDAQ_TEST(QuantumExecutionQueueTester, checkStolenTasksAreSetUp) {
+  constexpr std::size_t numTasks = 16;
+  QuantumExecutionQueue first, second;
+  first.setQpuId(0);
+  second.setQpuId(1);
+  EXPECT_NE(first.getId(), second.getId());
+
+  // Record the QPU each thread was last set up for.
+  thread_local std::optional<std::size_t> preparedQpu;
+  first.setStealableTaskSetup([]() { preparedQpu = 0; });
+  second.setStealableTaskSetup([]() { preparedQpu = 1; });
+  QuantumExecutionQueue::formStealingGroup({&first, &second});
+
+  std::atomic<std::size_t> mismatches = 0;
+  std::vector<std::promise<void>> promises(numTasks);
+  for (std::size_t i = 0; i < numTasks; i++) {
+    StealableQuantumTask task = [&, i](std::size_t qpuId) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      if (preparedQpu != qpuId)
+        mismatches++;
+      promises[i].set_value();
+    };
+    first.enqueueStealable(task);
+  }
+  for (auto &p : promises)
+    p.get_future().wait();
+
+  EXPECT_GT(second.getStatistics().stolen, 0);
+  EXPECT_EQ(0, mismatches);
+}
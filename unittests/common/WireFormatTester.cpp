@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "common/WireFormat.h"
+#include <gtest/gtest.h>
+
+using namespace cudaq;
+
+static nlohmann::json makeMessage(std::size_t numShots) {
+  nlohmann::json message;
+  message["name"] = "sample";
+  message["code"] = nlohmann::json::binary_t({0x42, 0x43, 0x00, 0xde});
+  message["shots"] = std::vector<std::string>(numShots, "0110");
+  return message;
+}
+
+/// Overwrite the uncompressed size in the header of the message.
+static void setPayloadSize(std::string &data, std::uint64_t size) {
+  for (std::size_t i = 0; i < 8; ++i)
+    data[8 + i] = static_cast<char>((size >> (8 * i)) & 0xff);
+}
+
+TEST(WireFormatTester, checkRoundTrip) {
+  auto message = makeMessage(1);
+  auto data = wire::encode(message);
+  EXPECT_TRUE(wire::isBinaryMessage(data));
+  // Small messages are not compressed.
+  EXPECT_EQ(data[5], 0);
+  auto decoded = wire::decode(data);
+  EXPECT_EQ(decoded, message);
+  EXPECT_TRUE(decoded["code"].is_binary());
+}
+
+TEST(WireFormatTester, checkCompressedRoundTrip) {
+  auto message = makeMessage(10000);
+  auto data = wire::encode(message);
+  EXPECT_EQ(data[5], 1);
+  EXPECT_LT(data.size(), nlohmann::json::to_msgpack(message).size());
+  EXPECT_EQ(wire::decode(data), message);
+
+  // Compression can be disabled by the threshold.
+  auto uncompressed = wire::encode(message, data.size() * 1000);
+  EXPECT_EQ(uncompressed[5], 0);
+  EXPECT_EQ(wire::decode(uncompressed), message);
+}
+
+TEST(WireFormatTester, checkTruncatedMessage) {
+  for (std::size_t numShots : {1, 10000}) {
+    auto data = wire::encode(makeMessage(numShots));
+    EXPECT_THROW(wire::decode(data.substr(0, data.size() - 1)),
+                 std::runtime_error);
+    EXPECT_THROW(wire::decode(data.substr(0, 16)), std::runtime_error);
+    // Shorter than the header.
+    EXPECT_FALSE(wire::isBinaryMessage(data.substr(0, 8)));
+    EXPECT_THROW(wire::decode(data.substr(0, 8)), std::runtime_error);
+  }
+}
+
+TEST(WireFormatTester, checkBadHeader) {
+  auto data = wire::encode(makeMessage(1));
+  auto badMagic = data;
+  badMagic[0] = 'X';
+  EXPECT_FALSE(wire::isBinaryMessage(badMagic));
+  EXPECT_THROW(wire::decode(badMagic), std::runtime_error);
+  EXPECT_FALSE(wire::isBinaryMessage(R"({"name": "sample"})"));
+
+  auto badVersion = data;
+  badVersion[4] = static_cast<char>(wire::FORMAT_VERSION + 1);
+  EXPECT_THROW(wire::decode(badVersion), std::runtime_error);
+}
+
+TEST(WireFormatTester, checkOversizedPayload) {
+  // The decoder must not trust the size in the header of compressed messages.
+  auto data = wire::encode(makeMessage(10000));
+  ASSERT_EQ(data[5], 1);
+  auto huge = data;
+  setPayloadSize(huge, std::uint64_t{1} << 60);
+  EXPECT_THROW(wire::decode(huge), std::runtime_error);
+
+  // Larger than zlib can possibly produce from the compressed payload.
+  auto inflated = data;
+  setPayloadSize(inflated, (data.size() - 16) * 2000);
+  EXPECT_THROW(wire::decode(inflated), std::runtime_error);
+
+  // Larger than the actual payload, but within bounds.
+  auto wrong = data;
+  auto payloadSize = nlohmann::json::to_msgpack(makeMessage(10000)).size();
+  setPayloadSize(wrong, payloadSize + 1);
+  EXPECT_THROW(wire::decode(wrong), std::runtime_error);
+}
+
+TEST(WireFormatTester, checkContentNegotiation) {
+  EXPECT_TRUE(wire::acceptsBinary(wire::CONTENT_TYPE));
+  EXPECT_TRUE(
+      wire::acceptsBinary("application/vnd.cudaq.binary, application/json"));
+  EXPECT_TRUE(
+      wire::acceptsBinary("application/json, Application/VND.cudaq.Binary"));
+  EXPECT_TRUE(wire::acceptsBinary("application/vnd.cudaq.binary;q=0.5"));
+  EXPECT_FALSE(wire::acceptsBinary(""));
+  EXPECT_FALSE(wire::acceptsBinary("application/json"));
+  EXPECT_FALSE(wire::acceptsBinary("*/*"));
+  EXPECT_FALSE(wire::acceptsBinary("application/vnd.cudaq.binary-v2"));
+  EXPECT_FALSE(wire::acceptsBinary("application/vnd.cudaq.binary; q=0"));
+
+  EXPECT_TRUE(wire::isBinaryContentType(wire::CONTENT_TYPE));
+  EXPECT_TRUE(
+      wire::isBinaryContentType("application/vnd.cudaq.binary; charset=none"));
+  EXPECT_FALSE(wire::isBinaryContentType("application/json"));
+  EXPECT_FALSE(wire::isBinaryContentType(""));
+}
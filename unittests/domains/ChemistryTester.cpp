@@ -85,6 +85,48 @@ CUDAQ_TEST(H2MoleculeTester, checkHamiltonian) {
   }
 }
 
+CUDAQ_TEST(H2MoleculeTester, checkFermionMapping) {
+  // H2 / sto-3g at 0.7414 angstrom, spatial orbital integrals.
+  cudaq::one_body_integrals oneBody({2, 2});
+  cudaq::two_body_integals twoBody({2, 2, 2, 2});
+  for (std::size_t p = 0; p < 2; p++)
+    for (std::size_t q = 0; q < 2; q++) {
+      oneBody(p, q) = 0.0;
+      for (std::size_t r = 0; r < 2; r++)
+        for (std::size_t s = 0; s < 2; s++)
+          twoBody(p, q, r, s) = 0.0;
+    }
+  oneBody(0, 0) = -1.2524635735648981;
+  oneBody(1, 1) = -0.47594871522096355;
+  twoBody(0, 0, 0, 0) = 0.6744887663568382;
+  twoBody(1, 1, 1, 1) = 0.6973979494693358;
+  twoBody(0, 1, 1, 0) = twoBody(1, 0, 0, 1) = 0.6634706461597185;
+  twoBody(0, 0, 1, 1) = twoBody(0, 1, 0, 1) = twoBody(1, 0, 1, 0) =
+      twoBody(1, 1, 0, 0) = 0.18128880821149607;
+  double nuclearRepulsion = 0.7137539936876182;
+
+  auto jw = cudaq::get_qubit_hamiltonian(oneBody, twoBody, nuclearRepulsion);
+  EXPECT_EQ(4, jw.num_qubits());
+  EXPECT_EQ(15, jw.num_terms());
+  EXPECT_NEAR(-1.137, jw.to_matrix().minimal_eigenvalue().real(), 1e-3);
+
+  auto bk = cudaq::get_qubit_hamiltonian(oneBody, twoBody, nuclearRepulsion,
+                                         cudaq::fermion_mapping::bravyi_kitaev);
+  EXPECT_EQ(4, bk.num_qubits());
+  EXPECT_NEAR(-1.137, bk.to_matrix().minimal_eigenvalue().real(), 1e-3);
+
+  // Compare against the Jordan-Wigner Hamiltonian computed by OpenFermion.
+  cudaq::molecular_geometry geometry{{"H", {0., 0., 0.}},
+                                     {"H", {0., 0., .7414}}};
+  auto molecule = cudaq::create_molecule(geometry, "sto-3g", 1, 0);
+  auto mapped = cudaq::get_qubit_hamiltonian(molecule);
+  auto expected = molecule.hamiltonian.to_matrix();
+  auto actual = mapped.to_matrix();
+  for (std::size_t i = 0; i < expected.rows(); i++)
+    for (std::size_t j = 0; j < expected.cols(); j++)
+      EXPECT_NEAR(std::abs(expected(i, j) - actual(i, j)), 0.0, 1e-6);
+}
+
 CUDAQ_TEST(H2MoleculeTester, checkExpPauli) {
   auto kernel = [](double theta) __qpu__ {
     cudaq::qvector q(4);
@@ -176,6 +218,46 @@ CUDAQ_TEST(H2MoleculeTester, checkUCCSD) {
   }
 }
 
+CUDAQ_TEST(H2MoleculeTester, checkUCCSDFermionicExcitation) {
+  cudaq::molecular_geometry geometry{{"H", {0., 0., 0.}},
+                                     {"H", {0., 0., .7474}}};
+  auto molecule = cudaq::create_molecule(geometry, "6-31g", 1, 0);
+  std::size_t numQubits = 2 * molecule.n_orbitals;
+  auto numParams =
+      cudaq::uccsd_num_parameters(molecule.n_electrons, numQubits);
+
+  auto [ladder, ladderThetas] = cudaq::make_kernel<std::vector<double>>();
+  auto ladderQubits = ladder.qalloc(numQubits);
+  ladder.x(ladderQubits[0]);
+  ladder.x(ladderQubits[1]);
+  cudaq::uccsd(ladder, ladderQubits, ladderThetas, molecule.n_electrons,
+               numQubits, cudaq::uccsd_circuit::pauli_ladder);
+
+  auto [compact, compactThetas] = cudaq::make_kernel<std::vector<double>>();
+  auto compactQubits = compact.qalloc(numQubits);
+  compact.x(compactQubits[0]);
+  compact.x(compactQubits[1]);
+  cudaq::uccsd(compact, compactQubits, compactThetas, molecule.n_electrons,
+               numQubits, cudaq::uccsd_circuit::fermionic_excitation);
+
+  // Both circuit constructions prepare the same state.
+  auto params = cudaq::random_vector(-1.0, 1.0, numParams,
+                                     std::mt19937::default_seed);
+  double expected = cudaq::observe(ladder, molecule.hamiltonian, params);
+  double actual = cudaq::observe(compact, molecule.hamiltonian, params);
+  EXPECT_NEAR(expected, actual, 1e-6);
+
+  auto ladderCounts = cudaq::get_uccsd_gate_counts(
+      molecule.n_electrons, numQubits, cudaq::uccsd_circuit::pauli_ladder);
+  auto compactCounts =
+      cudaq::get_uccsd_gate_counts(molecule.n_electrons, numQubits,
+                                   cudaq::uccsd_circuit::fermionic_excitation);
+  EXPECT_EQ(0, ladderCounts.controlled_rotations);
+  EXPECT_EQ(ladderCounts.cnots, ladderCounts.decomposed_cnots);
+  EXPECT_EQ(numParams, compactCounts.controlled_rotations);
+  EXPECT_LT(compactCounts.decomposed_cnots, ladderCounts.cnots);
+}
+
 CUDAQ_TEST(H2MoleculeTester, checkHWE) {
 
   cudaq::molecular_geometry geometry{{"H", {0., 0., 0.}},
@@ -12,6 +12,7 @@
 #include <cudaq/builder.h>
 #include <cudaq/optimizers.h>
 #include <regex>
+#include <thread>
 
 CUDAQ_TEST(BuilderTester, checkSimple) {
   {
@@ -1101,6 +1102,41 @@ CUDAQ_TEST(BuilderTester, checkExpPauli) {
   }
 }
 
+#ifndef CUDAQ_BACKEND_DM
+CUDAQ_TEST(BuilderTester, checkExpPauliMatchesDecomposition) {
+  // Simulators may apply exp_pauli natively, check against the gate
+  // decomposition of exp(i theta XYZ) on a state with no special symmetry.
+  const double theta = 0.41;
+  auto kernel = cudaq::make_kernel();
+  auto q = kernel.qalloc(3);
+  kernel.h(q[0]);
+  kernel.ry(0.3, q[1]);
+  kernel.rx(0.7, q[2]);
+  kernel.x<cudaq::ctrl>(q[0], q[2]);
+  kernel.exp_pauli(theta, q, "XYZ");
+
+  auto reference = cudaq::make_kernel();
+  auto r = reference.qalloc(3);
+  reference.h(r[0]);
+  reference.ry(0.3, r[1]);
+  reference.rx(0.7, r[2]);
+  reference.x<cudaq::ctrl>(r[0], r[2]);
+  reference.h(r[0]);
+  reference.rx(M_PI_2, r[1]);
+  reference.x<cudaq::ctrl>(r[0], r[1]);
+  reference.x<cudaq::ctrl>(r[1], r[2]);
+  reference.rz(-2.0 * theta, r[2]);
+  reference.x<cudaq::ctrl>(r[1], r[2]);
+  reference.x<cudaq::ctrl>(r[0], r[1]);
+  reference.rx(-M_PI_2, r[1]);
+  reference.h(r[0]);
+
+  auto state = cudaq::get_state(kernel);
+  auto expected = cudaq::get_state(reference);
+  EXPECT_NEAR(state.overlap(expected), 1.0, 1e-6);
+}
+#endif
+
 #ifndef CUDAQ_BACKEND_TENSORNET_MPS
 // MPS doesn't support gates on more than 2 qubits
 CUDAQ_TEST(BuilderTester, checkControlledRotations) {
@@ -1277,4 +1313,57 @@ CUDAQ_TEST(BuilderTester, checkQuakeValueOperators) {
   EXPECT_NEAR(state.overlap(state3), 1.0, 1e-3);
 }
 
+CUDAQ_TEST(BuilderTester, checkJitTierPromotion) {
+  // Compile the optimized engine as soon as the kernel is launched again.
+  setenv("CUDAQ_BUILDER_JIT_TIER_THRESHOLD", "1", true);
+  auto [kernel, theta] = cudaq::make_kernel<double>();
+  auto q = kernel.qalloc(2);
+  kernel.rx(theta, q[0]);
+  kernel.x<cudaq::ctrl>(q[0], q[1]);
+  cudaq::spin_op h = cudaq::spin::z(0) + 0.5 * cudaq::spin::z(1);
+
+  // The optimized engine is compiled in the background and swapped in once
+  // it is ready, so launch the kernel until well after that. The results of
+  // the unoptimized engine, i.e. of the first launch, are the reference.
+  const auto checkLaunches = [&](double factor) {
+    const std::vector<double> angles = {0.3, 1.2};
+    std::vector<double> reference;
+    for (auto angle : angles)
+      reference.push_back(cudaq::observe(kernel, h, angle).expectation());
+    for (std::size_t i = 0; i < 50; i++) {
+      const auto angle = angles[i % 2];
+      const auto energy = cudaq::observe(kernel, h, angle).expectation();
+      EXPECT_NEAR(reference[i % 2], energy, 1e-12);
+      EXPECT_NEAR(factor * std::cos(angle), energy, 1e-6);
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  };
+  checkLaunches(1.5);
+
+  // Modifying the kernel starts over with an unoptimized engine.
+  kernel.x(q[1]);
+  checkLaunches(0.5);
+  unsetenv("CUDAQ_BUILDER_JIT_TIER_THRESHOLD");
+}
+
 #endif
+
+CUDAQ_TEST(BuilderTester, checkFusedSingleQubitGates) {
+  // Each run of single-qubit gates on q[0] is fused into one u3. The
+  // controlled gate, whose control is in |0>, separates the runs. The second
+  // run is `x * (s * h)^-1`, hence the kernel flips q[0]. Applying the
+  // transpose of either u3 instead would leave q[0] in |0>.
+  auto kernel = cudaq::make_kernel();
+  auto q = kernel.qalloc(2);
+  kernel.h(q[0]);
+  kernel.s(q[0]);
+  kernel.x<cudaq::ctrl>(q[1], q[0]);
+  kernel.s<cudaq::adj>(q[0]);
+  kernel.h(q[0]);
+  kernel.x(q[0]);
+  kernel.mz(q);
+  auto counts = cudaq::sample(kernel);
+  counts.dump();
+  EXPECT_EQ(counts.size(), 1);
+  EXPECT_EQ(counts.count("10"), 1000);
+}
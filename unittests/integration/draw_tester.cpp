@@ -7,7 +7,9 @@
  ******************************************************************************/
 
 #include "CUDAQTestUtils.h"
+#include <cudaq/algorithm.h>
 #include <cudaq/algorithms/draw.h>
+#include <cudaq/builder.h>
 
 CUDAQ_TEST(DrawTester, checkEmpty) {
 
@@ -92,3 +94,27 @@ q3 : ┤ h ├──────────────────────
   EXPECT_EQ(expected_str.size(), produced_str.size());
   EXPECT_EQ(expected_str, produced_str);
 }
+
+CUDAQ_TEST(DrawTester, checkBuilderGatesAreNotFused) {
+  auto kernel = cudaq::make_kernel();
+  auto q = kernel.qalloc();
+  kernel.h(q);
+  kernel.s(q);
+  kernel.h(q);
+
+  // Executing the kernel first may cache a lowering with the single-qubit
+  // gates fused; the trace must still show the gates as written.
+  cudaq::sample(kernel);
+
+  // clang-format off
+  std::string expected_str = R"(
+     ╭───╮╭───╮╭───╮
+q0 : ┤ h ├┤ s ├┤ h ├
+     ╰───╯╰───╯╰───╯
+)";
+  // clang-format on
+
+  expected_str = expected_str.substr(1);
+  std::string produced_str = cudaq::draw(kernel);
+  EXPECT_EQ(expected_str, produced_str);
+}
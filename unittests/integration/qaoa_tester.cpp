@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2024 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CUDAQTestUtils.h"
+#include <cudaq/algorithm.h>
+
+namespace {
+// MaxCut on a 5-vertex ring with one chord.
+const std::vector<std::pair<std::size_t, std::size_t>> edges{
+    {0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 0}, {0, 2}};
+
+cudaq::spin_op maxCutHamiltonian() {
+  cudaq::spin_op h = 0.0 * cudaq::spin::i(0);
+  for (auto [u, v] : edges)
+    h += 0.5 * cudaq::spin::z(u) * cudaq::spin::z(v) - 0.5;
+  return h;
+}
+} // namespace
+
+struct qaoaDiagonal {
+  void operator()(std::vector<double> gammas, std::vector<double> betas,
+                  cudaq::spin_op hamiltonian) __qpu__ {
+    cudaq::qvector q(5);
+    h(q);
+    for (std::size_t layer = 0; layer < gammas.size(); layer++) {
+      cudaq::evolve_diagonal(gammas[layer], q, hamiltonian);
+      for (auto &qubit : q)
+        rx(2.0 * betas[layer], qubit);
+    }
+  }
+};
+
+struct qaoaGates {
+  void operator()(std::vector<double> gammas,
+                  std::vector<double> betas) __qpu__ {
+    cudaq::qvector q(5);
+    h(q);
+    for (std::size_t layer = 0; layer < gammas.size(); layer++) {
+      // exp(-i gamma 0.5 ZZ) per edge, the constant is a global phase.
+      for (auto [u, v] : edges) {
+        x<cudaq::ctrl>(q[u], q[v]);
+        rz(gammas[layer], q[v]);
+        x<cudaq::ctrl>(q[u], q[v]);
+      }
+      for (auto &qubit : q)
+        rx(2.0 * betas[layer], qubit);
+    }
+  }
+};
+
+CUDAQ_TEST(QAOATester, checkDiagonalEvolution) {
+  auto h = maxCutHamiltonian();
+  EXPECT_TRUE(h.is_diagonal());
+
+  std::vector<double> gammas{0.3, 0.7}, betas{0.6, 0.2};
+  double diagonal = cudaq::observe(qaoaDiagonal{}, h, gammas, betas, h);
+  double gates = cudaq::observe(qaoaGates{}, h, gammas, betas);
+  EXPECT_NEAR(diagonal, gates, 1e-6);
+
+  // Repeat to exercise the cached diagonal.
+  gammas = {0.5, 0.1};
+  diagonal = cudaq::observe(qaoaDiagonal{}, h, gammas, betas, h);
+  gates = cudaq::observe(qaoaGates{}, h, gammas, betas);
+  EXPECT_NEAR(diagonal, gates, 1e-6);
+}
+
+CUDAQ_TEST(QAOATester, checkDiagonalObserve) {
+  // A Z-only Hamiltonian with a term that does not act on every qubit.
+  auto h = maxCutHamiltonian() + 0.75 * cudaq::spin::z(3);
+  EXPECT_TRUE(h.is_diagonal());
+  std::vector<double> gammas{0.3, 0.7}, betas{0.6, 0.2};
+
+  // Without shots, the expectation value is computed term by term from the
+  // state vector by default. With sampling disabled, the simulator computes
+  // the whole expectation value itself, which takes the diagonal fast path on
+  // the state-vector simulator.
+  double perTerm = cudaq::observe(qaoaGates{}, h, gammas, betas);
+  setenv("CUDAQ_OBSERVE_FROM_SAMPLING", "0", true);
+  double direct = cudaq::observe(qaoaGates{}, h, gammas, betas);
+  unsetenv("CUDAQ_OBSERVE_FROM_SAMPLING");
+  EXPECT_NEAR(perTerm, direct, 1e-6);
+}
@@ -242,4 +242,61 @@ TEST(SpinOpTester, checkDistributeTerms) {
   EXPECT_EQ(distributed.size(), 2);
   EXPECT_EQ(distributed[0].num_terms(), 2);
   EXPECT_EQ(distributed[1].num_terms(), 3);
-}
\ No newline at end of file
+}
+
+TEST(SpinOpTester, checkDistributeTermsCostBalanced) {
+  auto H = 5.907 - 2.1433 * x(0) * x(1) * x(2) * x(3) -
+           2.1433 * y(0) * y(1) * y(2) * y(3) + .21829 * z(0) - 6.125 * z(1) +
+           .5 * z(0) * z(1) + .25 * x(2) * x(3);
+
+  auto distributed =
+      H.distribute_terms(2, cudaq::term_distribution::cost_balanced);
+  EXPECT_EQ(distributed.size(), 2);
+  EXPECT_EQ(distributed[0].num_terms() + distributed[1].num_terms(),
+            H.num_terms());
+
+  auto contains = [](const cudaq::spin_op &chunk, const std::string &word) {
+    bool found = false;
+    chunk.for_each_term(
+        [&](cudaq::spin_op &term) { found |= term.to_string(false) == word; });
+    return found;
+  };
+
+  // The two weight-4 terms are the most expensive and cannot share a
+  // measurement basis, so they are placed in different chunks.
+  EXPECT_NE(contains(distributed[0], "XXXX"), contains(distributed[1], "XXXX"));
+  EXPECT_NE(contains(distributed[0], "XXXX"), contains(distributed[0], "YYYY"));
+
+  // Terms sharing a measurement basis stay together.
+  for (auto &chunk : distributed)
+    if (contains(chunk, "ZZII"))
+      EXPECT_TRUE(contains(chunk, "ZIII") && contains(chunk, "IZII"));
+
+  // The distribution is deterministic.
+  auto again = H.distribute_terms(2, cudaq::term_distribution::cost_balanced);
+  for (std::size_t i = 0; i < distributed.size(); i++)
+    EXPECT_EQ(again[i].to_string(), distributed[i].to_string());
+
+  // More chunks than terms leaves some chunks empty.
+  auto many = H.distribute_terms(10, cudaq::term_distribution::cost_balanced);
+  EXPECT_EQ(many.size(), 10);
+  std::size_t total = 0;
+  for (auto &chunk : many)
+    total += chunk.num_terms();
+  EXPECT_EQ(total, H.num_terms());
+}
+
+TEST(SpinOpTester, checkToDiagonal) {
+  using namespace cudaq::spin;
+  cudaq::spin_op h = 1.5 - 0.5 * z(0) * z(2) + 2.0 * z(1) + 0.25 * z(0);
+  EXPECT_TRUE(h.is_diagonal());
+  EXPECT_FALSE((h + x(1)).is_diagonal());
+
+  auto diagonal = h.to_diagonal();
+  auto matrix = h.to_matrix();
+  ASSERT_EQ(diagonal.size(), matrix.rows());
+  for (std::size_t i = 0; i < diagonal.size(); i++)
+    EXPECT_NEAR(diagonal[i], matrix(i, i).real(), 1e-12);
+
+  EXPECT_ANY_THROW((h + y(0)).to_diagonal());
+}